@@ -0,0 +1,79 @@
+/* config.h.  Generated from config.h.in by configure.  */
+/* config.h.in.  Generated from configure.ac by autoheader.  */
+
+/* define to enable the hot-path instrumentation */
+/* #undef H2OXX_INSTRUMENTATION */
+
+/* define to evaluate the region 1, 2 & 5 getters natively */
+/* #undef H2OXX_NATIVE_GETTERS */
+
+/* define to build the SIMD bulk evaluation kernels */
+#define H2OXX_SIMD 1
+
+/* Define to 1 if you have the <dlfcn.h> header file. */
+#define HAVE_DLFCN_H 1
+
+/* Define to 1 if you have the <inttypes.h> header file. */
+#define HAVE_INTTYPES_H 1
+
+/* Define to 1 if you have the `mmap' function. */
+#define HAVE_MMAP 1
+
+/* Define to 1 if you have the <stdint.h> header file. */
+#define HAVE_STDINT_H 1
+
+/* Define to 1 if you have the <stdio.h> header file. */
+#define HAVE_STDIO_H 1
+
+/* Define to 1 if you have the <stdlib.h> header file. */
+#define HAVE_STDLIB_H 1
+
+/* Define to 1 if you have the <strings.h> header file. */
+#define HAVE_STRINGS_H 1
+
+/* Define to 1 if you have the <string.h> header file. */
+#define HAVE_STRING_H 1
+
+/* Define to 1 if you have the <sys/stat.h> header file. */
+#define HAVE_SYS_STAT_H 1
+
+/* Define to 1 if you have the <sys/types.h> header file. */
+#define HAVE_SYS_TYPES_H 1
+
+/* Define to 1 if you have the <unistd.h> header file. */
+#define HAVE_UNISTD_H 1
+
+/* Define to the sub-directory where libtool stores uninstalled libraries. */
+#define LT_OBJDIR ".libs/"
+
+/* define to disable assertions */
+#define NDEBUG 1
+
+/* Name of package */
+#define PACKAGE "libh2oxx"
+
+/* Define to the address where bug reports for this package should be sent. */
+#define PACKAGE_BUGREPORT "https://bitbucket.org/mgorny/libh2oxx/issues/"
+
+/* Define to the full name of this package. */
+#define PACKAGE_NAME "libh2o++"
+
+/* Define to the full name and version of this package. */
+#define PACKAGE_STRING "libh2o++ 0.2"
+
+/* Define to the one symbol short name of this package. */
+#define PACKAGE_TARNAME "libh2oxx"
+
+/* Define to the home page for this package. */
+#define PACKAGE_URL "https://bitbucket.org/mgorny/libh2oxx/"
+
+/* Define to the version of this package. */
+#define PACKAGE_VERSION "0.2"
+
+/* Define to 1 if all of the C90 standard headers exist (not just the ones
+   required in a freestanding environment). This macro is provided for
+   backward compatibility; new code need not use it. */
+#define STDC_HEADERS 1
+
+/* Version number of package */
+#define VERSION "0.2"
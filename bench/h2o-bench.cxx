@@ -0,0 +1,663 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o"
+#include "h2o_backward"
+#include "h2o_batch"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using h2o::H2O;
+using h2o::Region;
+
+typedef H2O (*constructor_func_t)(double, double);
+typedef double (H2O::*getter_func_t)() const;
+typedef int (*iterations_func_t)(double, double);
+
+static const double nan_value = std::numeric_limits<double>::quiet_NaN();
+
+// keeps the results alive
+static volatile double sink;
+
+struct Options
+{
+	double min_time;
+	bool csv;
+	unsigned int seed;
+	size_t count;
+	const char* filter;
+};
+
+/**
+ * A set of state points in a single region.
+ */
+struct Workload
+{
+	const char* region;
+	const char* kind;
+	std::vector<H2O> states;
+};
+
+/**
+ * The states a constructor can be benchmarked on.
+ */
+typedef enum
+{
+	ANY,
+	SINGLE_PHASE,
+	TWO_PHASE
+} scope_type;
+
+struct Constructor
+{
+	const char* name;
+	constructor_func_t func;
+	getter_func_t a, b;
+	scope_type scope;
+	iterations_func_t iterations;
+};
+
+struct Getter;
+
+typedef void (*getter_bench_func_t)(const Options&, const Getter&,
+		const Workload&);
+
+struct Getter
+{
+	const char* name;
+	getter_func_t func;
+	getter_bench_func_t bench;
+};
+
+static H2O backward_ph(double p, double h)
+{
+	return h2o::backward::ph(p, h, h2o::backward::EXACT);
+}
+
+static H2O backward_ps(double p, double s)
+{
+	return h2o::backward::ps(p, s, h2o::backward::EXACT);
+}
+
+static H2O backward_hs(double h, double s)
+{
+	return h2o::backward::hs(h, s, h2o::backward::EXACT);
+}
+
+static H2O backward_pT(double p, double T)
+{
+	return h2o::backward::pT(p, T, h2o::backward::EXACT);
+}
+
+// the number of Newton steps the EXACT mode takes
+static int ph_iterations(double p, double h)
+{
+	return h2o::backward::check_ph(p, h).iterations;
+}
+
+static int ps_iterations(double p, double s)
+{
+	return h2o::backward::check_ps(p, s).iterations;
+}
+
+static int hs_iterations(double h, double s)
+{
+	return h2o::backward::check_hs(h, s).iterations;
+}
+
+static int pT_iterations(double p, double T)
+{
+	return h2o::backward::check_pT(p, T).iterations;
+}
+
+// the number of Newton steps H2O::rhou() takes (the cold path)
+static int rhou_iterations(double rho, double u)
+{
+	h2o::backward::WarmStart ws;
+
+	ws.rhou(rho, u);
+	return ws.iterations();
+}
+
+static int vu_iterations(double v, double u)
+{
+	return rhou_iterations(1. / v, u);
+}
+
+static const Constructor constructors[] =
+{
+	{ "H2O::pT", H2O::pT, &H2O::p, &H2O::T, SINGLE_PHASE, 0 },
+	{ "H2O::Tx", H2O::Tx, &H2O::T, &H2O::x, TWO_PHASE, 0 },
+	{ "H2O::px", H2O::px, &H2O::p, &H2O::x, TWO_PHASE, 0 },
+	{ "H2O::ph", H2O::ph, &H2O::p, &H2O::h, ANY, 0 },
+	{ "H2O::ps", H2O::ps, &H2O::p, &H2O::s, ANY, 0 },
+	{ "H2O::hs", H2O::hs, &H2O::h, &H2O::s, ANY, 0 },
+	{ "H2O::rhoT", H2O::rhoT, &H2O::rho, &H2O::T, ANY, 0 },
+	{ "H2O::rhou", H2O::rhou, &H2O::rho, &H2O::u, ANY, rhou_iterations },
+	{ "H2O::vu", H2O::vu, &H2O::v, &H2O::u, ANY, vu_iterations },
+	{ "backward::ph/EXACT", backward_ph, &H2O::p, &H2O::h, ANY,
+		ph_iterations },
+	{ "backward::ps/EXACT", backward_ps, &H2O::p, &H2O::s, ANY,
+		ps_iterations },
+	{ "backward::hs/EXACT", backward_hs, &H2O::h, &H2O::s, ANY,
+		hs_iterations },
+	{ "backward::pT/EXACT", backward_pT, &H2O::p, &H2O::T, SINGLE_PHASE,
+		pT_iterations }
+};
+
+// instantiated for every getter, so that it is called directly
+// (and can be inlined with H2OXX_INLINE)
+template <getter_func_t Func>
+static void bench_getter(const Options& opts, const Getter& g,
+		const Workload& w);
+
+static const Getter getters[] =
+{
+	{ "H2O::p", &H2O::p, bench_getter<&H2O::p> },
+	{ "H2O::T", &H2O::T, bench_getter<&H2O::T> },
+	{ "H2O::x", &H2O::x, bench_getter<&H2O::x> },
+	{ "H2O::rho", &H2O::rho, bench_getter<&H2O::rho> },
+	{ "H2O::v", &H2O::v, bench_getter<&H2O::v> },
+	{ "H2O::u", &H2O::u, bench_getter<&H2O::u> },
+	{ "H2O::h", &H2O::h, bench_getter<&H2O::h> },
+	{ "H2O::s", &H2O::s, bench_getter<&H2O::s> },
+	{ "H2O::cp", &H2O::cp, bench_getter<&H2O::cp> },
+	{ "H2O::cv", &H2O::cv, bench_getter<&H2O::cv> },
+	{ "H2O::w", &H2O::w, bench_getter<&H2O::w> }
+};
+
+#define COUNT(a) (sizeof(a) / sizeof(*(a)))
+
+/**
+ * Call @func(i) for i in [0, count) repeatedly, for at least @min_time
+ * seconds in total. Returns the best time per call [ns] of three runs.
+ */
+template <class F>
+static double time_calls(F func, size_t count, double min_time)
+{
+	typedef std::chrono::steady_clock clock;
+
+	double best = std::numeric_limits<double>::infinity();
+	size_t passes = 1;
+
+	for (int run = 0; run < 3; )
+	{
+		double acc = 0.;
+		clock::time_point start = clock::now();
+
+		for (size_t n = 0; n < passes; ++n)
+			for (size_t i = 0; i < count; ++i)
+				acc += func(i);
+
+		double elapsed = std::chrono::duration<double>(
+				clock::now() - start).count();
+		sink = acc;
+
+		// calibrate the pass count first
+		if (run == 0 && elapsed < min_time / 3. && passes < (1U << 30))
+		{
+			passes *= 2;
+			continue;
+		}
+
+		double ns = elapsed * 1E9 / (passes * count);
+		if (ns < best)
+			best = ns;
+		++run;
+	}
+
+	return best;
+}
+
+/**
+ * Report a case. @iterations is the mean number of Newton steps per call
+ * and @max_iterations the maximal one, or NaN if not applicable.
+ */
+static void report(const Options& opts, const char* name,
+		const Workload& w, double ns, double iterations,
+		double max_iterations = nan_value)
+{
+	if (opts.csv)
+	{
+		std::printf("%s,%s,%s,%.3f,%.6g,", name, w.region, w.kind,
+				ns, 1E9 / ns);
+		if (iterations == iterations)
+			std::printf("%.3f,%.0f", iterations, max_iterations);
+		else
+			std::printf(",");
+		std::printf("\n");
+	}
+	else
+	{
+		std::printf("%-20s %-5s %-7s %12.1f %12.4g", name, w.region,
+				w.kind, ns, 1E9 / ns);
+		if (iterations == iterations)
+			std::printf(" %10.2f %5.0f\n", iterations, max_iterations);
+		else
+			std::printf(" %10s %5s\n", "-", "-");
+	}
+	std::fflush(stdout);
+}
+
+static bool selected(const Options& opts, const char* name)
+{
+	return !opts.filter || std::strstr(name, opts.filter);
+}
+
+static void bench_constructor(const Options& opts, const Constructor& c,
+		const Workload& w)
+{
+	bool two_phase = w.states[0].region() == Region::R4;
+
+	if ((c.scope == SINGLE_PHASE && two_phase)
+			|| (c.scope == TWO_PHASE && !two_phase))
+		return;
+
+	// collect the inputs the constructor accepts
+	std::vector<double> a, b;
+	double iterations = 0.;
+	int max_iterations = 0;
+
+	for (size_t i = 0; i < w.states.size(); ++i)
+	{
+		const H2O& st = w.states[i];
+		double va = (st.*c.a)();
+		double vb = (st.*c.b)();
+
+		try
+		{
+			c.func(va, vb);
+			if (c.iterations)
+			{
+				int n = c.iterations(va, vb);
+
+				iterations += n;
+				max_iterations = std::max(max_iterations, n);
+			}
+		}
+		catch (std::range_error& e)
+		{
+			continue;
+		}
+
+		a.push_back(va);
+		b.push_back(vb);
+	}
+
+	if (a.empty())
+		return;
+
+	double ns = time_calls([&](size_t i)
+			{
+				return static_cast<double>(c.func(a[i], b[i]).initialized());
+			}, a.size(), opts.min_time);
+
+	report(opts, c.name, w, ns,
+			c.iterations ? iterations / a.size() : nan_value,
+			max_iterations);
+}
+
+template <getter_func_t Func>
+static void bench_getter(const Options& opts, const Getter& g,
+		const Workload& w)
+{
+	// x is undefined in region 3
+	if (g.func == &H2O::x && w.states[0].region() == Region::R3)
+		return;
+
+	const std::vector<H2O>& states = w.states;
+	double ns = time_calls([&](size_t i)
+			{
+				return (states[i].*Func)();
+			}, states.size(), opts.min_time);
+
+	report(opts, g.name, w, ns, nan_value);
+}
+
+static void bench_properties(const Options& opts, const Workload& w)
+{
+	const std::vector<H2O>& states = w.states;
+	double ns = time_calls([&](size_t i)
+			{
+				return states[i].properties().h;
+			}, states.size(), opts.min_time);
+
+	report(opts, "H2O::properties", w, ns, nan_value);
+}
+
+static void bench_expand(const Options& opts, const Workload& w,
+		bool eta)
+{
+	// expansion is not supported in region 5
+	if (w.states[0].region() == Region::R5)
+		return;
+
+	std::vector<const H2O*> states;
+	std::vector<double> pout;
+
+	for (size_t i = 0; i < w.states.size(); ++i)
+	{
+		const H2O& st = w.states[i];
+		double p = st.p() / 2.;
+
+		try
+		{
+			st.expand(p, 0.85);
+		}
+		catch (std::range_error& e)
+		{
+			continue;
+		}
+
+		states.push_back(&st);
+		pout.push_back(p);
+	}
+
+	if (states.empty())
+		return;
+
+	double ns;
+	if (eta)
+		ns = time_calls([&](size_t i)
+				{
+					return states[i]->expand(pout[i], 0.85).h();
+				}, states.size(), opts.min_time);
+	else
+		ns = time_calls([&](size_t i)
+				{
+					return states[i]->expand(pout[i]).h();
+				}, states.size(), opts.min_time);
+
+	report(opts, eta ? "H2O::expand/eta" : "H2O::expand", w, ns,
+			nan_value);
+}
+
+/**
+ * Obtain the state points from (rho,u), or from (v,u) as 1/v, using
+ * H2O::warm_rhou() with a nearby hint, like in the next time step
+ * of a flow simulation.
+ */
+static void bench_warm_rhou(const Options& opts, const Workload& w,
+		bool vu)
+{
+	std::vector<double> a, u;
+	std::vector<H2O> hints;
+	double iterations = 0.;
+	int max_iterations = 0;
+
+	for (size_t i = 0; i < w.states.size(); ++i)
+	{
+		const H2O& st = w.states[i];
+		H2O hint = H2O::try_rhoT(st.rho() * 1.001, st.T() + 0.1);
+		h2o::backward::WarmStart ws(hint);
+
+		if (!hint.initialized())
+			continue;
+
+		try
+		{
+			ws.rhou(st.rho(), st.u());
+		}
+		catch (std::range_error& e)
+		{
+			continue;
+		}
+
+		iterations += ws.iterations();
+		max_iterations = std::max(max_iterations, ws.iterations());
+		a.push_back(vu ? st.v() : st.rho());
+		u.push_back(st.u());
+		hints.push_back(hint);
+	}
+
+	if (a.empty())
+		return;
+
+	double ns;
+	if (vu)
+		ns = time_calls([&](size_t i)
+				{
+					return H2O::warm_rhou(1. / a[i], u[i], hints[i]).T();
+				}, a.size(), opts.min_time);
+	else
+		ns = time_calls([&](size_t i)
+				{
+					return H2O::warm_rhou(a[i], u[i], hints[i]).T();
+				}, a.size(), opts.min_time);
+
+	report(opts, vu ? "H2O::warm_rhou/vu" : "H2O::warm_rhou", w, ns,
+			iterations / a.size(), max_iterations);
+}
+
+static const char* const isa_names[] =
+{
+	"batch::pT/scalar",
+	"batch::pT/sse2",
+	"batch::pT/avx2",
+	"batch::pT/avx512"
+};
+
+/**
+ * Evaluate the whole workload using batch::pT() with every instruction
+ * set the CPU supports. The time is per state point, on a single core.
+ */
+static void bench_batch(const Options& opts, const Workload& w)
+{
+	const Region r = w.states[0].region();
+
+	// the bulk kernels cover regions 1 & 2
+	if (r != Region::R1 && r != Region::R2)
+		return;
+
+	std::vector<double> p, T;
+
+	for (size_t i = 0; i < w.states.size(); ++i)
+	{
+		p.push_back(w.states[i].p());
+		T.push_back(w.states[i].T());
+	}
+
+	const h2o::batch::isa_type isa0 = h2o::batch::isa();
+	h2o::H2OArray out;
+
+	for (int k = h2o::batch::ISA_SCALAR; k <= h2o::batch::ISA_AVX512; ++k)
+	{
+		if (!selected(opts, isa_names[k])
+				|| !h2o::batch::set_isa(static_cast<h2o::batch::isa_type>(k)))
+			continue;
+
+		double ns = time_calls([&](size_t)
+				{
+					h2o::batch::pT(p, T, out);
+					return out.h[0];
+				}, 1, opts.min_time);
+
+		report(opts, isa_names[k], w, ns / p.size(), nan_value);
+	}
+
+	h2o::batch::set_isa(isa0);
+}
+
+/**
+ * Draw @count random state points in @region from a (p,T) box.
+ */
+static std::vector<H2O> random_pT(std::mt19937& rng, size_t count,
+		Region region, double pmin, double pmax, double Tmin, double Tmax)
+{
+	std::uniform_real_distribution<double> p(pmin, pmax), T(Tmin, Tmax);
+	std::vector<H2O> ret;
+
+	while (ret.size() < count)
+	{
+		H2O st = H2O::try_pT(p(rng), T(rng));
+
+		if (st.initialized() && st.region() == region)
+			ret.push_back(st);
+	}
+
+	return ret;
+}
+
+static std::vector<H2O> random_Tx(std::mt19937& rng, size_t count)
+{
+	std::uniform_real_distribution<double> T(273.16, 647.), x(0., 1.);
+	std::vector<H2O> ret;
+
+	while (ret.size() < count)
+		ret.push_back(H2O::Tx(T(rng), x(rng)));
+
+	return ret;
+}
+
+static std::vector<Workload> workloads(const Options& opts)
+{
+	std::mt19937 rng(opts.seed);
+	std::vector<Workload> ret;
+
+	// fixed points (mostly the IF97 verification ones)
+	ret.push_back({ "R1", "fixed", { H2O::pT(3., 300.) } });
+	ret.push_back({ "R2", "fixed", { H2O::pT(0.0035, 700.) } });
+	ret.push_back({ "R3", "fixed", { H2O::rhoT(500., 650.) } });
+	ret.push_back({ "R3nc", "fixed", { H2O::pT(23., 648.) } });
+	ret.push_back({ "R4", "fixed", { H2O::Tx(450., 0.5) } });
+	ret.push_back({ "R5", "fixed", { H2O::pT(30., 1500.) } });
+
+	// random state points
+	ret.push_back({ "R1", "random", random_pT(rng, opts.count,
+			Region::R1, 0.1, 100., 273.15, 623.15) });
+	ret.push_back({ "R2", "random", random_pT(rng, opts.count,
+			Region::R2, 0.001, 100., 300., 1073.15) });
+	ret.push_back({ "R3", "random", random_pT(rng, opts.count,
+			Region::R3, 16.6, 100., 623.15, 863.15) });
+	ret.push_back({ "R3nc", "random", random_pT(rng, opts.count,
+			Region::R3, 21., 23., 640., 655.) });
+	ret.push_back({ "R4", "random", random_Tx(rng, opts.count) });
+	ret.push_back({ "R5", "random", random_pT(rng, opts.count,
+			Region::R5, 0.001, 50., 1073.15, 2273.15) });
+
+	return ret;
+}
+
+static void usage(const char* argv0)
+{
+	std::cerr << "Usage: " << argv0
+		<< " [-t seconds] [-n count] [-s seed] [-f text|csv] [filter]\n"
+		<< "\n"
+		<< "  -t  minimal time per case (default: 0.2 s)\n"
+		<< "  -n  number of random state points per region (default: 1000)\n"
+		<< "  -s  random seed (default: 0)\n"
+		<< "  -f  output format (default: text)\n"
+		<< "  filter  run only the cases whose names contain the string\n";
+}
+
+int main(int argc, char* argv[])
+{
+	Options opts = { 0.2, false, 0, 1000, 0 };
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* arg = argv[i];
+
+		if (arg[0] == '-' && i + 1 < argc)
+		{
+			const char* val = argv[++i];
+
+			if (!std::strcmp(arg, "-t"))
+				opts.min_time = std::atof(val);
+			else if (!std::strcmp(arg, "-n"))
+				opts.count = std::strtoul(val, 0, 10);
+			else if (!std::strcmp(arg, "-s"))
+				opts.seed = std::strtoul(val, 0, 10);
+			else if (!std::strcmp(arg, "-f") && !std::strcmp(val, "csv"))
+				opts.csv = true;
+			else if (!std::strcmp(arg, "-f") && !std::strcmp(val, "text"))
+				opts.csv = false;
+			else
+			{
+				usage(argv[0]);
+				return 1;
+			}
+		}
+		else if (arg[0] != '-' && !opts.filter)
+			opts.filter = arg;
+		else
+		{
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (opts.min_time <= 0. || opts.count == 0)
+	{
+		usage(argv[0]);
+		return 1;
+	}
+
+	if (opts.csv)
+		std::printf("case,region,workload,ns_per_call,calls_per_s,"
+				"iterations,max_iterations\n");
+	else
+		std::printf("%-20s %-5s %-7s %12s %12s %10s %5s\n", "case",
+				"region", "load", "ns/call", "calls/s", "iterations",
+				"max");
+
+	std::vector<Workload> loads = workloads(opts);
+
+	for (size_t i = 0; i < COUNT(constructors); ++i)
+	{
+		if (!selected(opts, constructors[i].name))
+			continue;
+		for (size_t j = 0; j < loads.size(); ++j)
+			bench_constructor(opts, constructors[i], loads[j]);
+	}
+
+	for (size_t i = 0; i < COUNT(getters); ++i)
+	{
+		if (!selected(opts, getters[i].name))
+			continue;
+		for (size_t j = 0; j < loads.size(); ++j)
+			getters[i].bench(opts, getters[i], loads[j]);
+	}
+
+	if (selected(opts, "H2O::properties"))
+		for (size_t j = 0; j < loads.size(); ++j)
+			bench_properties(opts, loads[j]);
+
+	for (size_t j = 0; j < loads.size(); ++j)
+		bench_batch(opts, loads[j]);
+
+	for (int vu = 0; vu < 2; ++vu)
+	{
+		if (!selected(opts, vu ? "H2O::warm_rhou/vu" : "H2O::warm_rhou"))
+			continue;
+		for (size_t j = 0; j < loads.size(); ++j)
+			bench_warm_rhou(opts, loads[j], vu);
+	}
+
+	for (int eta = 0; eta < 2; ++eta)
+	{
+		if (!selected(opts, eta ? "H2O::expand/eta" : "H2O::expand"))
+			continue;
+		for (size_t j = 0; j < loads.size(); ++j)
+			bench_expand(opts, loads[j], eta);
+	}
+
+	return 0;
+}
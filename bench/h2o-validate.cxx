@@ -0,0 +1,990 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+/**
+ * h2o-validate -- compare the approximate and fast evaluation paths
+ * against H2O.
+ *
+ * The state points are sampled in every region, both uniformly
+ * and densified at the region boundaries (the saturation line, B23,
+ * the 623.15 K and 1073.15 K isotherms and the critical point), where
+ * the boundary workloads are offset from the boundary by relative
+ * distances spread log-uniformly over 1E-9..1E-2. Every path is
+ * evaluated from the respective arguments of the reference state
+ * points, and compared against their H2O properties.
+ *
+ * For every path and workload, it reports the number of points the path
+ * rejected, the fraction of points classified into a different region,
+ * and for the remaining ones, the worst-case and RMS relative error
+ * over the compared properties (absolute below 1 for u, h and s)
+ * and the distribution of the distance in ULPs. For the paths taking
+ * other arguments than (p,T) or (T,x), the resulting state
+ * is reconstructed from (p,T), (rho,T) or (p,x), and the arguments
+ * are compared with the original ones (i.e. the round trip pT -> ph
+ * -> pT). The time per point is measured on a single core.
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o"
+#include "h2o_backward"
+#include "h2o_batch"
+#include "h2o_classifier"
+#include "h2o_precision"
+#include "h2o_saturation"
+#include "h2o_sbtl"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using h2o::H2O;
+using h2o::H2OArray;
+using h2o::PropertySet;
+using h2o::Region;
+
+typedef double (H2O::*getter_func_t)() const;
+
+static const double nan_value = std::numeric_limits<double>::quiet_NaN();
+static const double inf_value = std::numeric_limits<double>::infinity();
+
+// keeps the results alive
+static volatile double sink;
+
+struct Options
+{
+	double min_time;
+	bool csv;
+	unsigned int seed;
+	size_t count;
+	size_t threads;
+	const char* filter;
+};
+
+/**
+ * The results of an evaluation path for a single state point.
+ * The region is Region::OOR if the path rejected the state point,
+ * the properties not provided by the path are NaN.
+ */
+struct Result
+{
+	Region region;
+	PropertySet props;
+};
+
+typedef void (*path_func_t)(const double* a, const double* b, size_t n,
+		Result* out);
+
+/**
+ * The states a path can be evaluated on.
+ */
+typedef enum
+{
+	ANY,
+	SINGLE_PHASE,
+	TWO_PHASE
+} scope_type;
+
+struct Path
+{
+	const char* name;
+	path_func_t func;
+	getter_func_t a, b;
+	scope_type scope;
+	// the compared properties (H2OArray column flags)
+	unsigned columns;
+	bool roundtrip;
+	bool (*available)();
+};
+
+/**
+ * A set of reference state points.
+ */
+struct Workload
+{
+	const char* region;
+	const char* kind;
+	std::vector<H2O> states;
+	std::vector<PropertySet> props;
+};
+
+struct Property
+{
+	const char* name;
+	H2OArray::column_type column;
+	double PropertySet::*data;
+	double floor;
+};
+
+// x is left out, the region check covers the phase
+static const Property properties[] =
+{
+	{ "p", H2OArray::COL_P, &PropertySet::p, 0. },
+	{ "T", H2OArray::COL_T, &PropertySet::T, 0. },
+	{ "rho", H2OArray::COL_RHO, &PropertySet::rho, 0. },
+	{ "v", H2OArray::COL_V, &PropertySet::v, 0. },
+	{ "u", H2OArray::COL_U, &PropertySet::u, 1. },
+	{ "h", H2OArray::COL_H, &PropertySet::h, 1. },
+	{ "s", H2OArray::COL_S, &PropertySet::s, 1. },
+	{ "cp", H2OArray::COL_CP, &PropertySet::cp, 0. },
+	{ "cv", H2OArray::COL_CV, &PropertySet::cv, 0. },
+	{ "w", H2OArray::COL_W, &PropertySet::w, 0. }
+};
+
+#define COUNT(a) (sizeof(a) / sizeof(*(a)))
+
+static const unsigned all_columns = H2OArray::COL_ALL & ~H2OArray::COL_X;
+// the properties of two-phase mixtures, without cp, cv and w
+static const unsigned mixture_columns = H2OArray::COL_P | H2OArray::COL_T
+	| H2OArray::COL_RHO | H2OArray::COL_V | H2OArray::COL_U
+	| H2OArray::COL_H | H2OArray::COL_S;
+
+static void clear(Result& r)
+{
+	r.region = Region::OOR;
+	r.props.p = r.props.T = r.props.x = r.props.rho = nan_value;
+	r.props.v = r.props.u = r.props.h = r.props.s = nan_value;
+	r.props.cp = r.props.cv = r.props.w = nan_value;
+}
+
+// evaluate a H2O constructor
+template <H2O (*Func)(double, double)>
+static void h2o_path(const double* a, const double* b, size_t n,
+		Result* out)
+{
+	for (size_t i = 0; i < n; ++i)
+	{
+		clear(out[i]);
+		try
+		{
+			H2O st = Func(a[i], b[i]);
+
+			out[i].region = st.region();
+			out[i].props = st.properties();
+		}
+		catch (std::range_error& e)
+		{
+		}
+	}
+}
+
+template <H2O (*Func)(double, double, h2o::backward::mode_type),
+	h2o::backward::mode_type Mode>
+static H2O with_mode(double a, double b)
+{
+	return Func(a, b, Mode);
+}
+
+/**
+ * Get the region of an interpolated state, as sbtl::Table::state()
+ * does: x is NaN in region 3, and 0 or 1 for single-phase states.
+ */
+static Region region_of(const PropertySet& ps)
+{
+	if (ps.x != ps.x)
+		return Region::R3;
+	else if (ps.x > 0. && ps.x < 1.)
+		return Region::R4;
+	else if (ps.x == 0. && ps.T <= 623.15)
+		return Region::R1;
+	return Region::R2;
+}
+
+template <PropertySet (*Func)(double, double)>
+static void sbtl_path(const double* a, const double* b, size_t n,
+		Result* out)
+{
+	for (size_t i = 0; i < n; ++i)
+	{
+		clear(out[i]);
+		try
+		{
+			out[i].props = Func(a[i], b[i]);
+			out[i].region = region_of(out[i].props);
+		}
+		catch (std::range_error& e)
+		{
+		}
+	}
+}
+
+template <h2o::batch::isa_type Isa>
+static bool isa_available()
+{
+	const h2o::batch::isa_type isa0 = h2o::batch::isa();
+	bool ret = h2o::batch::set_isa(Isa);
+
+	h2o::batch::set_isa(isa0);
+	return ret;
+}
+
+template <h2o::batch::isa_type Isa>
+static void batch_path(const double* a, const double* b, size_t n,
+		Result* out)
+{
+	H2OArray arr;
+
+	// all the threads select the same instruction set
+	h2o::batch::set_isa(Isa);
+	h2o::batch::pT(h2o::batch::View(a, n), h2o::batch::View(b, n), arr);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		PropertySet& ps = out[i].props;
+
+		out[i].region = arr.region[i];
+		ps.p = arr.p[i];
+		ps.T = arr.T[i];
+		ps.x = arr.x[i];
+		ps.rho = arr.rho[i];
+		ps.v = arr.v[i];
+		ps.u = arr.u[i];
+		ps.h = arr.h[i];
+		ps.s = arr.s[i];
+		ps.cp = arr.cp[i];
+		ps.cv = arr.cv[i];
+		ps.w = arr.w[i];
+	}
+}
+
+template <class Real, h2o::BasicH2O<Real> (*Func)(Real, Real)>
+static void precision_path(const double* a, const double* b, size_t n,
+		Result* out)
+{
+	for (size_t i = 0; i < n; ++i)
+	{
+		clear(out[i]);
+		try
+		{
+			h2o::BasicH2O<Real> st = Func(a[i], b[i]);
+			h2o::BasicPropertySet<Real> bp = st.properties();
+			PropertySet& ps = out[i].props;
+
+			out[i].region = st.region();
+			ps.p = bp.p;
+			ps.T = bp.T;
+			ps.x = bp.x;
+			ps.rho = bp.rho;
+			ps.v = bp.v;
+			ps.u = bp.u;
+			ps.h = bp.h;
+			ps.s = bp.s;
+			ps.cp = bp.cp;
+			ps.cv = bp.cv;
+			ps.w = bp.w;
+		}
+		catch (std::range_error& e)
+		{
+		}
+	}
+}
+
+static void saturation_table_path(const double* a, const double* b,
+		size_t n, Result* out)
+{
+	const h2o::saturation::Table& table = h2o::saturation::table();
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		clear(out[i]);
+		try
+		{
+			out[i].props = table.T(a[i]).mixture(b[i]);
+			out[i].region = Region::R4;
+		}
+		catch (std::range_error& e)
+		{
+		}
+	}
+}
+
+template <Region (*Func)(double, double)>
+static void classifier_path(const double* a, const double* b, size_t n,
+		Result* out)
+{
+	for (size_t i = 0; i < n; ++i)
+	{
+		clear(out[i]);
+		out[i].region = Func(a[i], b[i]);
+	}
+}
+
+using h2o::backward::FAST;
+using h2o::backward::POLISH;
+using h2o::backward::EXACT;
+using h2o::batch::ISA_SCALAR;
+using h2o::batch::ISA_SSE2;
+using h2o::batch::ISA_AVX2;
+using h2o::batch::ISA_AVX512;
+
+static const unsigned sbtl_columns = H2OArray::COL_P | H2OArray::COL_T
+	| H2OArray::COL_RHO | H2OArray::COL_V | H2OArray::COL_U
+	| H2OArray::COL_H | H2OArray::COL_S;
+
+static const Path paths[] =
+{
+	{ "H2O::ph", h2o_path<H2O::ph>, &H2O::p, &H2O::h, ANY,
+		all_columns, true, 0 },
+	{ "H2O::ps", h2o_path<H2O::ps>, &H2O::p, &H2O::s, ANY,
+		all_columns, true, 0 },
+	{ "H2O::hs", h2o_path<H2O::hs>, &H2O::h, &H2O::s, ANY,
+		all_columns, true, 0 },
+	{ "backward::ph/FAST", h2o_path<with_mode<h2o::backward::ph, FAST> >,
+		&H2O::p, &H2O::h, ANY, all_columns, true, 0 },
+	{ "backward::ph/POLISH",
+		h2o_path<with_mode<h2o::backward::ph, POLISH> >,
+		&H2O::p, &H2O::h, ANY, all_columns, true, 0 },
+	{ "backward::ph/EXACT", h2o_path<with_mode<h2o::backward::ph, EXACT> >,
+		&H2O::p, &H2O::h, ANY, all_columns, true, 0 },
+	{ "backward::ps/FAST", h2o_path<with_mode<h2o::backward::ps, FAST> >,
+		&H2O::p, &H2O::s, ANY, all_columns, true, 0 },
+	{ "backward::ps/POLISH",
+		h2o_path<with_mode<h2o::backward::ps, POLISH> >,
+		&H2O::p, &H2O::s, ANY, all_columns, true, 0 },
+	{ "backward::ps/EXACT", h2o_path<with_mode<h2o::backward::ps, EXACT> >,
+		&H2O::p, &H2O::s, ANY, all_columns, true, 0 },
+	{ "backward::hs/FAST", h2o_path<with_mode<h2o::backward::hs, FAST> >,
+		&H2O::h, &H2O::s, ANY, all_columns, true, 0 },
+	{ "backward::hs/POLISH",
+		h2o_path<with_mode<h2o::backward::hs, POLISH> >,
+		&H2O::h, &H2O::s, ANY, all_columns, true, 0 },
+	{ "backward::hs/EXACT", h2o_path<with_mode<h2o::backward::hs, EXACT> >,
+		&H2O::h, &H2O::s, ANY, all_columns, true, 0 },
+	{ "backward::pT/FAST", h2o_path<with_mode<h2o::backward::pT, FAST> >,
+		&H2O::p, &H2O::T, SINGLE_PHASE, all_columns, false, 0 },
+	{ "backward::pT/EXACT", h2o_path<with_mode<h2o::backward::pT, EXACT> >,
+		&H2O::p, &H2O::T, SINGLE_PHASE, all_columns, false, 0 },
+	{ "sbtl::ph", sbtl_path<h2o::sbtl::ph>, &H2O::p, &H2O::h, ANY,
+		sbtl_columns, true, 0 },
+	{ "sbtl::ps", sbtl_path<h2o::sbtl::ps>, &H2O::p, &H2O::s, ANY,
+		sbtl_columns, true, 0 },
+	{ "batch::pT/scalar", batch_path<ISA_SCALAR>, &H2O::p, &H2O::T,
+		SINGLE_PHASE, all_columns, false, isa_available<ISA_SCALAR> },
+	{ "batch::pT/sse2", batch_path<ISA_SSE2>, &H2O::p, &H2O::T,
+		SINGLE_PHASE, all_columns, false, isa_available<ISA_SSE2> },
+	{ "batch::pT/avx2", batch_path<ISA_AVX2>, &H2O::p, &H2O::T,
+		SINGLE_PHASE, all_columns, false, isa_available<ISA_AVX2> },
+	{ "batch::pT/avx512", batch_path<ISA_AVX512>, &H2O::p, &H2O::T,
+		SINGLE_PHASE, all_columns, false, isa_available<ISA_AVX512> },
+	{ "H2Of::pT", precision_path<float, h2o::H2Of::pT>, &H2O::p, &H2O::T,
+		SINGLE_PHASE, all_columns, false, 0 },
+	{ "H2Of::Tx", precision_path<float, h2o::H2Of::Tx>, &H2O::T, &H2O::x,
+		TWO_PHASE, mixture_columns, false, 0 },
+	{ "H2Ol::pT", precision_path<long double, h2o::H2Ol::pT>,
+		&H2O::p, &H2O::T, SINGLE_PHASE, all_columns, false, 0 },
+	{ "H2Ol::Tx", precision_path<long double, h2o::H2Ol::Tx>,
+		&H2O::T, &H2O::x, TWO_PHASE, mixture_columns, false, 0 },
+	{ "saturation::table", saturation_table_path, &H2O::T, &H2O::x,
+		TWO_PHASE, mixture_columns, false, 0 },
+	{ "classifier::pT", classifier_path<h2o::classifier::pT>,
+		&H2O::p, &H2O::T, SINGLE_PHASE, 0, false, 0 },
+	{ "classifier::ph", classifier_path<h2o::classifier::ph>,
+		&H2O::p, &H2O::h, ANY, 0, false, 0 },
+	{ "classifier::ps", classifier_path<h2o::classifier::ps>,
+		&H2O::p, &H2O::s, ANY, 0, false, 0 }
+};
+
+static double relative_error(double value, double expected, double floor)
+{
+	double ret = std::fabs(value - expected)
+		/ std::max(std::fabs(expected), floor);
+
+	// undefined in both, a missing value, or an exact zero
+	if (ret != ret)
+	{
+		if (value != value && expected != expected)
+			return 0.;
+		return value == expected ? 0. : inf_value;
+	}
+	return ret;
+}
+
+/**
+ * Get the distance between two doubles in units in the last place.
+ */
+static double ulps(double a, double b)
+{
+	if (a == b || (a != a && b != b))
+		return 0.;
+	if (a != a || b != b)
+		return inf_value;
+
+	std::int64_t ia, ib;
+
+	std::memcpy(&ia, &a, sizeof(ia));
+	std::memcpy(&ib, &b, sizeof(ib));
+
+	// map the negative values so that the integers are monotonic
+	if (ia < 0)
+		ia = std::numeric_limits<std::int64_t>::min() - ia;
+	if (ib < 0)
+		ib = std::numeric_limits<std::int64_t>::min() - ib;
+
+	return std::fabs(static_cast<double>(ia) - static_cast<double>(ib));
+}
+
+/**
+ * Reconstruct a state point from the results of a path.
+ */
+static H2O reconstruct(const Result& r)
+{
+	if (r.region == Region::R4)
+		return H2O::try_px(r.props.p, r.props.x);
+	else if (r.region == Region::R3)
+		return H2O::try_rhoT(r.props.rho, r.props.T);
+	return H2O::try_pT(r.props.p, r.props.T);
+}
+
+static double getter_floor(getter_func_t g)
+{
+	return g == &H2O::h || g == &H2O::s ? 1. : 0.;
+}
+
+/**
+ * The per-point comparison results.
+ */
+struct Comparison
+{
+	bool failed;
+	bool mismatched;
+	double error;
+	int property;
+	double ulps;
+	double roundtrip;
+};
+
+static void compare(const Path& path, const Workload& w,
+		const double* a, const double* b, size_t begin, size_t end,
+		std::vector<Result>& results, std::vector<Comparison>& out)
+{
+	path.func(a + begin, b + begin, end - begin, &results[begin]);
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		const Result& r = results[i];
+		const PropertySet& ref = w.props[i];
+		Comparison& c = out[i];
+
+		c.failed = r.region == Region::OOR;
+		c.mismatched = !c.failed && r.region != w.states[i].region();
+		c.error = c.ulps = c.roundtrip = 0.;
+		c.property = -1;
+
+		if (c.failed)
+			continue;
+
+		for (size_t k = 0; k < COUNT(properties); ++k)
+		{
+			const Property& prop = properties[k];
+
+			if (!(path.columns & prop.column) || c.mismatched)
+				continue;
+
+			double value = r.props.*prop.data;
+			double expected = ref.*prop.data;
+			double err = relative_error(value, expected, prop.floor);
+
+			if (err > c.error || c.property == -1)
+			{
+				c.error = err;
+				c.property = k;
+			}
+			c.ulps = std::max(c.ulps, ulps(value, expected));
+		}
+
+		if (path.roundtrip)
+		{
+			H2O back = reconstruct(r);
+
+			if (!back.initialized())
+				c.roundtrip = inf_value;
+			else
+				c.roundtrip = std::max(
+						relative_error((back.*path.a)(), a[i],
+							getter_floor(path.a)),
+						relative_error((back.*path.b)(), b[i],
+							getter_floor(path.b)));
+		}
+	}
+}
+
+/**
+ * Call the path on (at most) the first 1000 state points repeatedly,
+ * for at least @min_time seconds in total. Returns the best time per
+ * point [ns] of three runs.
+ */
+static double time_path(const Path& path, const std::vector<double>& a,
+		const std::vector<double>& b, double min_time)
+{
+	typedef std::chrono::steady_clock clock;
+
+	const size_t count = std::min(a.size(), static_cast<size_t>(1000));
+	std::vector<Result> results(count);
+	double best = inf_value;
+	size_t passes = 1;
+
+	for (int run = 0; run < 3; )
+	{
+		clock::time_point start = clock::now();
+
+		for (size_t n = 0; n < passes; ++n)
+			path.func(&a[0], &b[0], count, &results[0]);
+
+		double elapsed = std::chrono::duration<double>(
+				clock::now() - start).count();
+		sink = results[0].props.T;
+
+		// calibrate the pass count first
+		if (run == 0 && elapsed < min_time / 3. && passes < (1U << 30))
+		{
+			passes *= 2;
+			continue;
+		}
+
+		double ns = elapsed * 1E9 / (passes * count);
+		if (ns < best)
+			best = ns;
+		++run;
+	}
+
+	return best;
+}
+
+static double percentile(std::vector<double>& values, double q)
+{
+	if (values.empty())
+		return nan_value;
+
+	std::vector<double>::iterator it = values.begin()
+		+ static_cast<size_t>(q * (values.size() - 1));
+
+	std::nth_element(values.begin(), it, values.end());
+	return *it;
+}
+
+static void print_value(const Options& opts, const char* fmt, double val,
+		bool last = false)
+{
+	if (opts.csv)
+	{
+		if (val == val)
+			std::printf("%.6g", val);
+		std::printf(last ? "\n" : ",");
+	}
+	else
+	{
+		if (val == val)
+			std::printf(fmt, val);
+		else
+			std::printf(" %9s", "-");
+		if (last)
+			std::printf("\n");
+	}
+}
+
+static void validate(const Options& opts, const Path& path,
+		const Workload& w)
+{
+	bool two_phase = w.states[0].region() == Region::R4;
+
+	if ((path.scope == SINGLE_PHASE && two_phase)
+			|| (path.scope == TWO_PHASE && !two_phase))
+		return;
+
+	const size_t n = w.states.size();
+	std::vector<double> a(n), b(n);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		a[i] = (w.states[i].*path.a)();
+		b[i] = (w.states[i].*path.b)();
+	}
+
+	// evaluate & compare in parallel
+	std::vector<Result> results(n);
+	std::vector<Comparison> cmp(n);
+	std::vector<std::thread> threads;
+	size_t chunk = (n + opts.threads - 1) / opts.threads;
+
+	for (size_t begin = 0; begin < n; begin += chunk)
+		threads.push_back(std::thread(compare, std::cref(path),
+					std::cref(w), &a[0], &b[0], begin,
+					std::min(begin + chunk, n), std::ref(results),
+					std::ref(cmp)));
+	for (size_t k = 0; k < threads.size(); ++k)
+		threads[k].join();
+
+	size_t failed = 0, mismatched = 0, evaluated = 0, compared = 0;
+	double max_err = 0., sum_sq = 0., rt_max = 0., rt_sum_sq = 0.;
+	size_t worst = n;
+	std::vector<double> ulp;
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		const Comparison& c = cmp[i];
+
+		if (c.failed)
+		{
+			++failed;
+			continue;
+		}
+
+		++evaluated;
+		rt_max = std::max(rt_max, c.roundtrip);
+		rt_sum_sq += c.roundtrip * c.roundtrip;
+
+		// the properties are discontinuous across the region boundaries
+		if (c.mismatched)
+		{
+			++mismatched;
+			continue;
+		}
+
+		++compared;
+		if (worst == n || c.error > max_err)
+		{
+			max_err = c.error;
+			worst = i;
+		}
+		sum_sq += c.error * c.error;
+		ulp.push_back(c.ulps);
+	}
+
+	bool accuracy = path.columns && compared;
+	bool roundtrip = path.roundtrip && evaluated;
+	const char* prop = accuracy && cmp[worst].property != -1
+		? properties[cmp[worst].property].name : "-";
+
+	double ns = time_path(path, a, b, opts.min_time);
+
+	if (opts.csv)
+		std::printf("%s,%s,%s,%zu,%zu,%zu,", path.name, w.region, w.kind,
+				n, failed, mismatched);
+	else
+		std::printf("%-20s %-3s %-7s %8zu %7zu %6.2f%%", path.name,
+				w.region, w.kind, n, failed,
+				evaluated ? 100. * mismatched / evaluated : 0.);
+
+	print_value(opts, " %9.2e", accuracy ? max_err : nan_value);
+	if (opts.csv)
+	{
+		std::printf("%s,", accuracy ? prop : "");
+		print_value(opts, "", accuracy ? w.states[worst].p() : nan_value);
+		print_value(opts, "", accuracy ? w.states[worst].T() : nan_value);
+	}
+	else
+		std::printf(" %-4s", prop);
+	print_value(opts, " %9.2e",
+			accuracy ? std::sqrt(sum_sq / compared) : nan_value);
+
+	print_value(opts, " %9.3g", accuracy ? percentile(ulp, 0.5) : nan_value);
+	if (opts.csv)
+		print_value(opts, "", accuracy ? percentile(ulp, 0.9) : nan_value);
+	print_value(opts, " %9.3g", accuracy ? percentile(ulp, 0.99) : nan_value);
+	print_value(opts, " %9.3g", accuracy ? percentile(ulp, 1.) : nan_value);
+
+	print_value(opts, " %9.2e", roundtrip ? rt_max : nan_value);
+	if (opts.csv)
+		print_value(opts, "", roundtrip
+				? std::sqrt(rt_sum_sq / evaluated) : nan_value);
+	print_value(opts, " %9.1f", ns, true);
+
+	std::fflush(stdout);
+}
+
+// the IF97 B23 boundary equation (eq. 5)
+static double pB23(double T)
+{
+	return 0.34805185628969E3 - 0.11671859879975E1 * T
+		+ 0.10192970039326E-2 * T * T;
+}
+
+static double psat(double T)
+{
+	return H2O::Tx(T, 0.).p();
+}
+
+/**
+ * Random number helpers.
+ */
+class Sampler
+{
+	std::mt19937 _rng;
+
+public:
+	Sampler(unsigned int seed)
+		: _rng(seed)
+	{
+	}
+
+	double uniform(double a, double b)
+	{
+		return std::uniform_real_distribution<double>(a, b)(_rng);
+	}
+
+	double log_uniform(double a, double b)
+	{
+		return std::exp(uniform(std::log(a), std::log(b)));
+	}
+
+	// a relative offset from a boundary
+	double offset()
+	{
+		return log_uniform(1E-9, 1E-2);
+	}
+
+	double sign()
+	{
+		return uniform(0., 1.) < 0.5 ? -1. : 1.;
+	}
+};
+
+/**
+ * Draw @count state points in @region using @gen. The state points
+ * outside the region are discarded.
+ */
+template <class F>
+static Workload sample(const char* name, const char* kind, Region region,
+		size_t count, F gen)
+{
+	Workload ret = { name, kind, {}, {} };
+
+	for (size_t tries = 0; ret.states.size() < count
+			&& tries < 100 * count; ++tries)
+	{
+		H2O st = gen();
+
+		if (st.initialized() && st.region() == region)
+		{
+			ret.states.push_back(st);
+			ret.props.push_back(st.properties());
+		}
+	}
+
+	if (ret.states.empty())
+	{
+		std::cerr << "Unable to sample " << name << "/" << kind
+			<< std::endl;
+		std::exit(1);
+	}
+
+	return ret;
+}
+
+static std::vector<Workload> workloads(const Options& opts)
+{
+	const double Tc = 647.096, pc = 22.064;
+	const double p13 = psat(623.15);
+
+	Sampler r(opts.seed);
+	std::vector<Workload> ret;
+
+	// half of the points uniform, half near the region boundaries
+	size_t n = opts.count;
+
+	ret.push_back(sample("R1", "uniform", Region::R1, n / 2, [&]()
+			{
+				return H2O::try_pT(r.log_uniform(0.001, 100.),
+						r.uniform(273.15, 623.15));
+			}));
+	ret.push_back(sample("R1", "sat", Region::R1, n / 4, [&]()
+			{
+				double T = r.uniform(273.16, 623.15);
+				return H2O::try_pT(psat(T) * (1. + r.offset()), T);
+			}));
+	ret.push_back(sample("R1", "b13", Region::R1, n / 4, [&]()
+			{
+				return H2O::try_pT(r.uniform(p13, 100.),
+						623.15 * (1. - r.offset()));
+			}));
+
+	ret.push_back(sample("R2", "uniform", Region::R2, n / 2, [&]()
+			{
+				return H2O::try_pT(r.log_uniform(0.001, 100.),
+						r.uniform(273.15, 1073.15));
+			}));
+	ret.push_back(sample("R2", "sat", Region::R2, n / 6, [&]()
+			{
+				double T = r.uniform(273.16, 623.15);
+				return H2O::try_pT(psat(T) * (1. - r.offset()), T);
+			}));
+	ret.push_back(sample("R2", "b23", Region::R2, n / 6, [&]()
+			{
+				double T = r.uniform(623.15, 863.15);
+				return H2O::try_pT(pB23(T) * (1. - r.offset()), T);
+			}));
+	ret.push_back(sample("R2", "b25", Region::R2, n / 6, [&]()
+			{
+				return H2O::try_pT(r.log_uniform(0.001, 100.),
+						1073.15 * (1. - r.offset()));
+			}));
+
+	ret.push_back(sample("R3", "uniform", Region::R3, n / 2, [&]()
+			{
+				return H2O::try_pT(r.uniform(p13, 100.),
+						r.uniform(623.15, 863.15));
+			}));
+	ret.push_back(sample("R3", "sat", Region::R3, n / 8, [&]()
+			{
+				double T = r.uniform(623.15, Tc);
+				return H2O::try_pT(psat(T) * (1. + r.sign() * r.offset()),
+						T);
+			}));
+	ret.push_back(sample("R3", "b23", Region::R3, n / 8, [&]()
+			{
+				double T = r.uniform(623.15, 863.15);
+				return H2O::try_pT(pB23(T) * (1. + r.offset()), T);
+			}));
+	ret.push_back(sample("R3", "b13", Region::R3, n / 8, [&]()
+			{
+				return H2O::try_pT(r.uniform(p13, 100.),
+						623.15 * (1. + r.offset()));
+			}));
+	ret.push_back(sample("R3", "crit", Region::R3, n / 8, [&]()
+			{
+				return H2O::try_pT(pc * (1. + r.sign() * r.offset()),
+						Tc * (1. + r.sign() * r.offset()));
+			}));
+
+	ret.push_back(sample("R4", "uniform", Region::R4, n / 2, [&]()
+			{
+				return H2O::try_Tx(r.uniform(273.16, Tc),
+						r.uniform(0., 1.));
+			}));
+	ret.push_back(sample("R4", "sat", Region::R4, n / 4, [&]()
+			{
+				double x = r.offset();
+				return H2O::try_Tx(r.uniform(273.16, Tc),
+						r.sign() < 0. ? x : 1. - x);
+			}));
+	ret.push_back(sample("R4", "crit", Region::R4, n / 4, [&]()
+			{
+				return H2O::try_Tx(Tc * (1. - r.offset()),
+						r.uniform(0., 1.));
+			}));
+
+	ret.push_back(sample("R5", "uniform", Region::R5, n / 2, [&]()
+			{
+				return H2O::try_pT(r.log_uniform(0.001, 50.),
+						r.uniform(1073.15, 2273.15));
+			}));
+	ret.push_back(sample("R5", "b25", Region::R5, n / 2, [&]()
+			{
+				return H2O::try_pT(r.log_uniform(0.001, 50.),
+						1073.15 * (1. + r.offset()));
+			}));
+
+	return ret;
+}
+
+static bool selected(const Options& opts, const char* name)
+{
+	return !opts.filter || std::strstr(name, opts.filter);
+}
+
+static void usage(const char* argv0)
+{
+	std::cerr << "Usage: " << argv0
+		<< " [-n count] [-t seconds] [-j threads] [-s seed] [-f text|csv]"
+		" [filter]\n"
+		<< "\n"
+		<< "  -n  number of state points per region (default: 1000000)\n"
+		<< "  -t  minimal time per speed measurement (default: 0.2 s)\n"
+		<< "  -j  number of threads for the comparison (default: the number"
+		" of CPUs)\n"
+		<< "  -s  random seed (default: 0)\n"
+		<< "  -f  output format (default: text)\n"
+		<< "  filter  validate only the paths whose names contain the"
+		" string\n";
+}
+
+int main(int argc, char* argv[])
+{
+	Options opts = { 0.2, false, 0, 1000000,
+		std::max(std::thread::hardware_concurrency(), 1U), 0 };
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* arg = argv[i];
+
+		if (arg[0] == '-' && i + 1 < argc)
+		{
+			const char* val = argv[++i];
+
+			if (!std::strcmp(arg, "-n"))
+				opts.count = std::strtoul(val, 0, 10);
+			else if (!std::strcmp(arg, "-t"))
+				opts.min_time = std::atof(val);
+			else if (!std::strcmp(arg, "-j"))
+				opts.threads = std::strtoul(val, 0, 10);
+			else if (!std::strcmp(arg, "-s"))
+				opts.seed = std::strtoul(val, 0, 10);
+			else if (!std::strcmp(arg, "-f") && !std::strcmp(val, "csv"))
+				opts.csv = true;
+			else if (!std::strcmp(arg, "-f") && !std::strcmp(val, "text"))
+				opts.csv = false;
+			else
+			{
+				usage(argv[0]);
+				return 1;
+			}
+		}
+		else if (arg[0] != '-' && !opts.filter)
+			opts.filter = arg;
+		else
+		{
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	// every workload needs at least a single point
+	if (opts.min_time <= 0. || opts.count < 8 || opts.threads == 0)
+	{
+		usage(argv[0]);
+		return 1;
+	}
+
+	std::vector<Workload> loads = workloads(opts);
+
+	if (opts.csv)
+		std::printf("path,region,workload,points,failed,mismatched,"
+				"max_rel_err,max_prop,max_p,max_T,rms_rel_err,ulp_p50,"
+				"ulp_p90,ulp_p99,ulp_max,roundtrip_max,roundtrip_rms,"
+				"ns_per_point\n");
+	else
+		std::printf("%-20s %-3s %-7s %8s %7s %7s %9s %-4s %9s %9s %9s %9s"
+				" %9s %9s\n", "path", "reg", "load", "points", "failed",
+				"region", "max err", "prop", "rms err", "ulp p50",
+				"ulp p99", "ulp max", "roundtrip", "ns/point");
+
+	const h2o::batch::isa_type isa0 = h2o::batch::isa();
+
+	for (size_t i = 0; i < COUNT(paths); ++i)
+	{
+		if (!selected(opts, paths[i].name)
+				|| (paths[i].available && !paths[i].available()))
+			continue;
+		for (size_t j = 0; j < loads.size(); ++j)
+			validate(opts, paths[i], loads[j]);
+
+		h2o::batch::set_isa(isa0);
+	}
+
+	return 0;
+}
@@ -0,0 +1,3865 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+#include "h2o_backward"
+#include "classifier.hxx"
+#include "if97.hxx"
+#include "instrumentation.hxx"
+
+using namespace h2o;
+using namespace h2o::backward;
+
+static const bool not_reached = false; // for assert()
+
+struct coefficient
+{
+	// I is fractional in T(p,s) for subregion 2a
+	double I, J;
+	double n;
+};
+
+#define COUNT(a) (sizeof(a) / sizeof(*(a)))
+
+// region 1: T(p,h), T(p,s) and p(h,s)
+
+static const coefficient T1_ph_coeffs[] =
+{
+	{ 0, 0, -0.23872489924521E3 },
+	{ 0, 1, 0.40421188637945E3 },
+	{ 0, 2, 0.11349746881718E3 },
+	{ 0, 6, -0.58457616048039E1 },
+	{ 0, 22, -0.1528548241314E-3 },
+	{ 0, 32, -0.10866707695377E-5 },
+	{ 1, 0, -0.13391744872602E2 },
+	{ 1, 1, 0.43211039183559E2 },
+	{ 1, 2, -0.54010067170506E2 },
+	{ 1, 3, 0.30535892203916E2 },
+	{ 1, 4, -0.65964749423638E1 },
+	{ 1, 10, 0.93965400878363E-2 },
+	{ 1, 32, 0.1157364750534E-6 },
+	{ 2, 10, -0.25858641282073E-4 },
+	{ 2, 32, -0.40644363084799E-8 },
+	{ 3, 10, 0.66456186191635E-7 },
+	{ 3, 32, 0.80670734103027E-10 },
+	{ 4, 32, -0.93477771213947E-12 },
+	{ 5, 32, 0.58265442020601E-14 },
+	{ 6, 32, -0.15020185953503E-16 }
+};
+
+static const coefficient T1_ps_coeffs[] =
+{
+	{ 0, 0, 0.17478268058307E3 },
+	{ 0, 1, 0.34806930892873E2 },
+	{ 0, 2, 0.65292584978455E1 },
+	{ 0, 3, 0.33039981775489 },
+	{ 0, 11, -0.19281382923196E-6 },
+	{ 0, 31, -0.24909197244573E-22 },
+	{ 1, 0, -0.26107636489332 },
+	{ 1, 1, 0.22592965981586 },
+	{ 1, 2, -0.64256463395226E-1 },
+	{ 1, 3, 0.78876289270526E-2 },
+	{ 1, 12, 0.35672110607366E-9 },
+	{ 1, 31, 0.17332496994895E-23 },
+	{ 2, 0, 0.56608900654837E-3 },
+	{ 2, 1, -0.32635483139717E-3 },
+	{ 2, 2, 0.44778286690632E-4 },
+	{ 2, 9, -0.51322156908507E-9 },
+	{ 2, 31, -0.42522657042207E-25 },
+	{ 3, 10, 0.26400441360689E-12 },
+	{ 3, 32, 0.78124600459723E-28 },
+	{ 4, 32, -0.30732199903668E-30 }
+};
+
+static const coefficient p1_hs_coeffs[] =
+{
+	{ 0, 0, -0.691997014660582 },
+	{ 0, 1, -0.18361254878756E2 },
+	{ 0, 2, -0.928332409297335E1 },
+	{ 0, 4, 0.659639569909906E2 },
+	{ 0, 5, -0.162060388912024E2 },
+	{ 0, 6, 0.450620017338667E3 },
+	{ 0, 8, 0.85468067822417E3 },
+	{ 0, 14, 0.607523214001162E4 },
+	{ 1, 0, 0.326487682621856E2 },
+	{ 1, 1, -0.269408844582931E2 },
+	{ 1, 4, -0.3199478483343E3 },
+	{ 1, 6, -0.92835430704332E3 },
+	{ 2, 0, 0.303634537455249E2 },
+	{ 2, 1, -0.650540422444146E2 },
+	{ 2, 10, -0.43099131651613E4 },
+	{ 3, 4, -0.747512324096068E3 },
+	{ 4, 1, 0.730000345529245E3 },
+	{ 4, 4, 0.114284032569021E4 },
+	{ 5, 0, -0.436407041874559E3 }
+};
+
+// region 2: T(p,h) and T(p,s) for subregions 2a, 2b and 2c,
+// and p(h,s)
+
+static const coefficient T2a_ph_coeffs[] =
+{
+	{ 0, 0, 0.10898952318288E4 },
+	{ 0, 1, 0.84951654495535E3 },
+	{ 0, 2, -0.10781748091826E3 },
+	{ 0, 3, 0.33153654801263E2 },
+	{ 0, 7, -0.74232016790248E1 },
+	{ 0, 20, 0.11765048724356E2 },
+	{ 1, 0, 0.1844574935579E1 },
+	{ 1, 1, -0.41792700549624E1 },
+	{ 1, 2, 0.62478196935812E1 },
+	{ 1, 3, -0.17344563108114E2 },
+	{ 1, 7, -0.20058176862096E3 },
+	{ 1, 9, 0.27196065473796E3 },
+	{ 1, 11, -0.45511318285818E3 },
+	{ 1, 18, 0.30919688604755E4 },
+	{ 1, 44, 0.25226640357872E6 },
+	{ 2, 0, -0.61707422868339E-2 },
+	{ 2, 2, -0.31078046629583 },
+	{ 2, 7, 0.11670873077107E2 },
+	{ 2, 36, 0.12812798404046E9 },
+	{ 2, 38, -0.98554909623276E9 },
+	{ 2, 40, 0.28224546973002E10 },
+	{ 2, 42, -0.35948971410703E10 },
+	{ 2, 44, 0.17227349913197E10 },
+	{ 3, 24, -0.13551334240775E5 },
+	{ 3, 44, 0.1284873466465E8 },
+	{ 4, 12, 0.13865724283226E1 },
+	{ 4, 32, 0.23598832556514E6 },
+	{ 4, 44, -0.13105236545054E8 },
+	{ 5, 32, 0.73999835474766E4 },
+	{ 5, 36, -0.5519669703006E6 },
+	{ 5, 42, 0.37154085996233E7 },
+	{ 6, 34, 0.1912772923966E5 },
+	{ 6, 44, -0.41535164835634E6 },
+	{ 7, 28, -0.62459855192507E2 }
+};
+
+static const coefficient T2b_ph_coeffs[] =
+{
+	{ 0, 0, 0.14895041079516E4 },
+	{ 0, 1, 0.74307798314034E3 },
+	{ 0, 2, -0.97708318797837E2 },
+	{ 0, 12, 0.24742464705674E1 },
+	{ 0, 18, -0.63281320016026 },
+	{ 0, 24, 0.11385952129658E1 },
+	{ 0, 28, -0.47811863648625 },
+	{ 0, 40, 0.85208123431544E-2 },
+	{ 1, 0, 0.93747147377932 },
+	{ 1, 2, 0.33593118604916E1 },
+	{ 1, 6, 0.33809355601454E1 },
+	{ 1, 12, 0.16844539671904 },
+	{ 1, 18, 0.73875745236695 },
+	{ 1, 24, -0.47128737436186 },
+	{ 1, 28, 0.15020273139707 },
+	{ 1, 40, -0.2176411421975E-2 },
+	{ 2, 2, -0.21810755324761E-1 },
+	{ 2, 8, -0.10829784403677 },
+	{ 2, 18, -0.46333324635812E-1 },
+	{ 2, 40, 0.71280351959551E-4 },
+	{ 3, 1, 0.11032831789999E-3 },
+	{ 3, 2, 0.18955248387902E-3 },
+	{ 3, 12, 0.30891541160537E-2 },
+	{ 3, 24, 0.13555504554949E-2 },
+	{ 4, 2, 0.28640237477456E-6 },
+	{ 4, 12, -0.10779857357512E-4 },
+	{ 4, 18, -0.76462712454814E-4 },
+	{ 4, 24, 0.14052392818316E-4 },
+	{ 4, 28, -0.31083814331434E-4 },
+	{ 4, 40, -0.10302738212103E-5 },
+	{ 5, 18, 0.2821728163504E-6 },
+	{ 5, 24, 0.12704902271945E-5 },
+	{ 5, 40, 0.73803353468292E-7 },
+	{ 6, 28, -0.11030139238909E-7 },
+	{ 7, 2, -0.81456365207833E-13 },
+	{ 7, 28, -0.25180545682962E-10 },
+	{ 9, 1, -0.17565233969407E-17 },
+	{ 9, 40, 0.86934156344163E-14 }
+};
+
+static const coefficient T2c_ph_coeffs[] =
+{
+	{ -7, 0, -0.32368398555242E13 },
+	{ -7, 4, 0.73263350902181E13 },
+	{ -6, 0, 0.35825089945447E12 },
+	{ -6, 2, -0.5834013185159E12 },
+	{ -5, 0, -0.1078306821747E11 },
+	{ -5, 2, 0.20825544563171E11 },
+	{ -2, 0, 0.61074783564516E6 },
+	{ -2, 1, 0.8597772253558E6 },
+	{ -1, 0, -0.2574572360417E5 },
+	{ -1, 2, 0.31081088422714E5 },
+	{ 0, 0, 0.12082315865936E4 },
+	{ 0, 1, 0.48219755109255E3 },
+	{ 1, 4, 0.37966001272486E1 },
+	{ 1, 8, -0.10842984880077E2 },
+	{ 2, 4, -0.4536417267666E-1 },
+	{ 6, 0, 0.14559115658698E-12 },
+	{ 6, 1, 0.1126159740723E-11 },
+	{ 6, 4, -0.17804982240686E-10 },
+	{ 6, 10, 0.12324579690832E-6 },
+	{ 6, 12, -0.11606921130984E-5 },
+	{ 6, 16, 0.27846367088554E-4 },
+	{ 6, 20, -0.59270038474176E-3 },
+	{ 6, 22, 0.12918582991878E-2 }
+};
+
+static const coefficient T2a_ps_coeffs[] =
+{
+	{ -1.5, -24, -0.39235983861984E6 },
+	{ -1.5, -23, 0.5152657382727E6 },
+	{ -1.5, -19, 0.40482443161048E5 },
+	{ -1.5, -13, -0.32193790923902E3 },
+	{ -1.5, -11, 0.96961424218694E2 },
+	{ -1.5, -10, -0.22867846371773E2 },
+	{ -1.25, -19, -0.44942914124357E6 },
+	{ -1.25, -15, -0.50118336020166E4 },
+	{ -1.25, -6, 0.35684463560015 },
+	{ -1, -26, 0.4423533584819E5 },
+	{ -1, -21, -0.13673388811708E5 },
+	{ -1, -17, 0.42163260207864E6 },
+	{ -1, -16, 0.22516925837475E5 },
+	{ -1, -9, 0.47442144865646E3 },
+	{ -1, -8, -0.14931130797647E3 },
+	{ -0.75, -15, -0.19781126320452E6 },
+	{ -0.75, -14, -0.2355439947076E5 },
+	{ -0.5, -26, -0.19070616302076E5 },
+	{ -0.5, -13, 0.55375669883164E5 },
+	{ -0.5, -9, 0.38293691437363E4 },
+	{ -0.5, -7, -0.60391860580567E3 },
+	{ -0.25, -27, 0.19363102620331E4 },
+	{ -0.25, -25, 0.4266064369861E4 },
+	{ -0.25, -11, -0.59780638872718E4 },
+	{ -0.25, -6, -0.70401463926862E3 },
+	{ 0.25, 1, 0.33836784107553E3 },
+	{ 0.25, 4, 0.20862786635187E2 },
+	{ 0.25, 8, 0.33834172656196E-1 },
+	{ 0.25, 11, -0.43124428414893E-4 },
+	{ 0.5, 0, 0.16653791356412E3 },
+	{ 0.5, 1, -0.13986292055898E3 },
+	{ 0.5, 5, -0.78849547999872 },
+	{ 0.5, 6, 0.72132411753872E-1 },
+	{ 0.5, 10, -0.59754839398283E-2 },
+	{ 0.5, 14, -0.12141358953904E-4 },
+	{ 0.5, 16, 0.23227096733871E-6 },
+	{ 0.75, 0, -0.10538463566194E2 },
+	{ 0.75, 4, 0.20718925496502E1 },
+	{ 0.75, 9, -0.72193155260427E-1 },
+	{ 0.75, 17, 0.2074988708112E-6 },
+	{ 1, 7, -0.18340657911379E-1 },
+	{ 1, 18, 0.29036272348696E-6 },
+	{ 1.25, 3, 0.21037527893619 },
+	{ 1.25, 15, 0.25681239729999E-3 },
+	{ 1.5, 5, -0.12799002933781E-1 },
+	{ 1.5, 18, -0.82198102652018E-5 }
+};
+
+static const coefficient T2b_ps_coeffs[] =
+{
+	{ -6, 0, 0.31687665083497E6 },
+	{ -6, 11, 0.20864175881858E2 },
+	{ -5, 0, -0.39859399803599E6 },
+	{ -5, 11, -0.21816058518877E2 },
+	{ -4, 0, 0.22369785194242E6 },
+	{ -4, 1, -0.27841703445817E4 },
+	{ -4, 11, 0.9920743607148E1 },
+	{ -3, 0, -0.75197512299157E5 },
+	{ -3, 1, 0.29708605951158E4 },
+	{ -3, 11, -0.34406878548526E1 },
+	{ -3, 12, 0.38815564249115 },
+	{ -2, 0, 0.1751129508575E5 },
+	{ -2, 1, -0.14237112854449E4 },
+	{ -2, 6, 0.10943803364167E1 },
+	{ -2, 10, 0.89971619308495 },
+	{ -1, 0, -0.33759740098958E4 },
+	{ -1, 1, 0.47162885818355E3 },
+	{ -1, 5, -0.19188241993679E1 },
+	{ -1, 8, 0.41078580492196 },
+	{ -1, 9, -0.33465378172097 },
+	{ 0, 0, 0.13870034777505E4 },
+	{ 0, 1, -0.40663326195838E3 },
+	{ 0, 2, 0.4172734715961E2 },
+	{ 0, 4, 0.21932549434532E1 },
+	{ 0, 5, -0.10320050009077E1 },
+	{ 0, 6, 0.35882943516703 },
+	{ 0, 9, 0.52511453726066E-2 },
+	{ 1, 0, 0.12838916450705E2 },
+	{ 1, 1, -0.28642437219381E1 },
+	{ 1, 2, 0.56912683664855 },
+	{ 1, 3, -0.99962954584931E-1 },
+	{ 1, 7, -0.32632037778459E-2 },
+	{ 1, 8, 0.23320922576723E-3 },
+	{ 2, 0, -0.1533480985745 },
+	{ 2, 1, 0.29072288239902E-1 },
+	{ 2, 5, 0.37534702741167E-3 },
+	{ 3, 0, 0.17296691702411E-2 },
+	{ 3, 1, -0.38556050844504E-3 },
+	{ 3, 3, -0.35017712292608E-4 },
+	{ 4, 0, -0.14566393631492E-4 },
+	{ 4, 1, 0.56420857267269E-5 },
+	{ 5, 0, 0.41286150074605E-7 },
+	{ 5, 1, -0.20684671118824E-7 },
+	{ 5, 2, 0.16409393674725E-8 }
+};
+
+static const coefficient T2c_ps_coeffs[] =
+{
+	{ -2, 0, 0.90968501005365E3 },
+	{ -2, 1, 0.2404566708842E4 },
+	{ -1, 0, -0.5916232638713E3 },
+	{ 0, 0, 0.54145404128074E3 },
+	{ 0, 1, -0.27098308411192E3 },
+	{ 0, 2, 0.97976525097926E3 },
+	{ 0, 3, -0.46966772959435E3 },
+	{ 1, 0, 0.14399274604723E2 },
+	{ 1, 1, -0.19104204230429E2 },
+	{ 1, 3, 0.53299167111971E1 },
+	{ 1, 4, -0.21252975375934E2 },
+	{ 2, 0, -0.3114733441376 },
+	{ 2, 1, 0.60334840894623 },
+	{ 2, 2, -0.42764839702509E-1 },
+	{ 3, 0, 0.58185597255259E-2 },
+	{ 3, 1, -0.14597008284753E-1 },
+	{ 3, 5, 0.56631175631027E-2 },
+	{ 4, 0, -0.76155864584577E-4 },
+	{ 4, 1, 0.22440342919332E-3 },
+	{ 4, 4, -0.12561095013413E-4 },
+	{ 5, 0, 0.63323132660934E-6 },
+	{ 5, 1, -0.20541989675375E-5 },
+	{ 5, 2, 0.36405370390082E-7 },
+	{ 6, 0, -0.29759897789215E-8 },
+	{ 6, 1, 0.10136618529763E-7 },
+	{ 7, 0, 0.59925719692351E-11 },
+	{ 7, 1, -0.20677870105164E-10 },
+	{ 7, 3, -0.20874278181886E-10 },
+	{ 7, 4, 0.10162166825089E-9 },
+	{ 7, 5, -0.16429828281347E-9 }
+};
+
+static const coefficient p2a_hs_coeffs[] =
+{
+	{ 0, 1, -0.182575361923032E-1 },
+	{ 0, 3, -0.125229548799536 },
+	{ 0, 6, 0.592290437320145 },
+	{ 0, 16, 0.604769706185122E1 },
+	{ 0, 20, 0.238624965444474E3 },
+	{ 0, 22, -0.298639090222922E3 },
+	{ 1, 0, 0.51225081304075E-1 },
+	{ 1, 1, -0.437266515606486 },
+	{ 1, 2, 0.413336902999504 },
+	{ 1, 3, -0.516468254574773E1 },
+	{ 1, 5, -0.557014838445711E1 },
+	{ 1, 6, 0.128555037824478E2 },
+	{ 1, 10, 0.11414410895329E2 },
+	{ 1, 16, -0.119504225652714E3 },
+	{ 1, 20, -0.28477798596156E4 },
+	{ 1, 22, 0.431757846408006E4 },
+	{ 2, 3, 0.11289404080265E1 },
+	{ 2, 16, 0.197409186206319E4 },
+	{ 2, 20, 0.151612444706087E4 },
+	{ 3, 0, 0.141324451421235E-1 },
+	{ 3, 2, 0.585501282219601 },
+	{ 3, 3, -0.297258075863012E1 },
+	{ 3, 6, 0.594567314847319E1 },
+	{ 3, 16, -0.623656565798905E4 },
+	{ 4, 16, 0.965986235133332E4 },
+	{ 5, 3, 0.681500934948134E1 },
+	{ 5, 16, -0.633207286824489E4 },
+	{ 6, 3, -0.55891922446576E1 },
+	{ 7, 1, 0.400645798472063E-1 }
+};
+
+static const coefficient p2b_hs_coeffs[] =
+{
+	{ 0, 0, 0.801496989929495E-1 },
+	{ 0, 1, -0.543862807146111 },
+	{ 0, 2, 0.337455597421283 },
+	{ 0, 4, 0.89055545115745E1 },
+	{ 0, 8, 0.313840736431485E3 },
+	{ 1, 0, 0.797367065977789 },
+	{ 1, 1, -0.12161697355624E1 },
+	{ 1, 2, 0.872803386937477E1 },
+	{ 1, 3, -0.169769781757602E2 },
+	{ 1, 5, -0.186552827328416E3 },
+	{ 1, 12, 0.951159274344237E5 },
+	{ 2, 1, -0.189168510120494E2 },
+	{ 2, 6, -0.43340703719484E4 },
+	{ 2, 18, 0.543212633012715E9 },
+	{ 3, 0, 0.144793408386013 },
+	{ 3, 1, 0.128024559637516E3 },
+	{ 3, 7, -0.672309534071268E5 },
+	{ 3, 12, 0.336972380095287E8 },
+	{ 4, 1, -0.58663419676272E3 },
+	{ 4, 16, -0.221403224769889E11 },
+	{ 5, 1, 0.171606668708389E4 },
+	{ 5, 12, -0.570817595806302E9 },
+	{ 6, 1, -0.312109693178482E4 },
+	{ 6, 8, -0.20784138463301E7 },
+	{ 6, 18, 0.305605946157786E13 },
+	{ 7, 1, 0.322157004314333E4 },
+	{ 7, 16, 0.326810259797295E12 },
+	{ 8, 1, -0.144104158934487E4 },
+	{ 8, 3, 0.410694867802691E3 },
+	{ 8, 14, 0.109077066873024E12 },
+	{ 8, 18, -0.247964654258893E14 },
+	{ 12, 10, 0.188801906865134E10 },
+	{ 14, 16, -0.123651009018773E15 }
+};
+
+static const coefficient p2c_hs_coeffs[] =
+{
+	{ 0, 0, 0.112225607199012 },
+	{ 0, 1, -0.339005953606712E1 },
+	{ 0, 2, -0.320503911730094E2 },
+	{ 0, 3, -0.1975973051049E3 },
+	{ 0, 4, -0.407693861553446E3 },
+	{ 0, 8, 0.132943775222331E5 },
+	{ 1, 0, 0.170846839774007E1 },
+	{ 1, 2, 0.373694198142245E2 },
+	{ 1, 5, 0.358144365815434E4 },
+	{ 1, 8, 0.423014446424664E6 },
+	{ 1, 14, -0.751071025760063E9 },
+	{ 2, 2, 0.523446127607898E2 },
+	{ 2, 3, -0.228351290812417E3 },
+	{ 2, 7, -0.960652417056937E6 },
+	{ 2, 10, -0.807059292526074E8 },
+	{ 2, 18, 0.162698017225669E13 },
+	{ 3, 0, 0.772465073604171 },
+	{ 3, 5, 0.463929973837746E5 },
+	{ 3, 8, -0.137317885134128E8 },
+	{ 3, 16, 0.170470392630512E13 },
+	{ 3, 18, -0.251104628187308E14 },
+	{ 4, 18, 0.31774883083552E14 },
+	{ 5, 1, 0.538685623675312E2 },
+	{ 5, 4, -0.553089094625169E5 },
+	{ 5, 6, -0.102861522421405E7 },
+	{ 5, 14, 0.204249418756234E13 },
+	{ 6, 8, 0.273918446626977E9 },
+	{ 6, 18, -0.263963146312685E16 },
+	{ 10, 7, -0.107890854108088E10 },
+	{ 12, 7, -0.296492620980124E11 },
+	{ 16, 10, -0.111754907323424E16 }
+};
+
+// region 3: T(p,h), v(p,h), T(p,s) and v(p,s) for subregions 3a
+// and 3b, and p(h,s)
+
+static const coefficient T3a_ph_coeffs[] =
+{
+	{ -12, 0, -0.133645667811215E-6 },
+	{ -12, 1, 0.455912656802978E-5 },
+	{ -12, 2, -0.146294640700979E-4 },
+	{ -12, 6, 0.63934131297008E-2 },
+	{ -12, 14, 0.372783927268847E3 },
+	{ -12, 16, -0.718654377460447E4 },
+	{ -12, 20, 0.5734947521034E6 },
+	{ -12, 22, -0.267569329111439E7 },
+	{ -10, 1, -0.334066283302614E-4 },
+	{ -10, 5, -0.245479214069597E-1 },
+	{ -10, 12, 0.478087847764996E2 },
+	{ -8, 0, 0.764664131818904E-5 },
+	{ -8, 2, 0.128350627676972E-2 },
+	{ -8, 4, 0.171219081377331E-1 },
+	{ -8, 10, -0.851007304583213E1 },
+	{ -5, 2, -0.136513461629781E-1 },
+	{ -3, 0, -0.384460997596657E-5 },
+	{ -2, 1, 0.337423807911655E-2 },
+	{ -2, 3, -0.551624873066791 },
+	{ -2, 4, 0.72920227710747 },
+	{ -1, 0, -0.992522757376041E-2 },
+	{ -1, 2, -0.119308831407288 },
+	{ 0, 0, 0.793929190615421 },
+	{ 0, 1, 0.454270731799386 },
+	{ 1, 1, 0.20999859125991 },
+	{ 3, 0, -0.642109823904738E-2 },
+	{ 3, 1, -0.23515586860454E-1 },
+	{ 4, 0, 0.252233108341612E-2 },
+	{ 4, 3, -0.764885133368119E-2 },
+	{ 10, 4, 0.136176427574291E-1 },
+	{ 12, 5, -0.133027883575669E-1 }
+};
+
+static const coefficient T3b_ph_coeffs[] =
+{
+	{ -12, 0, 0.32325457364492E-4 },
+	{ -12, 1, -0.127575556587181E-3 },
+	{ -10, 0, -0.475851877356068E-3 },
+	{ -10, 1, 0.156183014181602E-2 },
+	{ -10, 5, 0.105724860113781 },
+	{ -10, 10, -0.858514221132534E2 },
+	{ -10, 12, 0.724140095480911E3 },
+	{ -8, 0, 0.296475810273257E-2 },
+	{ -8, 1, -0.592721983365988E-2 },
+	{ -8, 2, -0.126305422818666E-1 },
+	{ -8, 4, -0.115716196364853 },
+	{ -8, 10, 0.849000969739595E2 },
+	{ -6, 0, -0.108602260086615E-1 },
+	{ -6, 1, 0.154304475328851E-1 },
+	{ -6, 2, 0.750455441524466E-1 },
+	{ -4, 0, 0.252520973612982E-1 },
+	{ -4, 1, -0.602507901232996E-1 },
+	{ -3, 5, -0.307622221350501E1 },
+	{ -2, 0, -0.574011959864879E-1 },
+	{ -2, 4, 0.503471360939849E1 },
+	{ -1, 2, -0.925081888584834 },
+	{ -1, 4, 0.391733882917546E1 },
+	{ -1, 6, -0.77314600713019E2 },
+	{ -1, 10, 0.949308762098587E4 },
+	{ -1, 14, -0.141043719679409E7 },
+	{ -1, 16, 0.849166230819026E7 },
+	{ 0, 0, 0.861095729446704 },
+	{ 0, 2, 0.32334644281172 },
+	{ 1, 1, 0.873281936020439 },
+	{ 3, 1, -0.436653048526683 },
+	{ 5, 1, 0.286596714529479 },
+	{ 6, 1, -0.131778331276228 },
+	{ 8, 1, 0.676682064330275E-2 }
+};
+
+static const coefficient v3a_ph_coeffs[] =
+{
+	{ -12, 6, 0.529944062966028E-2 },
+	{ -12, 8, -0.170099690234461 },
+	{ -12, 12, 0.111323814312927E2 },
+	{ -12, 18, -0.217898123145125E4 },
+	{ -10, 4, -0.506061827980875E-3 },
+	{ -10, 7, 0.556495239685324 },
+	{ -10, 10, -0.943672726094016E1 },
+	{ -8, 5, -0.297856807561527 },
+	{ -8, 12, 0.939353943717186E2 },
+	{ -6, 3, 0.192944939465981E-1 },
+	{ -6, 4, 0.421740664704763 },
+	{ -6, 22, -0.36891412628233E7 },
+	{ -4, 2, -0.737566847600639E-2 },
+	{ -4, 3, -0.354753242424366 },
+	{ -3, 7, -0.199768169338727E1 },
+	{ -2, 3, 0.115456297059049E1 },
+	{ -2, 16, 0.56836687581596E4 },
+	{ -1, 0, 0.808169540124668E-2 },
+	{ -1, 1, 0.172416341519307 },
+	{ -1, 2, 0.104270175292927E1 },
+	{ -1, 3, -0.297691372792847 },
+	{ 0, 0, 0.560394465163593 },
+	{ 0, 1, 0.275234661176914 },
+	{ 1, 0, -0.148347894866012 },
+	{ 1, 1, -0.651142513478515E-1 },
+	{ 1, 2, -0.292468715386302E1 },
+	{ 2, 0, 0.664876096952665E-1 },
+	{ 2, 2, 0.352335014263844E1 },
+	{ 3, 0, -0.146340792313332E-1 },
+	{ 4, 2, -0.224503486668184E1 },
+	{ 5, 2, 0.110533464706142E1 },
+	{ 8, 2, -0.408757344495612E-1 }
+};
+
+static const coefficient v3b_ph_coeffs[] =
+{
+	{ -12, 0, -0.225196934336318E-8 },
+	{ -12, 1, 0.140674363313486E-7 },
+	{ -8, 0, 0.23378408528056E-5 },
+	{ -8, 1, -0.331833715229001E-4 },
+	{ -8, 3, 0.107956778514318E-2 },
+	{ -8, 6, -0.271382067378863 },
+	{ -8, 7, 0.107202262490333E1 },
+	{ -8, 8, -0.853821329075382 },
+	{ -6, 0, -0.215214194340526E-4 },
+	{ -6, 1, 0.76965608822273E-3 },
+	{ -6, 2, -0.431136580433864E-2 },
+	{ -6, 5, 0.453342167309331 },
+	{ -6, 6, -0.507749535873652 },
+	{ -6, 10, -0.100475154528389E3 },
+	{ -4, 3, -0.219201924648793 },
+	{ -4, 6, -0.321087965668917E1 },
+	{ -4, 10, 0.607567815637771E3 },
+	{ -3, 0, 0.557686450685932E-3 },
+	{ -3, 2, 0.18749904002955 },
+	{ -2, 1, 0.905368030448107E-2 },
+	{ -2, 2, 0.285417173048685 },
+	{ -1, 0, 0.329924030996098E-1 },
+	{ -1, 1, 0.239897419685483 },
+	{ -1, 4, 0.482754995951394E1 },
+	{ -1, 5, -0.118035753702231E2 },
+	{ 0, 0, 0.169490044091791 },
+	{ 1, 0, -0.179967222507787E-1 },
+	{ 1, 1, 0.371810116332674E-1 },
+	{ 2, 2, -0.536288335065096E-1 },
+	{ 2, 6, 0.16069710109252E1 }
+};
+
+static const coefficient T3a_ps_coeffs[] =
+{
+	{ -12, 28, 0.150042008263875E10 },
+	{ -12, 32, -0.159397258480424E12 },
+	{ -10, 4, 0.502181140217975E-3 },
+	{ -10, 10, -0.672057767855466E2 },
+	{ -10, 12, 0.145058545404456E4 },
+	{ -10, 14, -0.82388953488889E4 },
+	{ -8, 5, -0.154852214233853 },
+	{ -8, 7, 0.112305046746695E2 },
+	{ -8, 8, -0.297000213482822E2 },
+	{ -8, 28, 0.438565132635495E11 },
+	{ -6, 2, 0.137837838635464E-2 },
+	{ -6, 6, -0.297478527157462E1 },
+	{ -6, 32, 0.971777947349413E13 },
+	{ -5, 0, -0.571527767052398E-4 },
+	{ -5, 14, 0.28830794977842E5 },
+	{ -5, 32, -0.744428289262703E14 },
+	{ -4, 6, 0.128017324848921E2 },
+	{ -4, 10, -0.368275545889071E3 },
+	{ -4, 36, 0.664768904779177E16 },
+	{ -2, 1, 0.44935925195888E-1 },
+	{ -2, 4, -0.422897836099655E1 },
+	{ -1, 1, -0.240614376434179 },
+	{ -1, 6, -0.474341365254924E1 },
+	{ 0, 0, 0.72409399912611 },
+	{ 0, 1, 0.923874349695897 },
+	{ 0, 4, 0.399043655281015E1 },
+	{ 1, 0, 0.384066651868009E-1 },
+	{ 2, 0, -0.359344365571848E-2 },
+	{ 2, 3, -0.735196448821653 },
+	{ 3, 2, 0.188367048396131 },
+	{ 8, 0, 0.141064266818704E-3 },
+	{ 8, 1, -0.257418501496337E-2 },
+	{ 10, 2, 0.123220024851555E-2 }
+};
+
+static const coefficient T3b_ps_coeffs[] =
+{
+	{ -12, 1, 0.52711170160166 },
+	{ -12, 3, -0.401317830052742E2 },
+	{ -12, 4, 0.153020073134484E3 },
+	{ -12, 7, -0.224799398218827E4 },
+	{ -8, 0, -0.193993484669048 },
+	{ -8, 1, -0.140467557893768E1 },
+	{ -8, 3, 0.426799878114024E2 },
+	{ -6, 0, 0.752810643416743 },
+	{ -6, 2, 0.226657238616417E2 },
+	{ -6, 4, -0.622873556909932E3 },
+	{ -5, 0, -0.660823667935396 },
+	{ -5, 1, 0.841267087271658 },
+	{ -5, 2, -0.253717501764397E2 },
+	{ -5, 4, 0.485708963532948E3 },
+	{ -5, 6, 0.880531517490555E3 },
+	{ -4, 12, 0.265015592794626E7 },
+	{ -3, 1, -0.359287150025783 },
+	{ -3, 6, -0.656991567673753E3 },
+	{ -2, 2, 0.241768149185367E1 },
+	{ 0, 0, 0.856873461222588 },
+	{ 2, 1, 0.655143675313458 },
+	{ 3, 1, -0.213535213206406 },
+	{ 4, 0, 0.562974957606348E-2 },
+	{ 5, 24, -0.316955725450471E15 },
+	{ 6, 0, -0.699997000152457E-3 },
+	{ 8, 3, 0.119845803210767E-1 },
+	{ 12, 1, 0.193848122022095E-4 },
+	{ 14, 2, -0.215095749182309E-4 }
+};
+
+static const coefficient v3a_ps_coeffs[] =
+{
+	{ -12, 10, 0.795544074093975E2 },
+	{ -12, 12, -0.23826124298459E4 },
+	{ -12, 14, 0.176813100617787E5 },
+	{ -10, 4, -0.110524727080379E-2 },
+	{ -10, 8, -0.153213833655326E2 },
+	{ -10, 10, 0.297544599376982E3 },
+	{ -10, 20, -0.350315206871242E8 },
+	{ -8, 5, 0.277513761062119 },
+	{ -8, 6, -0.523964271036888 },
+	{ -8, 14, -0.148011182995403E6 },
+	{ -8, 16, 0.160014899374266E7 },
+	{ -6, 28, 0.170802322663427E13 },
+	{ -5, 1, 0.246866996006494E-3 },
+	{ -4, 5, 0.16532608479798E1 },
+	{ -3, 2, -0.118008384666987 },
+	{ -3, 4, 0.2537986423559E1 },
+	{ -2, 3, 0.965127704669424 },
+	{ -2, 8, -0.282172420532826E2 },
+	{ -1, 1, 0.203224612353823 },
+	{ -1, 2, 0.110648186063513E1 },
+	{ 0, 0, 0.52612794845128 },
+	{ 0, 1, 0.277000018736321 },
+	{ 0, 3, 0.108153340501132E1 },
+	{ 1, 0, -0.744127885357893E-1 },
+	{ 2, 0, 0.164094443541384E-1 },
+	{ 4, 2, -0.680468275301065E-1 },
+	{ 5, 2, 0.25798857610164E-1 },
+	{ 6, 0, -0.145749861944416E-3 }
+};
+
+static const coefficient v3b_ps_coeffs[] =
+{
+	{ -12, 0, 0.591599780322238E-4 },
+	{ -12, 1, -0.185465997137856E-2 },
+	{ -12, 2, 0.104190510480013E-1 },
+	{ -12, 3, 0.59864730203859E-2 },
+	{ -12, 5, -0.771391189901699 },
+	{ -12, 6, 0.172549765557036E1 },
+	{ -10, 0, -0.467076079846526E-3 },
+	{ -10, 1, 0.134533823384439E-1 },
+	{ -10, 2, -0.808094336805495E-1 },
+	{ -10, 4, 0.508139374365767 },
+	{ -8, 0, 0.128584643361683E-2 },
+	{ -5, 1, -0.163899353915435E1 },
+	{ -5, 2, 0.586938199318063E1 },
+	{ -5, 3, -0.292466667918613E1 },
+	{ -4, 0, -0.614076301499537E-2 },
+	{ -4, 1, 0.576199014049172E1 },
+	{ -4, 2, -0.121613320606788E2 },
+	{ -4, 3, 0.167637540957944E1 },
+	{ -3, 1, -0.744135838773463E1 },
+	{ -2, 0, 0.378168091437659E-1 },
+	{ -2, 1, 0.401432203027688E1 },
+	{ -2, 2, 0.160279837479185E2 },
+	{ -2, 3, 0.317848779347728E1 },
+	{ -2, 4, -0.358362310304853E1 },
+	{ -2, 12, -0.115995260446827E7 },
+	{ 0, 0, 0.199256573577909 },
+	{ 0, 1, -0.122270624794624 },
+	{ 0, 2, -0.191449143716586E2 },
+	{ 1, 0, -0.150448002905284E-1 },
+	{ 1, 2, 0.146407900162154E2 },
+	{ 2, 2, -0.32747778718823E1 }
+};
+
+static const coefficient p3a_hs_coeffs[] =
+{
+	{ 0, 0, 0.770889828326934E1 },
+	{ 0, 1, -0.260835009128688E2 },
+	{ 0, 5, 0.267416218930389E3 },
+	{ 1, 0, 0.172221089496844E2 },
+	{ 1, 3, -0.29354233214597E3 },
+	{ 1, 4, 0.614135601882478E3 },
+	{ 1, 8, -0.610562757725674E5 },
+	{ 1, 14, -0.651272251118219E8 },
+	{ 2, 6, 0.735919313521937E5 },
+	{ 2, 16, -0.116646505914191E11 },
+	{ 3, 0, 0.355267086434461E2 },
+	{ 3, 2, -0.596144543825955E3 },
+	{ 3, 3, -0.475842430145708E3 },
+	{ 4, 0, 0.696781965359503E2 },
+	{ 4, 1, 0.335674250377312E3 },
+	{ 4, 4, 0.250526809130882E5 },
+	{ 4, 5, 0.146997380630766E6 },
+	{ 5, 28, 0.538069315091534E20 },
+	{ 6, 28, 0.143619827291346E22 },
+	{ 7, 24, 0.364985866165994E20 },
+	{ 8, 1, -0.254741561156775E4 },
+	{ 10, 32, 0.240120197096563E28 },
+	{ 10, 36, -0.393847464679496E30 },
+	{ 14, 22, 0.147073407024852E25 },
+	{ 18, 28, -0.426391250432059E32 },
+	{ 20, 36, 0.194509340621077E39 },
+	{ 22, 16, 0.666212132114896E24 },
+	{ 22, 28, 0.706777016552858E34 },
+	{ 24, 36, 0.175563621975576E42 },
+	{ 28, 16, 0.108408607429124E29 },
+	{ 28, 36, 0.730872705175151E44 },
+	{ 32, 10, 0.15914584739887E25 },
+	{ 32, 28, 0.377121605943324E41 }
+};
+
+static const coefficient p3b_hs_coeffs[] =
+{
+	{ -12, 2, 0.125244360717979E-12 },
+	{ -12, 10, -0.126599322553713E-1 },
+	{ -12, 12, 0.506878030140626E1 },
+	{ -12, 14, 0.317847171154202E2 },
+	{ -12, 20, -0.391041161399932E6 },
+	{ -10, 2, -0.975733406392044E-10 },
+	{ -10, 10, -0.186312419488279E2 },
+	{ -10, 14, 0.510973543414101E3 },
+	{ -10, 18, 0.373847005822362E6 },
+	{ -8, 2, 0.299804024666572E-7 },
+	{ -8, 8, 0.200544393820342E2 },
+	{ -6, 2, -0.498030487662829E-5 },
+	{ -6, 6, -0.10230180636003E2 },
+	{ -6, 7, 0.552819126990325E2 },
+	{ -6, 8, -0.206211367510878E3 },
+	{ -5, 10, -0.794012232324823E4 },
+	{ -4, 4, 0.782248472028153E1 },
+	{ -4, 5, -0.586544326902468E2 },
+	{ -4, 8, 0.355073647696481E4 },
+	{ -3, 1, -0.115303107290162E-3 },
+	{ -3, 3, -0.175092403171802E1 },
+	{ -3, 5, 0.25798168774816E3 },
+	{ -3, 6, -0.727048374179467E3 },
+	{ -2, 0, 0.121644822609198E-3 },
+	{ -2, 1, 0.393137871762692E-1 },
+	{ -1, 0, 0.704181005909296E-2 },
+	{ 0, 3, -0.82910820069811E2 },
+	{ 2, 0, -0.26517881813125 },
+	{ 2, 1, 0.137531682453991E2 },
+	{ 5, 0, -0.522394090753046E2 },
+	{ 6, 1, 0.240556298941048E4 },
+	{ 8, 1, -0.227361631268929E5 },
+	{ 10, 1, 0.890746343932567E5 },
+	{ 14, 3, -0.239234565822486E8 },
+	{ 14, 7, 0.568795808129714E10 }
+};
+
+// region boundaries in terms of (h,s): h'(s) for regions 1 and 3a,
+// h''(s) for regions 2ab and 2c3b, B13 and B23
+
+static const coefficient h1_s_coeffs[] =
+{
+	{ 0, 14, 0.332171191705237 },
+	{ 0, 36, 0.611217706323496E-3 },
+	{ 1, 3, -0.882092478906822E1 },
+	{ 1, 16, -0.45562819254325 },
+	{ 2, 0, -0.263483840850452E-4 },
+	{ 2, 5, -0.223949661148062E2 },
+	{ 3, 4, -0.428398660164013E1 },
+	{ 3, 36, -0.616679338856916 },
+	{ 4, 4, -0.14682303110404E2 },
+	{ 4, 16, 0.284523138727299E3 },
+	{ 4, 24, -0.113398503195444E3 },
+	{ 5, 18, 0.115671380760859E4 },
+	{ 5, 24, 0.395551267359325E3 },
+	{ 7, 1, -0.154891257229285E1 },
+	{ 8, 4, 0.194486637751291E2 },
+	{ 12, 2, -0.357915139457043E1 },
+	{ 12, 4, -0.335369414148819E1 },
+	{ 14, 1, -0.66442679633246 },
+	{ 14, 22, 0.323321885383934E5 },
+	{ 16, 10, 0.331766744667084E4 },
+	{ 20, 12, -0.223501257931087E5 },
+	{ 20, 28, 0.573953875852936E7 },
+	{ 22, 8, 0.173226193407919E3 },
+	{ 24, 3, -0.363968822121321E-1 },
+	{ 28, 0, 0.834596332878317E-6 },
+	{ 32, 6, 0.503611916682674E1 },
+	{ 32, 8, 0.655444787064505E2 }
+};
+
+static const coefficient h3a_s_coeffs[] =
+{
+	{ 0, 1, 0.822673364673336 },
+	{ 0, 4, 0.181977213534479 },
+	{ 0, 10, -0.112000260313624E-1 },
+	{ 0, 16, -0.746778287048033E-3 },
+	{ 2, 1, -0.179046263257381 },
+	{ 3, 36, 0.424220110836657E-1 },
+	{ 4, 3, -0.341355823438768 },
+	{ 4, 16, -0.209881740853565E1 },
+	{ 5, 20, -0.822477343323596E1 },
+	{ 5, 36, -0.499684082076008E1 },
+	{ 6, 4, 0.191413958471069 },
+	{ 7, 2, 0.581062241093136E-1 },
+	{ 7, 28, -0.165505498701029E4 },
+	{ 7, 32, 0.158870443421201E4 },
+	{ 10, 14, -0.850623535172818E2 },
+	{ 10, 32, -0.317714386511207E5 },
+	{ 10, 36, -0.945890406632871E5 },
+	{ 32, 0, -0.13927384708869E-5 },
+	{ 32, 6, 0.63105253224098 }
+};
+
+static const coefficient h2ab_s_coeffs[] =
+{
+	{ 1, 8, -0.524581170928788E3 },
+	{ 1, 24, -0.926947218142218E7 },
+	{ 2, 4, -0.237385107491666E3 },
+	{ 2, 32, 0.210770155812776E11 },
+	{ 4, 1, -0.239494562010986E2 },
+	{ 4, 2, 0.221802480294197E3 },
+	{ 7, 7, -0.510472533393438E7 },
+	{ 8, 5, 0.124981396109147E7 },
+	{ 8, 12, 0.200008436996201E10 },
+	{ 10, 1, -0.815158509791035E3 },
+	{ 12, 0, -0.157612685637523E3 },
+	{ 12, 7, -0.114200422332791E11 },
+	{ 18, 10, 0.662364680776872E16 },
+	{ 20, 12, -0.227622818296144E19 },
+	{ 24, 32, -0.171048081348406E32 },
+	{ 28, 8, 0.660788766938091E16 },
+	{ 28, 12, 0.166320055886021E23 },
+	{ 28, 20, -0.218003784381501E30 },
+	{ 28, 22, -0.787276140295618E30 },
+	{ 28, 24, 0.151062329700346E32 },
+	{ 32, 2, 0.795732170300541E7 },
+	{ 32, 7, 0.131957647355347E16 },
+	{ 32, 12, -0.32509706829914E24 },
+	{ 32, 14, -0.418600611419248E26 },
+	{ 32, 24, 0.297478906557467E35 },
+	{ 36, 10, -0.953588761745473E20 },
+	{ 36, 12, 0.166957699620939E25 },
+	{ 36, 20, -0.175407764869978E33 },
+	{ 36, 22, 0.347581490626396E35 },
+	{ 36, 28, -0.710971318427851E39 }
+};
+
+static const coefficient h2c3b_s_coeffs[] =
+{
+	{ 0, 0, 0.104351280732769E1 },
+	{ 0, 3, -0.227807912708513E1 },
+	{ 0, 4, 0.180535256723202E1 },
+	{ 1, 0, 0.420440834792042 },
+	{ 1, 12, -0.10572124483466E6 },
+	{ 5, 36, 0.436911607493884E25 },
+	{ 6, 12, -0.328032702839753E12 },
+	{ 7, 16, -0.67868676080427E16 },
+	{ 8, 2, 0.743957464645363E4 },
+	{ 8, 20, -0.356896445355761E20 },
+	{ 12, 32, 0.167590585186801E32 },
+	{ 16, 36, -0.355028625419105E38 },
+	{ 22, 2, 0.396611982166538E12 },
+	{ 22, 32, -0.414716268484468E41 },
+	{ 24, 7, 0.359080103867382E19 },
+	{ 36, 20, -0.116994334851995E41 }
+};
+
+static const coefficient hB13_s_coeffs[] =
+{
+	{ 0, 0, 0.913965547600543 },
+	{ 1, -2, -0.430944856041991E-4 },
+	{ 1, 2, 0.603235694765419E2 },
+	{ 3, -12, 0.117518273082168E-17 },
+	{ 5, -4, 0.220000904781292 },
+	{ 6, -3, -0.690815545851641E2 }
+};
+
+static const coefficient TB23_hs_coeffs[] =
+{
+	{ -12, 10, 0.62909626082981E-3 },
+	{ -10, 8, -0.823453502583165E-3 },
+	{ -8, 3, 0.515446951519474E-7 },
+	{ -4, 4, -0.117565945784945E1 },
+	{ -3, 3, 0.348519684726192E1 },
+	{ -2, -6, -0.507837382408313E-11 },
+	{ -2, 2, -0.284637670005479E1 },
+	{ -2, 3, -0.236092263939673E1 },
+	{ -2, 4, 0.601492324973779E1 },
+	{ 0, 0, 0.148039650824546E1 },
+	{ 1, -3, 0.360075182221907E-3 },
+	{ 1, -2, -0.126700045009952E-1 },
+	{ 1, 10, -0.122184332521413E7 },
+	{ 3, -2, 0.149276502463272 },
+	{ 3, -1, 0.698733471798484 },
+	{ 5, -5, -0.252207040114321E-1 },
+	{ 6, -6, 0.147151930985213E-1 },
+	{ 6, -3, -0.108618917681849E1 },
+	{ 8, -8, -0.936875039816322E-3 },
+	{ 8, -2, 0.819877897570217E2 },
+	{ 8, -1, -0.182041861521835E3 },
+	{ 12, -12, 0.261907376402688E-5 },
+	{ 12, -1, -0.291626417025961E5 },
+	{ 14, -12, 0.140660774926165E-4 },
+	{ 14, 1, 0.783237062349385E7 }
+};
+
+// region 4: Tsat(h,s)
+
+static const coefficient Tsat_hs_coeffs[] =
+{
+	{ 0, 0, 0.179882673606601 },
+	{ 0, 3, -0.267507455199603 },
+	{ 0, 12, 0.1162767226126E1 },
+	{ 1, 0, 0.147545428713616 },
+	{ 1, 1, -0.512871635973248 },
+	{ 1, 2, 0.421333567697984 },
+	{ 1, 5, 0.56374952218987 },
+	{ 2, 0, 0.429274443819153 },
+	{ 2, 5, -0.33570455214214E1 },
+	{ 2, 8, 0.108890916499278E2 },
+	{ 3, 0, -0.248483390456012 },
+	{ 3, 2, 0.30415322190639 },
+	{ 3, 3, -0.494819763939905 },
+	{ 3, 4, 0.107551674933261E1 },
+	{ 4, 0, 0.733888415457688E-1 },
+	{ 4, 1, 0.140170545411085E-1 },
+	{ 5, 1, -0.106110975998808 },
+	{ 5, 2, 0.168324361811875E-1 },
+	{ 5, 4, 0.125028363714877E1 },
+	{ 5, 16, 0.101316840309509E4 },
+	{ 6, 6, -0.151791558000712E1 },
+	{ 6, 8, 0.524277865990866E2 },
+	{ 6, 22, 0.230495545563912E5 },
+	{ 8, 1, 0.249459806365456E-1 },
+	{ 10, 20, 0.210796467412137E7 },
+	{ 10, 36, 0.366836848613065E9 },
+	{ 12, 24, -0.144814105365163E9 },
+	{ 14, 1, -0.17927637300359E-2 },
+	{ 14, 28, 0.489955602100459E10 },
+	{ 16, 12, 0.471262212070518E3 },
+	{ 16, 32, -0.829294390198652E11 },
+	{ 18, 14, -0.171545662263191E4 },
+	{ 18, 22, 0.355777682973575E7 },
+	{ 18, 36, 0.586062760258436E12 },
+	{ 20, 24, -0.129887635078195E8 },
+	{ 28, 36, 0.317247449371057E11 }
+};
+
+// region 3: v(p,T) for subregions 3a through 3z (SR5)
+
+static const coefficient v3a_pT_coeffs[] =
+{
+	{ -12, 5, 0.110879558823853E-2 },
+	{ -12, 10, 0.572616740810616E3 },
+	{ -12, 12, -0.767051948380852E5 },
+	{ -10, 5, -0.253321069529674E-1 },
+	{ -10, 10, 0.628008049345689E4 },
+	{ -10, 12, 0.234105654131876E6 },
+	{ -8, 5, 0.216867826045856 },
+	{ -8, 8, -0.156237904341963E3 },
+	{ -8, 10, -0.269893956176613E5 },
+	{ -6, 1, -0.180407100085505E-3 },
+	{ -5, 1, 0.116732227668261E-2 },
+	{ -5, 5, 0.26698704085604E2 },
+	{ -5, 10, 0.282776617243286E5 },
+	{ -4, 8, -0.242431520029523E4 },
+	{ -3, 0, 0.435217323022733E-3 },
+	{ -3, 1, -0.122494831387441E-1 },
+	{ -3, 3, 0.179357604019989E1 },
+	{ -3, 6, 0.442729521058314E2 },
+	{ -2, 0, -0.593223489018342E-2 },
+	{ -2, 2, 0.453186261685774 },
+	{ -2, 3, 0.13582570312914E1 },
+	{ -1, 0, 0.408748415856745E-1 },
+	{ -1, 1, 0.474686397863312 },
+	{ -1, 2, 0.118646814997915E1 },
+	{ 0, 0, 0.546987265727549 },
+	{ 0, 1, 0.195266770452643 },
+	{ 1, 0, -0.502268790869663E-1 },
+	{ 1, 2, -0.369645308193377 },
+	{ 2, 0, 0.63382803752842E-2 },
+	{ 2, 2, 0.797441793901017E-1 }
+};
+
+static const coefficient v3b_pT_coeffs[] =
+{
+	{ -12, 10, -0.827670470003621E-1 },
+	{ -12, 12, 0.416887126010565E2 },
+	{ -10, 8, 0.483651982197059E-1 },
+	{ -10, 14, -0.291032084950276E5 },
+	{ -8, 8, -0.111422582236948E3 },
+	{ -6, 5, -0.202300083904014E-1 },
+	{ -6, 6, 0.294002509338515E3 },
+	{ -6, 8, 0.140244997609658E3 },
+	{ -5, 5, -0.344384158811459E3 },
+	{ -5, 8, 0.361182452612149E3 },
+	{ -5, 10, -0.140699677420738E4 },
+	{ -4, 2, -0.202023902676481E-2 },
+	{ -4, 4, 0.171346792457471E3 },
+	{ -4, 5, -0.425597804058632E1 },
+	{ -3, 0, 0.691346085000334E-5 },
+	{ -3, 1, 0.151140509678925E-2 },
+	{ -3, 2, -0.416375290166236E-1 },
+	{ -3, 3, -0.413754957011042E2 },
+	{ -3, 5, -0.506673295721637E2 },
+	{ -2, 0, -0.572212965569023E-3 },
+	{ -2, 2, 0.608817368401785E1 },
+	{ -2, 5, 0.239600660256161E2 },
+	{ -1, 0, 0.122261479925384E-1 },
+	{ -1, 2, 0.216356057692938E1 },
+	{ 0, 0, 0.398198903368642 },
+	{ 0, 1, -0.116892827834085 },
+	{ 1, 0, -0.102845919373532 },
+	{ 1, 2, -0.492676637589284 },
+	{ 2, 0, 0.65554045640679E-1 },
+	{ 3, 2, -0.24046253507853 },
+	{ 4, 0, -0.269798180310075E-1 },
+	{ 4, 1, 0.128369435967012 }
+};
+
+static const coefficient v3c_pT_coeffs[] =
+{
+	{ -12, 6, 0.31196778876303E1 },
+	{ -12, 8, 0.276713458847564E5 },
+	{ -12, 10, 0.322583103403269E8 },
+	{ -10, 6, -0.342416065095363E3 },
+	{ -10, 8, -0.899732529907377E6 },
+	{ -10, 10, -0.793892049821251E8 },
+	{ -8, 5, 0.953193003217388E2 },
+	{ -8, 6, 0.229784742345072E4 },
+	{ -8, 7, 0.175336675322499E6 },
+	{ -6, 8, 0.791214365222792E7 },
+	{ -5, 1, 0.319933345844209E-4 },
+	{ -5, 4, -0.659508863555767E2 },
+	{ -5, 7, -0.833426563212851E6 },
+	{ -4, 2, 0.645734680583292E-1 },
+	{ -4, 8, -0.382031020570813E7 },
+	{ -3, 0, 0.406398848470079E-4 },
+	{ -3, 3, 0.310327498492008E2 },
+	{ -2, 0, -0.892996718483724E-3 },
+	{ -2, 4, 0.234604891591616E3 },
+	{ -2, 5, 0.377515668966951E4 },
+	{ -1, 0, 0.158646812591361E-1 },
+	{ -1, 1, 0.707906336241843 },
+	{ -1, 2, 0.12601622514657E2 },
+	{ 0, 0, 0.736143655772152 },
+	{ 0, 1, 0.676544268999101 },
+	{ 0, 2, -0.178100588189137E2 },
+	{ 1, 0, -0.156531975531713 },
+	{ 1, 2, 0.117707430048158E2 },
+	{ 2, 0, 0.840143653860447E-1 },
+	{ 2, 1, -0.186442467471949 },
+	{ 2, 3, -0.440170203949645E2 },
+	{ 2, 7, 0.123290423502494E7 },
+	{ 3, 0, -0.240650039730845E-1 },
+	{ 3, 7, -0.107077716660869E7 },
+	{ 8, 1, 0.438319858566475E-1 }
+};
+
+static const coefficient v3d_pT_coeffs[] =
+{
+	{ -12, 4, -0.452484847171645E-9 },
+	{ -12, 6, 0.315210389538801E-4 },
+	{ -12, 7, -0.214991352047545E-2 },
+	{ -12, 10, 0.508058874808345E3 },
+	{ -12, 12, -0.127123036845932E8 },
+	{ -12, 16, 0.115371133120497E13 },
+	{ -10, 0, -0.197805728776273E-15 },
+	{ -10, 2, 0.241554806033972E-10 },
+	{ -10, 4, -0.156481703640525E-5 },
+	{ -10, 6, 0.277211346836625E-2 },
+	{ -10, 8, -0.203578994462286E2 },
+	{ -10, 10, 0.144369489909053E7 },
+	{ -10, 14, -0.411254217946539E11 },
+	{ -8, 3, 0.623449786243773E-5 },
+	{ -8, 7, -0.221774281146038E2 },
+	{ -8, 8, -0.689315087933158E5 },
+	{ -8, 10, -0.195419525060713E8 },
+	{ -6, 6, 0.316373510564015E4 },
+	{ -6, 8, 0.224040754426988E7 },
+	{ -5, 1, -0.436701347922356E-5 },
+	{ -5, 2, -0.404213852833996E-3 },
+	{ -5, 5, -0.348153203414663E3 },
+	{ -5, 7, -0.385294213555289E6 },
+	{ -4, 0, 0.135203700099403E-6 },
+	{ -4, 1, 0.134648383271089E-3 },
+	{ -4, 7, 0.125031835351736E6 },
+	{ -3, 2, 0.968123678455841E-1 },
+	{ -3, 4, 0.225660517512438E3 },
+	{ -2, 0, -0.190102435341872E-3 },
+	{ -2, 1, -0.299628410819229E-1 },
+	{ -1, 0, 0.500833915372121E-2 },
+	{ -1, 1, 0.387842482998411 },
+	{ -1, 5, -0.138535367777182E4 },
+	{ 0, 0, 0.870745245971773 },
+	{ 0, 2, 0.171946252068742E1 },
+	{ 1, 0, -0.326650121426383E-1 },
+	{ 1, 6, 0.498044171727877E4 },
+	{ 3, 0, 0.551478022765087E-2 }
+};
+
+static const coefficient v3e_pT_coeffs[] =
+{
+	{ -12, 14, 0.715815808404721E9 },
+	{ -12, 16, -0.114328360753449E12 },
+	{ -10, 3, 0.37653100201572E-11 },
+	{ -10, 6, -0.903983668691157E-4 },
+	{ -10, 10, 0.665695908836252E6 },
+	{ -10, 14, 0.535364174960127E10 },
+	{ -10, 16, 0.794977402335603E11 },
+	{ -8, 7, 0.922230563421437E2 },
+	{ -8, 8, -0.142586073991215E6 },
+	{ -8, 10, -0.111796381424162E7 },
+	{ -6, 6, 0.89612162964076E4 },
+	{ -5, 6, -0.669989239070491E4 },
+	{ -4, 2, 0.451242538486834E-2 },
+	{ -4, 4, -0.339731325977713E2 },
+	{ -3, 2, -0.120523111552278E1 },
+	{ -3, 6, 0.475992667717124E5 },
+	{ -3, 7, -0.266627750390341E6 },
+	{ -2, 0, -0.153314954386524E-3 },
+	{ -2, 1, 0.305638404828265 },
+	{ -2, 3, 0.123654999499486E3 },
+	{ -2, 4, -0.104390794213011E4 },
+	{ -1, 0, -0.157496516174308E-1 },
+	{ 0, 0, 0.685331118940253 },
+	{ 0, 1, 0.178373462873903E1 },
+	{ 1, 0, -0.54467412487891 },
+	{ 1, 4, 0.204529931318843E4 },
+	{ 1, 6, -0.228342359328752E5 },
+	{ 2, 0, 0.413197481515899 },
+	{ 2, 2, -0.341931835910405E2 }
+};
+
+static const coefficient v3f_pT_coeffs[] =
+{
+	{ 0, -3, -0.251756547792325E-7 },
+	{ 0, -2, 0.601307193668763E-5 },
+	{ 0, -1, -0.100615977450049E-2 },
+	{ 0, 0, 0.999969140252192 },
+	{ 0, 1, 0.214107759236486E1 },
+	{ 0, 2, -0.165175571959086E2 },
+	{ 1, -1, -0.141987303638727E-2 },
+	{ 1, 1, 0.269251915156554E1 },
+	{ 1, 2, 0.349741815858722E2 },
+	{ 1, 3, -0.300208695771783E2 },
+	{ 2, 0, -0.131546288252539E1 },
+	{ 2, 1, -0.839091277286169E1 },
+	{ 3, -5, 0.181545608337015E-9 },
+	{ 3, -2, -0.591099206478909E-3 },
+	{ 3, 0, 0.152115067087106E1 },
+	{ 4, -3, 0.252956470663225E-4 },
+	{ 5, -8, 0.100726265203786E-14 },
+	{ 5, 1, -0.14977453386065E1 },
+	{ 6, -6, -0.793940970562969E-9 },
+	{ 7, -4, -0.150290891264717E-3 },
+	{ 7, 1, 0.151205531275133E1 },
+	{ 10, -6, 0.470942606221652E-5 },
+	{ 12, -10, 0.195049710391712E-12 },
+	{ 12, -8, -0.911627886266077E-8 },
+	{ 12, -4, 0.604374640201265E-3 },
+	{ 14, -12, -0.225132933900136E-15 },
+	{ 14, -10, 0.610916973582981E-11 },
+	{ 14, -8, -0.303063908043404E-6 },
+	{ 14, -6, -0.137796070798409E-4 },
+	{ 14, -4, -0.919296736666106E-3 },
+	{ 16, -10, 0.639288223132545E-9 },
+	{ 16, -8, 0.753259479898699E-6 },
+	{ 18, -12, -0.400321478682929E-12 },
+	{ 18, -10, 0.756140294351614E-8 },
+	{ 20, -12, -0.912082054034891E-11 },
+	{ 20, -10, -0.237612381140539E-7 },
+	{ 20, -6, 0.269586010591874E-4 },
+	{ 22, -12, -0.732828135157839E-10 },
+	{ 24, -12, 0.24199557830666E-9 },
+	{ 24, -4, -0.405735532730322E-3 },
+	{ 28, -12, 0.189424143498011E-9 },
+	{ 32, -12, -0.486632965074563E-9 }
+};
+
+static const coefficient v3g_pT_coeffs[] =
+{
+	{ -12, 7, 0.412209020652996E-4 },
+	{ -12, 12, -0.114987238280587E7 },
+	{ -12, 14, 0.94818088503208E10 },
+	{ -12, 18, -0.195788865718971E18 },
+	{ -12, 22, 0.4962507048713E25 },
+	{ -12, 24, -0.105549884548496E29 },
+	{ -10, 14, -0.758642165988278E12 },
+	{ -10, 20, -0.922172769596101E23 },
+	{ -10, 24, 0.725379072059348E30 },
+	{ -8, 7, -0.617718249205859E2 },
+	{ -8, 8, 0.107555033344858E5 },
+	{ -8, 10, -0.379545802336487E8 },
+	{ -8, 12, 0.228646846221831E12 },
+	{ -6, 8, -0.499741093010619E7 },
+	{ -6, 22, -0.280214310054101E31 },
+	{ -5, 7, 0.104915406769586E7 },
+	{ -5, 20, 0.613754229168619E28 },
+	{ -4, 22, 0.802056715528378E32 },
+	{ -3, 7, -0.298617819828065E8 },
+	{ -2, 3, -0.910782540134681E2 },
+	{ -2, 5, 0.135033227281565E6 },
+	{ -2, 14, -0.712949383408211E19 },
+	{ -2, 24, -0.104578785289542E37 },
+	{ -1, 2, 0.304331584444093E2 },
+	{ -1, 8, 0.593250797959445E10 },
+	{ -1, 18, -0.364174062110798E28 },
+	{ 0, 0, 0.921791403532461 },
+	{ 0, 1, -0.337693609657471 },
+	{ 0, 2, -0.724644143758508E2 },
+	{ 1, 0, -0.110480239272601 },
+	{ 1, 1, 0.536516031875059E1 },
+	{ 1, 3, -0.291441872156205E4 },
+	{ 3, 24, 0.616338176535305E40 },
+	{ 5, 22, -0.12088917586118E39 },
+	{ 6, 12, 0.818396024524612E23 },
+	{ 8, 3, 0.940781944835829E9 },
+	{ 10, 0, -0.367279669545448E5 },
+	{ 10, 6, -0.837513931798655E16 }
+};
+
+static const coefficient v3h_pT_coeffs[] =
+{
+	{ -12, 8, 0.561379678887577E-1 },
+	{ -12, 12, 0.774135421587083E10 },
+	{ -10, 4, 0.111482975877938E-8 },
+	{ -10, 6, -0.143987128208183E-2 },
+	{ -10, 8, 0.19369655876492E4 },
+	{ -10, 10, -0.605971823585005E9 },
+	{ -10, 14, 0.171951568124337E14 },
+	{ -10, 16, -0.185461154985145E17 },
+	{ -8, 0, 0.38785116807801E-16 },
+	{ -8, 1, -0.395464327846105E-13 },
+	{ -8, 6, -0.170875935679023E3 },
+	{ -8, 7, -0.21201062070122E4 },
+	{ -8, 8, 0.177683337348191E8 },
+	{ -6, 4, 0.110177443629575E2 },
+	{ -6, 6, -0.234396091693313E6 },
+	{ -6, 8, -0.656174421999594E7 },
+	{ -5, 2, 0.156362212977396E-4 },
+	{ -5, 3, -0.2129462570214E1 },
+	{ -5, 4, 0.135249306374858E2 },
+	{ -4, 2, 0.177189164145813 },
+	{ -4, 4, 0.139499167345464E4 },
+	{ -3, 1, -0.703670932036388E-2 },
+	{ -3, 2, -0.152011044389648 },
+	{ -2, 0, 0.981916922991113E-4 },
+	{ -1, 0, 0.147199658618076E-2 },
+	{ -1, 2, 0.202618487025578E2 },
+	{ 0, 0, 0.89934551894424 },
+	{ 1, 0, -0.211346402240858 },
+	{ 1, 2, 0.249971752957491E2 }
+};
+
+static const coefficient v3i_pT_coeffs[] =
+{
+	{ 0, 0, 0.106905684359136E1 },
+	{ 0, 1, -0.148620857922333E1 },
+	{ 0, 10, 0.259862256980408E15 },
+	{ 1, -4, -0.446352055678749E-11 },
+	{ 1, -2, -0.566620757170032E-6 },
+	{ 1, -1, -0.235302885736849E-2 },
+	{ 1, 0, -0.269226321968839 },
+	{ 2, 0, 0.922024992944392E1 },
+	{ 3, -5, 0.357633505503772E-11 },
+	{ 3, 0, -0.173942565562222E2 },
+	{ 4, -3, 0.700681785556229E-5 },
+	{ 4, -2, -0.267050351075768E-3 },
+	{ 4, -1, -0.231779669675624E1 },
+	{ 5, -6, -0.753533046979752E-12 },
+	{ 5, -1, 0.481337131452891E1 },
+	{ 5, 12, -0.223286270422356E22 },
+	{ 7, -4, -0.118746004987383E-4 },
+	{ 7, -3, 0.646412934136496E-2 },
+	{ 8, -6, -0.410588536330937E-9 },
+	{ 8, 10, 0.422739537057241E20 },
+	{ 10, -8, 0.313698180473812E-12 },
+	{ 12, -12, 0.16439533434504E-23 },
+	{ 12, -6, -0.339823323754373E-5 },
+	{ 12, -4, -0.135268639905021E-1 },
+	{ 14, -10, -0.723252514211625E-14 },
+	{ 14, -8, 0.184386437538366E-8 },
+	{ 14, -4, -0.463959533752385E-1 },
+	{ 14, 5, -0.99226310037675E14 },
+	{ 18, -12, 0.688169154439335E-16 },
+	{ 18, -10, -0.222620998452197E-10 },
+	{ 18, -8, -0.540843018624083E-7 },
+	{ 18, -6, 0.345570606200257E-2 },
+	{ 18, 2, 0.422275800304086E11 },
+	{ 20, -12, -0.126974478770487E-14 },
+	{ 20, -10, 0.927237985153679E-9 },
+	{ 22, -12, 0.612670812016489E-13 },
+	{ 24, -12, -0.722693924063497E-11 },
+	{ 24, -8, -0.383669502636822E-3 },
+	{ 32, -10, 0.374684572410204E-3 },
+	{ 32, -5, -0.931976897511086E5 },
+	{ 36, -10, -0.247690616026922E-1 },
+	{ 36, -8, 0.658110546759474E2 }
+};
+
+static const coefficient v3j_pT_coeffs[] =
+{
+	{ 0, -1, -0.11137131739554E-3 },
+	{ 0, 0, 0.100342892423685E1 },
+	{ 0, 1, 0.530615581928979E1 },
+	{ 1, -2, 0.179058760078792E-5 },
+	{ 1, -1, -0.728541958464774E-3 },
+	{ 1, 1, -0.187576133371704E2 },
+	{ 2, -1, 0.199060874071849E-2 },
+	{ 2, 1, 0.24357475537729E2 },
+	{ 3, -2, -0.177040785499444E-3 },
+	{ 4, -2, -0.25968038522713E-2 },
+	{ 4, 2, -0.198704578406823E3 },
+	{ 5, -3, 0.738627790224287E-4 },
+	{ 5, -2, -0.236264692844138E-2 },
+	{ 5, 0, -0.161023121314333E1 },
+	{ 6, 3, 0.622322971786473E4 },
+	{ 10, -6, -0.960754116701669E-8 },
+	{ 12, -8, -0.510572269720488E-10 },
+	{ 12, -3, 0.767373781404211E-2 },
+	{ 14, -10, 0.663855469485254E-14 },
+	{ 14, -8, -0.717590735526745E-9 },
+	{ 14, -5, 0.146564542926508E-4 },
+	{ 16, -10, 0.309029474277013E-11 },
+	{ 18, -12, -0.464216300971708E-15 },
+	{ 20, -12, -0.390499637961161E-13 },
+	{ 20, -10, -0.236716126781431E-9 },
+	{ 24, -12, 0.454652854268717E-11 },
+	{ 24, -6, -0.422271787482497E-2 },
+	{ 28, -12, 0.283911742354706E-10 },
+	{ 28, -5, 0.270929002720228E1 }
+};
+
+static const coefficient v3k_pT_coeffs[] =
+{
+	{ -2, 10, -0.401215699576099E9 },
+	{ -2, 12, 0.484501478318406E11 },
+	{ -1, -5, 0.394721471363678E-14 },
+	{ -1, 6, 0.372629967374147E5 },
+	{ 0, -12, -0.369794374168666E-29 },
+	{ 0, -6, -0.380436407012452E-14 },
+	{ 0, -2, 0.475361629970233E-6 },
+	{ 0, -1, -0.879148916140706E-3 },
+	{ 0, 0, 0.844317863844331 },
+	{ 0, 1, 0.1224331626566E2 },
+	{ 0, 2, -0.104529634830279E3 },
+	{ 0, 3, 0.589702771277429E3 },
+	{ 0, 14, -0.291026851164444E14 },
+	{ 1, -3, 0.17034307284185E-5 },
+	{ 1, -2, -0.277617606975748E-3 },
+	{ 1, 0, -0.344709605486686E1 },
+	{ 1, 1, 0.221333862447095E2 },
+	{ 1, 2, -0.194646110037079E3 },
+	{ 2, -8, 0.808354639772825E-15 },
+	{ 2, -6, -0.18084520914547E-10 },
+	{ 2, -3, -0.696664158132412E-5 },
+	{ 2, -2, -0.181057560300994E-2 },
+	{ 2, 0, 0.255830298579027E1 },
+	{ 2, 4, 0.328913873658481E4 },
+	{ 5, -12, -0.173270241249904E-18 },
+	{ 5, -6, -0.661876792558034E-6 },
+	{ 5, -3, -0.39568892342125E-2 },
+	{ 6, -12, 0.604203299819132E-17 },
+	{ 6, -10, -0.400879935920517E-13 },
+	{ 6, -8, 0.160751107464958E-8 },
+	{ 6, -5, 0.383719409025556E-4 },
+	{ 8, -12, -0.649565446702457E-14 },
+	{ 10, -12, -0.149095328506E-11 },
+	{ 12, -10, 0.541449377329581E-8 }
+};
+
+static const coefficient v3l_pT_coeffs[] =
+{
+	{ -12, 14, 0.260702058647537E10 },
+	{ -12, 16, -0.188277213604704E15 },
+	{ -12, 18, 0.554923870289667E19 },
+	{ -12, 20, -0.758966946387758E23 },
+	{ -12, 22, 0.413865186848908E27 },
+	{ -10, 14, -0.81503800073806E12 },
+	{ -10, 24, -0.381458260489955E33 },
+	{ -8, 6, -0.123239564600519E-1 },
+	{ -8, 10, 0.226095631437174E8 },
+	{ -8, 12, -0.49501780950672E12 },
+	{ -8, 14, 0.529482996422863E16 },
+	{ -8, 18, -0.444359478746295E23 },
+	{ -8, 24, 0.521635864527315E35 },
+	{ -8, 36, -0.487095672740742E55 },
+	{ -6, 8, -0.714430209937547E6 },
+	{ -5, 4, 0.127868634615495 },
+	{ -5, 5, -0.100752127917598E2 },
+	{ -4, 7, 0.77745143796099E7 },
+	{ -4, 16, -0.108105480796471E25 },
+	{ -3, 1, -0.357578581169659E-5 },
+	{ -3, 3, -0.212857169423484E1 },
+	{ -3, 18, 0.270706111085238E30 },
+	{ -3, 20, -0.695953622348829E33 },
+	{ -2, 2, 0.11060902747228 },
+	{ -2, 3, 0.721559163361354E2 },
+	{ -2, 10, -0.306367307532219E15 },
+	{ -1, 0, 0.26583961888553E-4 },
+	{ -1, 1, 0.253392392889754E-1 },
+	{ -1, 3, -0.214443041836579E3 },
+	{ 0, 0, 0.937846601489667 },
+	{ 0, 1, 0.2231840431017E1 },
+	{ 0, 2, 0.338401222509191E2 },
+	{ 0, 12, 0.494237237179718E21 },
+	{ 1, 0, -0.198068404154428 },
+	{ 1, 16, -0.14141534988114E31 },
+	{ 2, 1, -0.993862421613651E2 },
+	{ 4, 0, 0.125070534142731E3 },
+	{ 5, 0, -0.996473529004439E3 },
+	{ 5, 1, 0.473137909872765E5 },
+	{ 6, 14, 0.116662121219322E33 },
+	{ 10, 4, -0.315874976271533E16 },
+	{ 10, 12, -0.445703369196945E33 },
+	{ 14, 10, 0.642794932373694E33 }
+};
+
+static const coefficient v3m_pT_coeffs[] =
+{
+	{ 0, 0, 0.811384363481847 },
+	{ 3, 0, -0.568199310990094E4 },
+	{ 8, 0, -0.178657198172556E11 },
+	{ 20, 2, 0.795537657613427E32 },
+	{ 1, 5, -0.814568209346872E5 },
+	{ 3, 5, -0.659774567602874E8 },
+	{ 4, 5, -0.152861148659302E11 },
+	{ 5, 5, -0.560165667510446E12 },
+	{ 1, 6, 0.458384828593949E6 },
+	{ 6, 6, -0.385754000383848E14 },
+	{ 2, 7, 0.453735800004273E8 },
+	{ 4, 8, 0.939454935735563E12 },
+	{ 14, 8, 0.266572856432938E28 },
+	{ 2, 10, -0.547578313899097E10 },
+	{ 5, 10, 0.200725701112386E15 },
+	{ 3, 12, 0.185007245563239E13 },
+	{ 0, 14, 0.185135446828337E9 },
+	{ 1, 14, -0.170451090076385E12 },
+	{ 1, 18, 0.157890366037614E15 },
+	{ 1, 20, -0.202530509748774E16 },
+	{ 28, 20, 0.36819392618357E60 },
+	{ 2, 22, 0.170215539458936E18 },
+	{ 16, 22, 0.639234909918741E42 },
+	{ 0, 24, -0.821698160721956E15 },
+	{ 5, 24, -0.795260241872306E24 },
+	{ 0, 28, 0.23341586947851E18 },
+	{ 3, 28, -0.600079934586803E23 },
+	{ 4, 28, 0.594584382273384E25 },
+	{ 12, 28, 0.189461279349492E40 },
+	{ 16, 28, -0.810093428842645E46 },
+	{ 1, 32, 0.188813911076809E22 },
+	{ 8, 32, 0.111052244098768E36 },
+	{ 14, 32, 0.291133958602503E46 },
+	{ 0, 36, -0.32942192395146E22 },
+	{ 2, 36, -0.137570282536696E26 },
+	{ 3, 36, 0.181508996303902E28 },
+	{ 4, 36, -0.346865122768353E30 },
+	{ 8, 36, -0.21196114877426E38 },
+	{ 14, 36, -0.128617899887675E49 },
+	{ 24, 36, 0.479817895699239E65 }
+};
+
+static const coefficient v3n_pT_coeffs[] =
+{
+	{ 0, -12, 0.280967799943151E-38 },
+	{ 3, -12, 0.614869006573609E-30 },
+	{ 4, -12, 0.582238667048942E-27 },
+	{ 6, -12, 0.390628369238462E-22 },
+	{ 7, -12, 0.821445758255119E-20 },
+	{ 10, -12, 0.402137961842776E-14 },
+	{ 12, -12, 0.651718171878301E-12 },
+	{ 14, -12, -0.211773355803058E-7 },
+	{ 18, -12, 0.264953354380072E-2 },
+	{ 0, -10, -0.135031446451331E-31 },
+	{ 3, -10, -0.607246643970893E-23 },
+	{ 5, -10, -0.402352115234494E-18 },
+	{ 6, -10, -0.744938506925544E-16 },
+	{ 8, -10, 0.189917206526237E-12 },
+	{ 12, -10, 0.364975183508473E-5 },
+	{ 0, -8, 0.177274872361946E-25 },
+	{ 3, -8, -0.334952758812999E-18 },
+	{ 7, -8, -0.421537726098389E-8 },
+	{ 12, -8, -0.391048167929649E-1 },
+	{ 2, -6, 0.541276911564176E-13 },
+	{ 3, -6, 0.705412100773699E-11 },
+	{ 4, -6, 0.258585887897486E-8 },
+	{ 2, -5, -0.493111362030162E-10 },
+	{ 4, -5, -0.158649699894543E-5 },
+	{ 7, -5, -0.5250374278861 },
+	{ 4, -4, 0.220019901729615E-2 },
+	{ 3, -3, -0.643064132636925E-2 },
+	{ 5, -3, 0.629154149015048E2 },
+	{ 6, -3, 0.135147318617061E3 },
+	{ 0, -2, 0.240560808321713E-6 },
+	{ 0, -1, -0.890763306701305E-3 },
+	{ 3, -1, -0.440209599407714E4 },
+	{ 1, 0, -0.302807107747776E3 },
+	{ 0, 1, 0.159158748314599E4 },
+	{ 1, 1, 0.232534272709876E6 },
+	{ 0, 2, -0.7926812071326E6 },
+	{ 1, 4, -0.869871364662769E11 },
+	{ 0, 5, 0.354542769185671E12 },
+	{ 1, 6, 0.400849240129329E15 }
+};
+
+static const coefficient v3o_pT_coeffs[] =
+{
+	{ 0, -12, 0.128746023979718E-34 },
+	{ 0, -4, -0.735234770382342E-11 },
+	{ 0, -1, 0.28907869214915E-2 },
+	{ 2, -1, 0.244482731907223 },
+	{ 3, -10, 0.141733492030985E-23 },
+	{ 4, -12, -0.354533853059476E-28 },
+	{ 4, -8, -0.594539202901431E-17 },
+	{ 4, -5, -0.585188401782779E-8 },
+	{ 4, -4, 0.201377325411803E-5 },
+	{ 4, -1, 0.138647388209306E1 },
+	{ 5, -4, -0.173959365084772E-4 },
+	{ 5, -3, 0.137680878349369E-2 },
+	{ 6, -8, 0.814897605805513E-14 },
+	{ 7, -12, 0.425596631351839E-25 },
+	{ 8, -10, -0.387449113787755E-17 },
+	{ 8, -8, 0.13981474793024E-12 },
+	{ 8, -4, -0.171849638951521E-2 },
+	{ 10, -12, 0.641890529513296E-21 },
+	{ 10, -8, 0.118960578072018E-10 },
+	{ 14, -12, -0.155282762571611E-17 },
+	{ 14, -8, 0.233907907347507E-7 },
+	{ 20, -12, -0.174093247766213E-12 },
+	{ 20, -10, 0.377682649089149E-8 },
+	{ 24, -12, -0.516720236575302E-10 }
+};
+
+static const coefficient v3p_pT_coeffs[] =
+{
+	{ 0, -1, -0.982825342010366E-4 },
+	{ 0, 0, 0.105145700850612E1 },
+	{ 0, 1, 0.116033094095084E3 },
+	{ 0, 2, 0.324664750281543E4 },
+	{ 1, 1, -0.123592348610137E4 },
+	{ 2, -1, -0.561403450013495E-1 },
+	{ 3, -3, 0.856677401640869E-7 },
+	{ 3, 0, 0.236313425393924E3 },
+	{ 4, -2, 0.972503292350109E-2 },
+	{ 6, -2, -0.103001994531927E1 },
+	{ 7, -5, -0.149653706199162E-8 },
+	{ 7, -4, -0.215743778861592E-4 },
+	{ 8, -2, -0.834452198291445E1 },
+	{ 10, -3, 0.586602660564988 },
+	{ 12, -12, 0.343480022104968E-25 },
+	{ 12, -6, 0.816256095947021E-5 },
+	{ 12, -5, 0.294985697916798E-2 },
+	{ 14, -10, 0.711730466276584E-16 },
+	{ 14, -8, 0.400954763806941E-9 },
+	{ 14, -3, 0.107766027032853E2 },
+	{ 16, -8, -0.409449599138182E-6 },
+	{ 18, -8, -0.729121307758902E-5 },
+	{ 20, -10, 0.677107970938909E-8 },
+	{ 22, -10, 0.602745973022975E-7 },
+	{ 24, -12, -0.382323011855257E-10 },
+	{ 24, -8, 0.179946628317437E-2 },
+	{ 36, -12, -0.345042834640005E-3 }
+};
+
+static const coefficient v3q_pT_coeffs[] =
+{
+	{ -12, 10, -0.82043384325995E5 },
+	{ -12, 12, 0.473271518461586E11 },
+	{ -10, 6, -0.805950021005413E-1 },
+	{ -10, 7, 0.32860002543598E2 },
+	{ -10, 8, -0.35661702998249E4 },
+	{ -10, 10, -0.172985781433335E10 },
+	{ -8, 8, 0.351769232729192E8 },
+	{ -6, 6, -0.775489259985144E6 },
+	{ -5, 2, 0.710346691966018E-4 },
+	{ -5, 5, 0.993499883820274E5 },
+	{ -4, 3, -0.64209417190457 },
+	{ -4, 4, -0.612842816820083E4 },
+	{ -3, 3, 0.232808472983776E3 },
+	{ -2, 0, -0.142808220416837E-4 },
+	{ -2, 1, -0.643596060678456E-2 },
+	{ -2, 2, -0.428577227475614E1 },
+	{ -2, 4, 0.225689939161918E4 },
+	{ -1, 0, 0.10035565172151E-2 },
+	{ -1, 1, 0.333491455143516 },
+	{ -1, 2, 0.109697576888873E1 },
+	{ 0, 0, 0.961917379376452 },
+	{ 1, 0, -0.838165632204598E-1 },
+	{ 1, 1, 0.247795908411492E1 },
+	{ 1, 3, -0.319114969006533E4 }
+};
+
+static const coefficient v3r_pT_coeffs[] =
+{
+	{ -8, 6, 0.144165955660863E-2 },
+	{ -8, 14, -0.701438599628258E13 },
+	{ -3, -3, -0.830946716459219E-16 },
+	{ -3, 3, 0.261975135368109 },
+	{ -3, 4, 0.393097214706245E3 },
+	{ -3, 5, -0.104334030654021E5 },
+	{ -3, 8, 0.490112654154211E9 },
+	{ 0, -1, -0.147104222772069E-3 },
+	{ 0, 0, 0.103602748043408E1 },
+	{ 0, 1, 0.305308890065089E1 },
+	{ 0, 5, -0.399745276971264E7 },
+	{ 3, -6, 0.56923371959375E-11 },
+	{ 3, -2, -0.464923504407778E-1 },
+	{ 8, -12, -0.535400396512906E-17 },
+	{ 8, -10, 0.399988795693162E-12 },
+	{ 8, -8, -0.536479560201811E-6 },
+	{ 8, -5, 0.159536722411202E-1 },
+	{ 10, -12, 0.270303248860217E-14 },
+	{ 10, -10, 0.244247453858506E-7 },
+	{ 10, -8, -0.983430636716454E-5 },
+	{ 10, -6, 0.663513144224454E-1 },
+	{ 10, -5, -0.993456957845006E1 },
+	{ 10, -4, 0.546491323528491E3 },
+	{ 10, -3, -0.143365406393758E5 },
+	{ 10, -2, 0.150764974125511E6 },
+	{ 12, -12, -0.337209709340105E-9 },
+	{ 14, -12, 0.377501980025469E-8 }
+};
+
+static const coefficient v3s_pT_coeffs[] =
+{
+	{ -12, 20, -0.532466612140254E23 },
+	{ -12, 24, 0.100415480000824E32 },
+	{ -10, 22, -0.191540001821367E30 },
+	{ -8, 14, 0.105618377808847E17 },
+	{ -6, 36, 0.202281884477061E59 },
+	{ -5, 8, 0.884585472596134E8 },
+	{ -5, 16, 0.166540181638363E23 },
+	{ -4, 6, -0.313563197669111E6 },
+	{ -4, 32, -0.185662327545324E54 },
+	{ -3, 3, -0.624942093918942E-1 },
+	{ -3, 8, -0.50416072413259E10 },
+	{ -2, 4, 0.187514491833092E5 },
+	{ -1, 1, 0.121399979993217E-2 },
+	{ -1, 2, 0.188317043049455E1 },
+	{ -1, 3, -0.16707350396206E4 },
+	{ 0, 0, 0.965961650599775 },
+	{ 0, 1, 0.294885696802488E1 },
+	{ 0, 4, -0.653915627346115E5 },
+	{ 0, 28, 0.604012200163444E50 },
+	{ 1, 0, -0.198339358557937 },
+	{ 1, 32, -0.175984090163501E58 },
+	{ 3, 0, 0.356314881403987E1 },
+	{ 3, 1, -0.575991255144384E3 },
+	{ 3, 2, 0.456213415338071E5 },
+	{ 4, 3, -0.109174044987829E8 },
+	{ 4, 18, 0.437796099975134E34 },
+	{ 4, 24, -0.616552611135792E46 },
+	{ 5, 4, 0.193568768917797E10 },
+	{ 14, 24, 0.950898170425042E54 }
+};
+
+static const coefficient v3t_pT_coeffs[] =
+{
+	{ 0, 0, 0.155287249586268E1 },
+	{ 0, 1, 0.664235115009031E1 },
+	{ 0, 4, -0.28936623672721E4 },
+	{ 0, 12, -0.385923202309848E13 },
+	{ 1, 0, -0.291002915783761E1 },
+	{ 1, 10, -0.829088246858083E12 },
+	{ 2, 0, 0.176814899675218E1 },
+	{ 2, 6, -0.534686695713469E9 },
+	{ 2, 14, 0.160464608687834E18 },
+	{ 3, 3, 0.196435366560186E6 },
+	{ 3, 8, 0.156637427541729E13 },
+	{ 4, 0, -0.178154560260006E1 },
+	{ 4, 10, -0.229746237623692E16 },
+	{ 7, 3, 0.385659001648006E8 },
+	{ 7, 4, 0.110554446790543E10 },
+	{ 7, 7, -0.677073830687349E14 },
+	{ 7, 20, -0.327910592086523E31 },
+	{ 7, 36, -0.341552040860644E51 },
+	{ 10, 10, -0.527251339709047E21 },
+	{ 10, 12, 0.245375640937055E24 },
+	{ 10, 14, -0.168776617209269E27 },
+	{ 10, 16, 0.358958955867578E29 },
+	{ 10, 22, -0.656475280339411E36 },
+	{ 18, 18, 0.355286045512301E39 },
+	{ 20, 32, 0.56902145441327E58 },
+	{ 22, 22, -0.700584546433113E48 },
+	{ 22, 36, -0.705772623326374E65 },
+	{ 24, 24, 0.166861176200148E53 },
+	{ 28, 28, -0.300475129680486E61 },
+	{ 32, 22, -0.668481295196808E51 },
+	{ 32, 32, 0.428432338620678E69 },
+	{ 32, 36, -0.444227367758304E72 },
+	{ 36, 36, -0.281396013562745E77 }
+};
+
+static const coefficient v3u_pT_coeffs[] =
+{
+	{ -12, 14, 0.122088349258355E18 },
+	{ -10, 10, 0.104216468608488E10 },
+	{ -10, 12, -0.882666931564652E16 },
+	{ -10, 14, 0.259929510849499E20 },
+	{ -8, 10, 0.222612779142211E15 },
+	{ -8, 12, -0.878473585050085E18 },
+	{ -8, 14, -0.314432577551552E22 },
+	{ -6, 8, -0.216934916996285E13 },
+	{ -6, 12, 0.159079648196849E21 },
+	{ -5, 4, -0.339567617303423E3 },
+	{ -5, 8, 0.884387651337836E13 },
+	{ -5, 12, -0.843405926846418E21 },
+	{ -3, 2, 0.114178193518022E2 },
+	{ -1, -1, -0.122708229235641E-3 },
+	{ -1, 1, -0.106201671767107E3 },
+	{ -1, 12, 0.903443213959313E25 },
+	{ -1, 14, -0.693996270370852E28 },
+	{ 0, -3, 0.648916718965575E-8 },
+	{ 0, 1, 0.718957567127851E4 },
+	{ 1, -2, 0.105581745346187E-2 },
+	{ 2, 5, -0.651903203602581E15 },
+	{ 2, 10, -0.160116813274676E25 },
+	{ 3, -5, -0.510254294237837E-8 },
+	{ 5, -4, -0.152355388953402 },
+	{ 5, 2, 0.677143292290144E12 },
+	{ 5, 3, 0.27637843837893E15 },
+	{ 6, -5, 0.116862983141686E-1 },
+	{ 6, 2, -0.301426947980171E14 },
+	{ 8, -8, 0.16971981388484E-7 },
+	{ 8, 8, 0.104674840020929E27 },
+	{ 10, -4, -0.10801690456014E5 },
+	{ 12, -12, -0.990623601934295E-12 },
+	{ 12, -4, 0.536116483602738E7 },
+	{ 12, 4, 0.226145963747881E22 },
+	{ 14, -12, -0.48873156577621E-9 },
+	{ 14, -10, 0.15100154888067E-4 },
+	{ 14, -6, -0.22770046464392E5 },
+	{ 14, 6, -0.781754507698846E28 }
+};
+
+static const coefficient v3v_pT_coeffs[] =
+{
+	{ -10, -8, -0.415652812061591E-54 },
+	{ -8, -12, 0.177441742924043E-60 },
+	{ -6, -12, -0.357078668203377E-54 },
+	{ -6, -3, 0.359252213604114E-25 },
+	{ -6, 5, -0.259123736380269E2 },
+	{ -6, 6, 0.59461976619346E5 },
+	{ -6, 8, -0.624184007103158E11 },
+	{ -6, 10, 0.313080299915944E17 },
+	{ -5, 1, 0.105006446192036E-8 },
+	{ -5, 2, -0.192824336984852E-5 },
+	{ -5, 6, 0.654144373749937E6 },
+	{ -5, 8, 0.513117462865044E13 },
+	{ -5, 10, -0.697595750347391E19 },
+	{ -5, 14, -0.103977184454767E29 },
+	{ -4, -12, 0.119563135540666E-47 },
+	{ -4, -10, -0.436677034051655E-41 },
+	{ -4, -6, 0.926990036530639E-29 },
+	{ -4, 10, 0.587793105620748E21 },
+	{ -3, -3, 0.280375725094731E-17 },
+	{ -3, 10, -0.192359972440634E23 },
+	{ -3, 12, 0.742705723302738E27 },
+	{ -2, 2, -0.517429682450605E2 },
+	{ -2, 4, 0.820612048645469E7 },
+	{ -1, -2, -0.188214882341448E-8 },
+	{ -1, 0, 0.184587261114837E-1 },
+	{ 0, -2, -0.135830407782663E-5 },
+	{ 0, 6, -0.723681885626348E17 },
+	{ 0, 10, -0.223449194054124E27 },
+	{ 1, -12, -0.111526741826431E-34 },
+	{ 1, -10, 0.276032601145151E-28 },
+	{ 3, 3, 0.134856491567853E15 },
+	{ 4, -6, 0.65244029334586E-9 },
+	{ 4, 3, 0.51065511977436E17 },
+	{ 4, 10, -0.468138358908732E32 },
+	{ 5, 2, -0.760667491183279E16 },
+	{ 8, -12, -0.417247986986821E-18 },
+	{ 10, -2, 0.312545677756104E14 },
+	{ 12, -3, -0.100375333864186E15 },
+	{ 14, 1, 0.247761392329058E27 }
+};
+
+static const coefficient v3w_pT_coeffs[] =
+{
+	{ -12, 8, -0.586219133817016E-7 },
+	{ -12, 14, -0.894460355005526E11 },
+	{ -10, -1, 0.531168037519774E-30 },
+	{ -10, 8, 0.109892402329239 },
+	{ -8, 6, -0.575368389425212E-1 },
+	{ -8, 8, 0.228276853990249E5 },
+	{ -8, 14, -0.158548609655002E19 },
+	{ -6, -4, 0.329865748576503E-27 },
+	{ -6, -3, -0.634987981190669E-24 },
+	{ -6, 2, 0.615762068640611E-8 },
+	{ -6, 8, -0.961109240985747E8 },
+	{ -5, -10, -0.406274286652625E-44 },
+	{ -4, -1, -0.471103725498077E-12 },
+	{ -4, 3, 0.725937724828145 },
+	{ -3, -10, 0.187768525763682E-38 },
+	{ -3, 3, -0.103308436323771E4 },
+	{ -2, 1, -0.662552816342168E-1 },
+	{ -2, 2, 0.57951404176571E3 },
+	{ -1, -8, 0.237416732616644E-26 },
+	{ -1, -4, 0.271700235739893E-14 },
+	{ -1, 1, -0.9078862134836E2 },
+	{ 0, -12, -0.171242509570207E-36 },
+	{ 0, 1, 0.156792067854621E3 },
+	{ 1, -1, 0.92326135790147 },
+	{ 2, -1, -0.597865988422577E1 },
+	{ 2, 2, 0.321988767636389E7 },
+	{ 3, -12, -0.399441390042203E-29 },
+	{ 3, -5, 0.493429086046981E-7 },
+	{ 5, -10, 0.812036983370565E-19 },
+	{ 5, -8, -0.207610284654137E-11 },
+	{ 5, -6, -0.340821291419719E-6 },
+	{ 8, -12, 0.542000573372233E-17 },
+	{ 8, -10, -0.856711586510214E-12 },
+	{ 10, -12, 0.266170454405981E-13 },
+	{ 10, -8, 0.858133791857099E-5 }
+};
+
+static const coefficient v3x_pT_coeffs[] =
+{
+	{ -8, 14, 0.377373741298151E19 },
+	{ -6, 10, -0.507100883722913E13 },
+	{ -5, 10, -0.10336322559886E16 },
+	{ -4, 1, 0.184790814320773E-5 },
+	{ -4, 2, -0.924729378390945E-3 },
+	{ -4, 14, -0.425999562292738E24 },
+	{ -3, -2, -0.462307771873973E-12 },
+	{ -3, 12, 0.107319065855767E22 },
+	{ -1, 5, 0.648662492280682E11 },
+	{ 0, 0, 0.244200600688281E1 },
+	{ 0, 4, -0.851535733484258E10 },
+	{ 0, 10, 0.169894481433592E22 },
+	{ 1, -10, 0.21578022250902E-26 },
+	{ 1, -1, -0.320850551367334 },
+	{ 2, 6, -0.38264244845861E17 },
+	{ 3, -12, -0.275386077674421E-28 },
+	{ 3, 0, -0.563199253391666E6 },
+	{ 3, 8, -0.326068646279314E21 },
+	{ 4, 3, 0.397949001553184E14 },
+	{ 5, -6, 0.100824008584757E-6 },
+	{ 5, -2, 0.162234569738433E5 },
+	{ 5, 1, -0.432355225319745E11 },
+	{ 6, 1, -0.59287424559861E12 },
+	{ 8, -6, 0.133061647281106E1 },
+	{ 8, -3, 0.157338197797544E7 },
+	{ 8, 1, 0.258189614270853E14 },
+	{ 8, 8, 0.262413209706358E25 },
+	{ 10, -8, -0.920011937431142E-1 },
+	{ 12, -10, 0.220213765905426E-2 },
+	{ 12, -8, -0.110433759109547E2 },
+	{ 12, -5, 0.847004870612087E7 },
+	{ 12, -4, -0.592910695762536E9 },
+	{ 14, -12, -0.18302717326966E-4 },
+	{ 14, -10, 0.181339603516302 },
+	{ 14, -8, -0.119228759669889E4 },
+	{ 14, -6, 0.430867658061468E7 }
+};
+
+static const coefficient v3y_pT_coeffs[] =
+{
+	{ 0, -3, -0.525597995024633E-9 },
+	{ 0, 1, 0.583441305228407E4 },
+	{ 0, 5, -0.134778968457925E17 },
+	{ 0, 8, 0.118973500934212E26 },
+	{ 1, 8, -0.159096490904708E27 },
+	{ 2, -4, -0.315839902302021E-6 },
+	{ 2, -1, 0.496212197158239E3 },
+	{ 2, 4, 0.327777227273171E19 },
+	{ 2, 5, -0.527114657850696E22 },
+	{ 3, -8, 0.210017506281863E-16 },
+	{ 3, 4, 0.705106224399834E21 },
+	{ 3, 8, -0.266713136106469E31 },
+	{ 4, -6, -0.145370512554562E-7 },
+	{ 4, 6, 0.14933391705313E28 },
+	{ 5, -2, -0.149795620287641E8 },
+	{ 5, 1, -0.3818819062711E16 },
+	{ 8, -8, 0.724660165585797E-4 },
+	{ 8, -2, -0.937808169550193E14 },
+	{ 10, -5, 0.514411468376383E10 },
+	{ 12, -8, -0.828198594040141E5 }
+};
+
+static const coefficient v3z_pT_coeffs[] =
+{
+	{ -8, 3, 0.24400789229065E-10 },
+	{ -6, 6, -0.463057430331242E7 },
+	{ -5, 6, 0.728803274777712E10 },
+	{ -5, 8, 0.327776302858856E16 },
+	{ -4, 5, -0.110598170118409E10 },
+	{ -4, 6, -0.323899915729957E13 },
+	{ -4, 8, 0.923814007023245E16 },
+	{ -3, -2, 0.842250080413712E-12 },
+	{ -3, 5, 0.663221436245506E12 },
+	{ -3, 6, -0.167170186672139E15 },
+	{ -2, 2, 0.253749358701391E4 },
+	{ -1, -6, -0.819731559610523E-20 },
+	{ 0, 3, 0.328380587890663E12 },
+	{ 1, 1, -0.625004791171543E8 },
+	{ 2, 6, 0.803197957462023E21 },
+	{ 3, -6, -0.204397011338353E-10 },
+	{ 3, -2, -0.378391047055938E4 },
+	{ 6, -6, 0.97287654593862E-2 },
+	{ 6, -5, 0.154355721681459E2 },
+	{ 6, -4, -0.373962862928643E4 },
+	{ 6, -1, -0.682859011374572E11 },
+	{ 8, -8, -0.248488015614543E-3 },
+	{ 8, -4, 0.394536049497068E7 }
+};
+
+/**
+ * The reducing quantities and exponents of the region 3 v(p,T)
+ * equations, v/v* = (sum n ((p/p* - a)^c)^I ((T/T* - b)^d)^J)^e.
+ * For subregion 3n, e is 0 and v/v* = exp(sum n (p/p* - a)^I
+ * (T/T* - b)^J) instead.
+ */
+struct subregion
+{
+	const coefficient* coeffs;
+	size_t count;
+
+	double v, p, T;
+	double a, b, c, d, e;
+};
+
+static const subregion v3_pT_subregions[] =
+{
+	{ v3a_pT_coeffs, COUNT(v3a_pT_coeffs),
+		0.0024, 100., 760., 0.085, 0.817, 1., 1., 1. },
+	{ v3b_pT_coeffs, COUNT(v3b_pT_coeffs),
+		0.0041, 100., 860., 0.28, 0.779, 1., 1., 1. },
+	{ v3c_pT_coeffs, COUNT(v3c_pT_coeffs),
+		0.0022, 40., 690., 0.259, 0.903, 1., 1., 1. },
+	{ v3d_pT_coeffs, COUNT(v3d_pT_coeffs),
+		0.0029, 40., 690., 0.559, 0.939, 1., 1., 4. },
+	{ v3e_pT_coeffs, COUNT(v3e_pT_coeffs),
+		0.0032, 40., 710., 0.587, 0.918, 1., 1., 1. },
+	{ v3f_pT_coeffs, COUNT(v3f_pT_coeffs),
+		0.0064, 40., 730., 0.587, 0.891, 0.5, 1., 4. },
+	{ v3g_pT_coeffs, COUNT(v3g_pT_coeffs),
+		0.0027, 25., 660., 0.872, 0.971, 1., 1., 4. },
+	{ v3h_pT_coeffs, COUNT(v3h_pT_coeffs),
+		0.0032, 25., 660., 0.898, 0.983, 1., 1., 4. },
+	{ v3i_pT_coeffs, COUNT(v3i_pT_coeffs),
+		0.0041, 25., 660., 0.91, 0.984, 0.5, 1., 4. },
+	{ v3j_pT_coeffs, COUNT(v3j_pT_coeffs),
+		0.0054, 25., 670., 0.875, 0.964, 0.5, 1., 4. },
+	{ v3k_pT_coeffs, COUNT(v3k_pT_coeffs),
+		0.0077, 25., 680., 0.802, 0.935, 1., 1., 1. },
+	{ v3l_pT_coeffs, COUNT(v3l_pT_coeffs),
+		0.0026, 24., 650., 0.908, 0.989, 1., 1., 4. },
+	{ v3m_pT_coeffs, COUNT(v3m_pT_coeffs),
+		0.0028, 23., 650., 1., 0.997, 1., 0.25, 1. },
+	{ v3n_pT_coeffs, COUNT(v3n_pT_coeffs),
+		0.0031, 23., 650., 0.976, 0.997, 1., 1., 0. },
+	{ v3o_pT_coeffs, COUNT(v3o_pT_coeffs),
+		0.0034, 23., 650., 0.974, 0.996, 0.5, 1., 1. },
+	{ v3p_pT_coeffs, COUNT(v3p_pT_coeffs),
+		0.0041, 23., 650., 0.972, 0.997, 0.5, 1., 1. },
+	{ v3q_pT_coeffs, COUNT(v3q_pT_coeffs),
+		0.0022, 23., 650., 0.848, 0.983, 1., 1., 4. },
+	{ v3r_pT_coeffs, COUNT(v3r_pT_coeffs),
+		0.0054, 23., 650., 0.874, 0.982, 1., 1., 1. },
+	{ v3s_pT_coeffs, COUNT(v3s_pT_coeffs),
+		0.0022, 21., 640., 0.886, 0.99, 1., 1., 4. },
+	{ v3t_pT_coeffs, COUNT(v3t_pT_coeffs),
+		0.0088, 20., 650., 0.803, 1.02, 1., 1., 1. },
+	{ v3u_pT_coeffs, COUNT(v3u_pT_coeffs),
+		0.0026, 23., 650., 0.902, 0.988, 1., 1., 1. },
+	{ v3v_pT_coeffs, COUNT(v3v_pT_coeffs),
+		0.0031, 23., 650., 0.96, 0.995, 1., 1., 1. },
+	{ v3w_pT_coeffs, COUNT(v3w_pT_coeffs),
+		0.0039, 23., 650., 0.959, 0.995, 1., 1., 4. },
+	{ v3x_pT_coeffs, COUNT(v3x_pT_coeffs),
+		0.0049, 23., 650., 0.91, 0.988, 1., 1., 1. },
+	{ v3y_pT_coeffs, COUNT(v3y_pT_coeffs),
+		0.0031, 22., 650., 0.996, 0.994, 1., 1., 4. },
+	{ v3z_pT_coeffs, COUNT(v3z_pT_coeffs),
+		0.0038, 22., 650., 0.993, 0.994, 1., 1., 4. }
+};
+
+// the boundaries between the region 3 subregions, T3xy(p)
+
+static const double T3ab_coeffs[] =
+{
+	0.154793642129415E4, -0.187661219490113E3, 0.213144632222113E2,
+	-0.191887498864292E4, 0.918419702359447E3
+};
+
+static const double T3cd_coeffs[] =
+{
+	0.585276966696349E3, 0.278233532206915E1, -0.127283549295878E-1,
+	0.159090746562729E-3
+};
+
+static const double T3gh_coeffs[] =
+{
+	-0.249284240900418E5, 0.428143584791546E4, -0.269029173140130E3,
+	0.751608051114157E1, -0.787105249910383E-1
+};
+
+static const double T3ij_coeffs[] =
+{
+	0.584814781649163E3, -0.616179320924617, 0.260763050899562,
+	-0.587071076864459E-2, 0.515308185433082E-4
+};
+
+static const double T3jk_coeffs[] =
+{
+	0.617229772068439E3, -0.770600270141675E1, 0.697072596851896,
+	-0.157391839848015E-1, 0.137897492684194E-3
+};
+
+static const double T3mn_coeffs[] =
+{
+	0.535339483742384E3, 0.761978122720128E1, -0.158365725441648,
+	0.192871054508108E-2
+};
+
+static const double T3op_coeffs[] =
+{
+	0.969461372400213E3, -0.332500170441278E3, 0.642859598466067E2,
+	0.773845935768222E3, -0.152313732937084E4
+};
+
+static const double T3qu_coeffs[] =
+{
+	0.565603648239126E3, 0.529062258221222E1, -0.102020639611016,
+	0.122240301070145E-2
+};
+
+static const double T3rx_coeffs[] =
+{
+	0.584561202520006E3, -0.102961025163669E1, 0.243293362700452,
+	-0.294905044740799E-2
+};
+
+static const double T3uv_coeffs[] =
+{
+	0.528199646263062E3, 0.890579602135307E1, -0.222814134903755,
+	0.286791682263697E-2
+};
+
+static const double T3wx_coeffs[] =
+{
+	0.728052609145380E1, 0.973505869861952E2, 0.147370491183191E2,
+	0.329196213998375E3, 0.873371668682417E3
+};
+
+static const double T_min = 273.15;
+static const double T_13 = 623.15;
+static const double T_25 = 1073.15;
+static const double T_max = 2273.15;
+
+static const double T_c = 647.096;
+// the highest temperature at which the two-phase (rho,u) states
+// are resolved, just below the critical point
+static const double T_dome = 647.09;
+
+static const double p_min = 611.212677E-6; // psat(T_min)
+static const double p_13 = 16.5291642526045; // psat(T_13)
+static const double p_c = 22.064;
+static const double p_5 = 50.;
+static const double p_max = 100.;
+
+static const double s_c = 4.41202148223476;
+static const double rho_c = 322.;
+static const double v_c = 1. / rho_c;
+
+// bounds of the two-phase region in (v,u): the minimal v' (at 277 K),
+// v'' at the triple point and the maximal u'' (at 508 K), all with
+// a small margin
+static const double v_dome_min = 0.99999E-3;
+static const double v_dome_max = 206.2;
+static const double u_dome_max = 2604.;
+
+// the saturation line is only followed (when screening the (rho,u)
+// states) between v' at the triple point (v'(T) has a minimum
+// at 277 K) and T_screen, below the critical point where the isochores
+// meet it at a steep angle; with a margin around the saturated u
+static const double v_screen_min = 1.0003E-3;
+static const double T_screen = 640.;
+static const double u_screen_margin = 1E-3;
+
+// the u below which the single-phase (rho,u) iteration starts in region 1
+// (u at 623.15 K is 1420 to 1640 kJ/kg), and the density above which
+// it starts in region 3
+static const double u_13 = 1400.;
+static const double rho_dense = 50.;
+
+// the specific gas constant [kJ/kgK]
+static const double R = 0.461526;
+
+// the maximal number of Newton steps in the EXACT mode
+static const int max_iterations = 20;
+
+// the relative Newton step size considered negligible, and the one
+// after which a warm-started iteration is considered converged (since
+// the convergence is quadratic, the remaining error is then negligible)
+static const double step_tolerance = 1E-13;
+static const double warm_step_tolerance = 1E-7;
+
+static inline void out_of_range()
+{
+	throw std::range_error("Requested parameters out-of-range.");
+}
+
+/**
+ * Sum up n * x^I * y^J.
+ */
+static double polynomial(const coefficient* coeffs, size_t count,
+		double x, double y)
+{
+	double ret = 0.;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const coefficient& c = coeffs[i];
+
+		ret += c.n * std::pow(x, c.I) * std::pow(y, c.J);
+	}
+
+	return ret;
+}
+
+#define POLYNOMIAL(coeffs, x, y) polynomial(coeffs, COUNT(coeffs), x, y)
+
+static double T1_ph(double p, double h)
+{
+	return POLYNOMIAL(T1_ph_coeffs, p, h / 2500. + 1.);
+}
+
+static double T1_ps(double p, double s)
+{
+	return POLYNOMIAL(T1_ps_coeffs, p, s + 2.);
+}
+
+static double p1_hs(double h, double s)
+{
+	return 100. * POLYNOMIAL(p1_hs_coeffs, h / 3400. + 0.05, s / 7.6 + 0.05);
+}
+
+static double T2_ph(double p, double h)
+{
+	if (p <= 4.)
+		return POLYNOMIAL(T2a_ph_coeffs, p, h / 2000. - 2.1);
+
+	// the 2b-2c boundary
+	double p_bc = 0.90584278514723E3 - 0.67955786399241 * h
+		+ 0.12809002730136E-3 * h * h;
+
+	if (p < p_bc)
+		return POLYNOMIAL(T2b_ph_coeffs, p - 2., h / 2000. - 2.6);
+	else
+		return POLYNOMIAL(T2c_ph_coeffs, p + 25., h / 2000. - 1.8);
+}
+
+static double T2_ps(double p, double s)
+{
+	if (p <= 4.)
+		return POLYNOMIAL(T2a_ps_coeffs, p, s / 2. - 2.);
+	else if (s >= 5.85)
+		return POLYNOMIAL(T2b_ps_coeffs, p, 10. - s / 0.7853);
+	else
+		return POLYNOMIAL(T2c_ps_coeffs, p, 2. - s / 2.9251);
+}
+
+static double p2_hs(double h, double s)
+{
+	double ret;
+
+	if (s < 5.85)
+		ret = 100. * std::pow(POLYNOMIAL(p2c_hs_coeffs,
+					h / 3500. - 0.7, s / 5.9 - 1.1), 4);
+	else
+	{
+		// the 2a-2b boundary
+		double h_ab = -0.349898083432139E4 + 0.257560716905876E4 * s
+			- 0.421073558227969E3 * s * s
+			+ 0.276349063799944E2 * s * s * s;
+
+		if (h <= h_ab)
+			ret = 4. * std::pow(POLYNOMIAL(p2a_hs_coeffs,
+						h / 4200. - 0.5, s / 12. - 1.2), 4);
+		else
+			ret = 100. * std::pow(POLYNOMIAL(p2b_hs_coeffs,
+						h / 4100. - 0.6, s / 7.9 - 1.01), 4);
+	}
+
+	return ret;
+}
+
+static void region3_ph(double p, double h, double& T, double& v)
+{
+	// the 3a-3b boundary
+	double h_ab = 0.201464004206875E4 + 0.374696550136983E1 * p
+		- 0.219921901054187E-1 * p * p
+		+ 0.875131686009950E-4 * p * p * p;
+	double pi = p / 100.;
+
+	if (h <= h_ab)
+	{
+		T = 760. * POLYNOMIAL(T3a_ph_coeffs, pi + 0.240, h / 2300. - 0.615);
+		v = 0.0028 * POLYNOMIAL(v3a_ph_coeffs, pi + 0.128, h / 2100. - 0.727);
+	}
+	else
+	{
+		T = 860. * POLYNOMIAL(T3b_ph_coeffs, pi + 0.298, h / 2800. - 0.720);
+		v = 0.0088 * POLYNOMIAL(v3b_ph_coeffs, pi + 0.0661, h / 2800. - 0.720);
+	}
+}
+
+static void region3_ps(double p, double s, double& T, double& v)
+{
+	double pi = p / 100.;
+
+	if (s <= s_c)
+	{
+		T = 760. * POLYNOMIAL(T3a_ps_coeffs, pi + 0.240, s / 4.4 - 0.703);
+		v = 0.0028 * POLYNOMIAL(v3a_ps_coeffs, pi + 0.187, s / 4.4 - 0.755);
+	}
+	else
+	{
+		T = 860. * POLYNOMIAL(T3b_ps_coeffs, pi + 0.760, s / 5.3 - 0.818);
+		v = 0.0088 * POLYNOMIAL(v3b_ps_coeffs, pi + 0.298, s / 5.3 - 0.816);
+	}
+}
+
+static double p3_hs(double h, double s)
+{
+	if (s <= s_c)
+		return 99. * POLYNOMIAL(p3a_hs_coeffs, h / 2300. - 1.01, s / 4.4 - 0.750);
+	else
+		return 16.6 / POLYNOMIAL(p3b_hs_coeffs, h / 2800. - 0.681, s / 5.3 - 0.792);
+}
+
+static double Tsat_hs(double h, double s)
+{
+	return 550. * POLYNOMIAL(Tsat_hs_coeffs, h / 2800. - 0.119, s / 9.2 - 1.07);
+}
+
+/**
+ * Evaluate a T3xy(p) subregion boundary, either a polynomial in p,
+ * or a sum of n (ln p)^I with I being 0, 1, 2, -1 and -2.
+ */
+static double boundary(const double* coeffs, size_t count, double p)
+{
+	double ret = 0.;
+	double x = 1.;
+
+	for (size_t i = 0; i < count; ++i, x *= p)
+		ret += coeffs[i] * x;
+
+	return ret;
+}
+
+static double log_boundary(const double* coeffs, double p)
+{
+	double l = std::log(p);
+
+	return coeffs[0] + coeffs[1] * l + coeffs[2] * l * l
+		+ coeffs[3] / l + coeffs[4] / (l * l);
+}
+
+#define BOUNDARY(coeffs, p) boundary(coeffs, COUNT(coeffs), p)
+
+/**
+ * Determine the region 3 subregion for v(p,T), including
+ * the auxiliary subregions 3u through 3z near the critical point.
+ *
+ * Returns the subregion letter.
+ */
+static char v3_subregion(double p, double T)
+{
+	// T3ef is linear
+	double T_ef = 3.727888004 * (p - p_c) + 647.096;
+
+	if (p > 40.)
+		return T <= log_boundary(T3ab_coeffs, p) ? 'a' : 'b';
+	else if (T <= BOUNDARY(T3cd_coeffs, p))
+		return 'c';
+	else if (p > 25.)
+	{
+		if (T <= log_boundary(T3ab_coeffs, p))
+			return 'd';
+		return T <= T_ef ? 'e' : 'f';
+	}
+	else if (p > 23.)
+	{
+		if (T <= BOUNDARY(T3gh_coeffs, p))
+			return p > 23.5 ? 'g' : 'l';
+		else if (T <= T_ef)
+			return 'h';
+		else if (T <= BOUNDARY(T3ij_coeffs, p))
+			return 'i';
+		return T <= BOUNDARY(T3jk_coeffs, p) ? 'j' : 'k';
+	}
+	else if (p > 22.5)
+	{
+		if (T <= BOUNDARY(T3gh_coeffs, p))
+			return 'l';
+		else if (T <= BOUNDARY(T3mn_coeffs, p))
+			return 'm';
+		else if (T <= T_ef)
+			return 'n';
+		else if (T <= log_boundary(T3op_coeffs, p))
+			return 'o';
+		else if (T <= BOUNDARY(T3ij_coeffs, p))
+			return 'p';
+		return T <= BOUNDARY(T3jk_coeffs, p) ? 'j' : 'k';
+	}
+	// psat(643.15 K)
+	else if (p > 21.04336732)
+	{
+		if (T <= BOUNDARY(T3qu_coeffs, p))
+			return 'q';
+		else if (T > BOUNDARY(T3rx_coeffs, p))
+			return T <= BOUNDARY(T3jk_coeffs, p) ? 'r' : 'k';
+
+		// the auxiliary equations near the critical point
+		if (p > 22.11)
+		{
+			if (T <= BOUNDARY(T3uv_coeffs, p))
+				return 'u';
+			else if (T <= T_ef)
+				return 'v';
+			return T <= log_boundary(T3wx_coeffs, p) ? 'w' : 'x';
+		}
+		else if (p > p_c)
+		{
+			if (T <= BOUNDARY(T3uv_coeffs, p))
+				return 'u';
+			else if (T <= T_ef)
+				return 'y';
+			return T <= log_boundary(T3wx_coeffs, p) ? 'z' : 'x';
+		}
+		// 21.93161551 and 21.90096265 MPa are where T3uv and T3wx
+		// meet the saturation line
+		else if (T <= if97::Tsat(p))
+		{
+			if (p > 21.93161551 && T > BOUNDARY(T3uv_coeffs, p))
+				return 'y';
+			return 'u';
+		}
+		else if (p > 21.90096265 && T <= log_boundary(T3wx_coeffs, p))
+			return 'z';
+		return 'x';
+	}
+	else if (p > 20.5)
+	{
+		if (T <= if97::Tsat(p))
+			return 's';
+		return T <= BOUNDARY(T3jk_coeffs, p) ? 'r' : 'k';
+	}
+	// p3cd, where T3cd meets the saturation line
+	else if (p > 19.00881189173929)
+		return T <= if97::Tsat(p) ? 's' : 't';
+
+	return T <= if97::Tsat(p) ? 'c' : 't';
+}
+
+/**
+ * Get the specific volume in region 3 from the SR5 v(p,T) backward
+ * equations.
+ */
+static double v3_pT(double p, double T)
+{
+	const subregion& sr = v3_pT_subregions[v3_subregion(p, T) - 'a'];
+	double pi = p / sr.p - sr.a;
+	double theta = T / sr.T - sr.b;
+
+	if (sr.e == 0.)
+		return sr.v * std::exp(polynomial(sr.coeffs, sr.count, pi, theta));
+
+	return sr.v * std::pow(polynomial(sr.coeffs, sr.count,
+				std::pow(pi, sr.c), std::pow(theta, sr.d)), sr.e);
+}
+
+namespace
+{
+	/**
+	 * The independent variables of a backward equation.
+	 */
+	typedef enum
+	{
+		PH,
+		PS,
+		HS,
+		PT,
+		RHOT,
+		RHOU
+	} target_type;
+
+	/**
+	 * An intermediate state point. p & T are used in regions 1, 2
+	 * and 5, rho & T in region 3, and p, T & x in region 4.
+	 */
+	struct Point
+	{
+		Region region;
+		double p, T, rho, x;
+	};
+}
+
+static Point gibbs_point(Region r, double p, double T)
+{
+	Point ret = { r, p, T, 0., 0. };
+
+	return ret;
+}
+
+static Point region3_point(double rho, double T)
+{
+	Point ret = { Region::R3, 0., T, rho, 0. };
+
+	return ret;
+}
+
+static Point region4_point(double p, double T, double x)
+{
+	Point ret = { Region::R4, p, T, 0., x };
+
+	return ret;
+}
+
+static Point from_state(const H2O& st)
+{
+	switch (st.region())
+	{
+		case Region::R3:
+		{
+			// with p, so that in_region() can check the hint
+			Point ret = region3_point(st.rho(), st.T());
+
+			ret.p = st.p();
+			return ret;
+		}
+		case Region::R4:
+			return region4_point(st.p(), st.T(), st.x());
+		default:
+			return gibbs_point(st.region(), st.p(), st.T());
+	}
+}
+
+static H2O try_to_state(const Point& pt)
+{
+	H2O ret;
+
+	switch (pt.region)
+	{
+		case Region::R3:
+			ret = H2O::try_rhoT(pt.rho, pt.T);
+			// close to the saturation line, libh2o may reclassify
+			// the state as two-phase, with a different p; keep (p,T)
+			// at the cost of using libh2o's density
+			if (ret.region() != Region::R3)
+			{
+				double p = pt.p;
+
+				// p is only set for the (p,T) target
+				if (p == 0.)
+				{
+					PropertySet ps;
+
+					if97::region3(pt.rho, pt.T, ps);
+					p = ps.p;
+				}
+
+				ret = H2O::try_pT(p, pt.T);
+				if (ret.region() != Region::R3)
+					ret = H2O();
+			}
+			break;
+		case Region::R4:
+			ret = H2O::try_px(pt.p, pt.x);
+			break;
+		case Region::OOR:
+			break;
+		default:
+			ret = H2O::try_pT(pt.p, pt.T);
+	}
+
+	return ret;
+}
+
+static H2O to_state(const Point& pt)
+{
+	H2O ret = try_to_state(pt);
+
+	if (!ret.initialized())
+		out_of_range();
+	return ret;
+}
+
+/**
+ * Get the two-phase state from the saturated liquid & vapour states,
+ * with @y being either h or s.
+ */
+static Point two_phase(double p, double T, const PropertySet& liq,
+		const PropertySet& vap, double y, target_type target)
+{
+	double y_liq = target == PH ? liq.h : liq.s;
+	double y_vap = target == PH ? vap.h : vap.s;
+	double x = (y - y_liq) / (y_vap - y_liq);
+
+	return region4_point(p, T, std::min(std::max(x, 0.), 1.));
+}
+
+static Point two_phase(double p, double T, double y, target_type target)
+{
+	PropertySet liq, vap;
+
+	if97::region1(p, T, liq);
+	if97::region2(p, T, vap);
+	return two_phase(p, T, liq, vap, y, target);
+}
+
+/**
+ * Find the state point in region 5 by Newton iteration, starting
+ * at @T. There are no backward equations for region 5.
+ */
+static Point region5(double p, double T, double y, target_type target)
+{
+	T = std::min(std::max(T, T_25), T_max);
+
+	for (int i = 0; i < max_iterations; ++i)
+	{
+		PropertySet ps;
+
+		if97::region5(p, T, ps);
+
+		double dT = target == PH ? (y - ps.h) / ps.cp
+			: T * (y - ps.s) / ps.cp;
+
+		T += dT;
+		if (std::fabs(dT) <= 1E-13 * T)
+			break;
+	}
+
+	if (T < T_25 || T > T_max)
+		return gibbs_point(Region::OOR, p, T);
+	return gibbs_point(Region::R5, p, T);
+}
+
+/**
+ * Get the state point from (p,h) or (p,s) backward equations.
+ *
+ * The backward equations extrapolate poorly, so the region
+ * is determined from the basic equations at the region boundaries,
+ * as recommended by IAPWS. The vapour side is evaluated only if
+ * the state is not in region 1. Both are skipped if the classifier
+ * grid resolves the region (and the state is not two-phase).
+ *
+ * Returns false if the state needs to be determined through libh2o.
+ */
+static bool fast_py(double p, double y, target_type target, Point& out)
+{
+	double (*T1)(double, double) = target == PH ? T1_ph : T1_ps;
+	double (*T2)(double, double) = target == PH ? T2_ph : T2_ps;
+
+	if (p < p_min || p > p_max)
+	{
+		out.region = Region::OOR;
+		return true;
+	}
+
+	// the upper temperature limit of region 1, and the lower one
+	// of region 2 (the same below p_13)
+	double T_1 = p <= p_13 ? if97::Tsat(p) : T_13;
+	double T_2 = p <= p_13 ? T_1 : if97::TB23(p);
+	PropertySet liq, vap;
+	Region r;
+
+	bool known = target == PH ? classifier::lookup_ph(p, y, r)
+		: classifier::lookup_ps(p, y, r);
+
+	// the two-phase states need the saturated states anyway
+	if (!known || r == Region::R4)
+	{
+		known = false;
+		if97::region1(p, T_1, liq);
+		if (y <= (target == PH ? liq.h : liq.s))
+			r = Region::R1;
+		else
+		{
+			if97::region2(p, T_2, vap);
+			if (y >= (target == PH ? vap.h : vap.s))
+				r = Region::R2;
+			else if (p <= p_13)
+				r = Region::R4;
+			else
+				r = Region::R3;
+		}
+	}
+
+	switch (r)
+	{
+		case Region::OOR:
+			out.region = Region::OOR;
+			break;
+		case Region::R5:
+			out = region5(p, T_25, y, target);
+			break;
+		case Region::R1:
+		{
+			double T = T1(p, y);
+
+			if (T < T_min)
+				out.region = Region::OOR;
+			else
+				out = gibbs_point(r, p, std::min(T, T_1));
+			break;
+		}
+		case Region::R2:
+		{
+			double T = T2(p, y);
+
+			// the backward equations are not valid beyond T_25,
+			// so check the region 2-5 boundary using the basic
+			// equation if they end up there
+			if (T < T_2 || T > T_25)
+			{
+				PropertySet hot;
+
+				if97::region2(p, T_25, hot);
+				if (y > (target == PH ? hot.h : hot.s))
+				{
+					if (p <= p_5)
+						out = region5(p, T_25, y, target);
+					else
+						out.region = Region::OOR;
+					break;
+				}
+			}
+
+			out = gibbs_point(r, p, std::min(std::max(T, T_2), T_25));
+			break;
+		}
+		case Region::R3:
+		{
+			// below the critical point, the state can be two-phase,
+			// and the saturation line in region 3 can not be found
+			// without iteration (unless the classifier grid has
+			// already ruled that out)
+			if (p < p_c && !known)
+				return false;
+
+			double T, v;
+
+			if (target == PH)
+				region3_ph(p, y, T, v);
+			else
+				region3_ps(p, y, T, v);
+			out = region3_point(1. / v, T);
+			break;
+		}
+		case Region::R4:
+			out = two_phase(p, T_1, liq, vap, y, target);
+			break;
+		default:
+			assert(not_reached);
+	}
+
+	return true;
+}
+
+/**
+ * Get the state point from (h,s) backward equations.
+ *
+ * Returns false if the state needs to be determined through libh2o.
+ */
+static bool fast_hs(double h, double s, Point& out)
+{
+	double sigma = s / 3.8;
+
+	if (s <= 0. || s >= 11.9)
+		return false;
+
+	if (s <= 3.778281340)
+	{
+		// saturated liquid line, region 1 & 3a
+		double h_liq = 1700. * POLYNOMIAL(h1_s_coeffs,
+				sigma - 1.09, sigma + 0.366E-4);
+
+		if (h < h_liq)
+			return false;
+
+		if (s >= 3.397782955)
+		{
+			double h_13 = 1700. * POLYNOMIAL(hB13_s_coeffs,
+					sigma - 0.884, sigma - 0.864);
+
+			if (h > h_13)
+			{
+				double p = p3_hs(h, s);
+				double T, v;
+
+				region3_ps(p, s, T, v);
+				out = region3_point(1. / v, T);
+				return p <= p_max;
+			}
+		}
+
+		double p = p1_hs(h, s);
+		double T = T1_ps(p, s);
+
+		out = gibbs_point(Region::R1, p, T);
+		return p >= p_min && p <= p_max && T >= T_min;
+	}
+	else if (s <= s_c)
+	{
+		double h_liq = 1700. * POLYNOMIAL(h3a_s_coeffs,
+				sigma - 1.09, sigma + 0.366E-4);
+
+		if (h < h_liq)
+			return false;
+
+		double p = p3_hs(h, s);
+		double T, v;
+
+		region3_ps(p, s, T, v);
+		out = region3_point(1. / v, T);
+		return p <= p_max;
+	}
+
+	double h_vap;
+	bool region3 = false;
+
+	if (s < 5.85)
+	{
+		sigma = s / 5.9;
+		h_vap = 2800. * std::pow(POLYNOMIAL(h2c3b_s_coeffs,
+					sigma - 1.02, sigma - 0.726), 4);
+
+		// the B23 boundary
+		if (s < 5.048096828)
+			region3 = true;
+		else if (s <= 5.260578707)
+		{
+			if (h < 2.563592004E3)
+				region3 = true;
+			else if (h <= 2.812942061E3)
+			{
+				double T_23 = 900. * POLYNOMIAL(TB23_hs_coeffs,
+						h / 3000. - 0.727, s / 5.3 - 0.864);
+
+				region3 = p2_hs(h, s) > if97::pB23(T_23);
+			}
+		}
+	}
+	else
+		h_vap = 2800. * std::exp(POLYNOMIAL(h2ab_s_coeffs,
+					5.21 / s - 0.513, s / 9.2 - 0.524));
+
+	if (h < h_vap && s <= 9.155759395)
+	{
+		// Tsat(h,s) is valid above s''(623.15 K) only
+		if (s < 5.210887825)
+			return false;
+
+		double T = Tsat_hs(h, s);
+
+		if (T < T_min || T > T_13)
+			return false;
+
+		out = two_phase(if97::psat(T), T, s, HS);
+		return out.x > 0. && out.x < 1.;
+	}
+
+	if (region3)
+	{
+		double p = p3_hs(h, s);
+		double T, v;
+
+		region3_ps(p, s, T, v);
+		out = region3_point(1. / v, T);
+		return p <= p_max;
+	}
+
+	double p = p2_hs(h, s);
+	double T = T2_ps(p, s);
+
+	out = gibbs_point(Region::R2, p, T);
+	return p > 0. && p <= p_max && T <= T_25;
+}
+
+/**
+ * Get the state point from (p,T). Only region 3 involves a backward
+ * equation, the remaining regions are formulated in (p,T) already.
+ */
+static bool fast_pT(double p, double T, Point& out)
+{
+	if (p <= 0. || p > p_max || T < T_min || T > T_max)
+		out = gibbs_point(Region::OOR, p, T);
+	else if (T <= T_13)
+		out = gibbs_point(p >= if97::psat(T) ? Region::R1 : Region::R2, p, T);
+	else if (T <= T_25 && p > if97::pB23(T))
+		out = region3_point(1. / v3_pT(p, T), T);
+	else if (T <= T_25)
+		out = gibbs_point(Region::R2, p, T);
+	else if (p <= p_5)
+		out = gibbs_point(Region::R5, p, T);
+	else
+		out = gibbs_point(Region::OOR, p, T);
+
+	return true;
+}
+
+/**
+ * Get the region of a single-phase state point from (p,T).
+ */
+static Region region_of(double p, double T)
+{
+	if (!(p > 0. && p <= p_max && T >= T_min && T <= T_max))
+		return Region::OOR;
+	else if (T <= T_13)
+		return p >= if97::psat(T) ? Region::R1 : Region::R2;
+	else if (T <= T_25)
+		return p > if97::pB23(T) ? Region::R3 : Region::R2;
+	else if (p <= p_5)
+		return Region::R5;
+	return Region::OOR;
+}
+
+namespace
+{
+	/**
+	 * A saturated phase, along with the derivatives of its v and u
+	 * along the saturation line.
+	 */
+	struct SaturatedPhase
+	{
+		double v, u;
+		double dvdT, dudT;
+	};
+}
+
+static void saturated_phase(double p, double T, double dpdT,
+		const PropertySet& ps, const if97::VolumeDerivatives& dv,
+		SaturatedPhase& out)
+{
+	// du = (cp - p (dv/dT)_p) dT - (T (dv/dT)_p + p (dv/dp)_T) dp
+	double dudT = ps.cp - p * dv.dvdT * 1000.;
+	double dudp = -(T * dv.dvdT + p * dv.dvdp) * 1000.;
+
+	out.v = ps.v;
+	out.u = ps.u;
+	out.dvdT = dv.dvdT + dv.dvdp * dpdT;
+	out.dudT = dudT + dudp * dpdT;
+}
+
+// the auxiliary equations for the saturated liquid and vapour densities
+// (IAPWS SR1-86), as (exponent * 3 or 6, coefficient)
+static const double rho_liq_coeffs[][2] =
+{
+	{ 1., 1.99274064 },
+	{ 2., 1.09965342 },
+	{ 5., -0.510839303 },
+	{ 16., -1.75493479 },
+	{ 43., -45.5170352 },
+	{ 110., -6.74694450E5 }
+};
+
+static const double rho_vap_coeffs[][2] =
+{
+	{ 2., -2.03150240 },
+	{ 4., -2.68302940 },
+	{ 8., -5.38626492 },
+	{ 18., -17.2991605 },
+	{ 37., -44.7586581 },
+	{ 71., -63.9201063 }
+};
+
+/**
+ * Get the density of a saturated phase at @T from the auxiliary
+ * equations, and store its logarithmic derivative d(ln rho)/dT
+ * in @dlnrho.
+ */
+static double auxiliary_density(double T, bool vapour, double& dlnrho)
+{
+	double tau = 1. - T / T_c;
+	double sum = 0., dsum = 0.;
+
+	for (size_t i = 0; i < COUNT(rho_liq_coeffs); ++i)
+	{
+		const double* c = vapour ? rho_vap_coeffs[i] : rho_liq_coeffs[i];
+		double e = c[0] / (vapour ? 6. : 3.);
+		double term = c[1] * std::pow(tau, e);
+
+		sum += term;
+		dsum += term * e / tau;
+	}
+
+	// dtau/dT = -1/T_c
+	if (vapour)
+	{
+		dlnrho = -dsum / T_c;
+		return rho_c * std::exp(sum);
+	}
+
+	dlnrho = -dsum / T_c / (1. + sum);
+	return rho_c * (1. + sum);
+}
+
+/**
+ * Get the density of a saturated phase in region 3 at (@p, @T),
+ * by Newton iteration on the region 3 equation for p(rho,T) = psat(T),
+ * starting from the auxiliary equations.
+ */
+static double saturated_density(double p, double T, bool vapour)
+{
+	double dlnrho;
+	double rho = auxiliary_density(T, vapour, dlnrho);
+
+	for (int i = 0; i < max_iterations; ++i)
+	{
+		PropertySet ps;
+		if97::VolumeDerivatives dv;
+
+		if97::region3(rho, T, ps, dv);
+
+		double next = 1. / (1. / rho + (p - ps.p) * dv.dvdp);
+		bool done = std::fabs(next - rho) <= step_tolerance * rho;
+
+		rho = next;
+		if (done)
+			break;
+	}
+
+	return rho;
+}
+
+/**
+ * Evaluate both saturated phases at @T. Above 623.15 K, they are
+ * in region 3.
+ */
+static void saturated(double T, SaturatedPhase& liq, SaturatedPhase& vap)
+{
+	double p = if97::psat(T);
+	double dpdT = if97::dpsat_dT(T);
+	PropertySet ps;
+	if97::VolumeDerivatives dv;
+
+	if (T <= T_13)
+	{
+		if97::region1(p, T, ps, dv);
+		saturated_phase(p, T, dpdT, ps, dv, liq);
+		if97::region2(p, T, ps, dv);
+		saturated_phase(p, T, dpdT, ps, dv, vap);
+	}
+	else
+	{
+		if97::region3(saturated_density(p, T, false), T, ps, dv);
+		saturated_phase(p, T, dpdT, ps, dv, liq);
+		if97::region3(saturated_density(p, T, true), T, ps, dv);
+		saturated_phase(p, T, dpdT, ps, dv, vap);
+	}
+}
+
+/**
+ * Evaluate a single saturated phase at @T.
+ */
+static void saturated(double T, bool vapour, SaturatedPhase& out)
+{
+	double p = if97::psat(T);
+	PropertySet ps;
+	if97::VolumeDerivatives dv;
+
+	if (T > T_13)
+		if97::region3(saturated_density(p, T, vapour), T, ps, dv);
+	else if (vapour)
+		if97::region2(p, T, ps, dv);
+	else
+		if97::region1(p, T, ps, dv);
+	saturated_phase(p, T, if97::dpsat_dT(T), ps, dv, out);
+}
+
+/**
+ * Evaluate the two-phase mixture with specific volume @v at @T. Returns
+ * its dryness (which may be outside [0,1] if @v is outside the dome),
+ * and stores its u - @u in @f and the derivative along the isochore
+ * in @dfdT. @dxdT is set to the derivative of the dryness.
+ */
+static double two_phase_vu(double T, double v, double u, double& f,
+		double& dfdT, double& dxdT)
+{
+	SaturatedPhase liq, vap;
+
+	saturated(T, liq, vap);
+
+	double dv = vap.v - liq.v;
+	double x = (v - liq.v) / dv;
+
+	dxdT = -(liq.dvdT + x * (vap.dvdT - liq.dvdT)) / dv;
+	f = liq.u + x * (vap.u - liq.u) - u;
+	dfdT = liq.dudT + x * (vap.dudT - liq.dudT) + dxdT * (vap.u - liq.u);
+	return x;
+}
+
+/**
+ * Perform a Newton step on the basic equations, towards the state
+ * point with the given values of the independent variables.
+ *
+ * Returns the relative size of the step, or 0 if the state point can
+ * not be refined any further.
+ */
+static double newton_step(Point& pt, target_type target, double y1, double y2)
+{
+	PropertySet ps;
+	if97::VolumeDerivatives dv;
+
+	// (p,T) are exact outside region 3, and (rho,T) in region 3
+	if (target == PT && pt.region != Region::R3)
+		return 0.;
+	if (target == RHOT && pt.region == Region::R3)
+	{
+		pt.rho = y1;
+		pt.T = y2;
+		return 0.;
+	}
+	// (rho,u) is a one-dimensional problem in T in regions 3 and 4
+	if (target == RHOU && pt.region == Region::R3)
+	{
+		pt.rho = y1;
+		if97::region3(pt.rho, pt.T, ps);
+		pt.p = ps.p;
+
+		double dT = (y2 - ps.u) / ps.cv;
+
+		pt.T += dT;
+		return std::fabs(dT) / pt.T;
+	}
+	if (target == RHOU && pt.region == Region::R4)
+	{
+		double f, dfdT, dxdT;
+		double x = two_phase_vu(pt.T, 1. / y1, y2, f, dfdT, dxdT);
+		double T = std::min(std::max(pt.T - f / dfdT, T_min), T_dome);
+		double dT = T - pt.T;
+
+		// the dryness is linearized, which is exact to the second
+		// order like the step itself
+		pt = region4_point(if97::psat(T), T, x + dxdT * dT);
+		return std::fabs(dT) / T;
+	}
+
+	switch (pt.region)
+	{
+		case Region::R1:
+			if97::region1(pt.p, pt.T, ps, dv);
+			break;
+		case Region::R2:
+			if97::region2(pt.p, pt.T, ps, dv);
+			break;
+		case Region::R3:
+			if97::region3(pt.rho, pt.T, ps, dv);
+			pt.p = ps.p;
+			break;
+		case Region::R5:
+			if97::region5(pt.p, pt.T, ps, dv);
+			break;
+		case Region::R4:
+		{
+			// T and x are exact for (p,h) & (p,s); for (h,s) move
+			// along the isentrope, where dh = v dp
+			if (target != HS || pt.T > T_13)
+				return 0.;
+
+			PropertySet liq, vap;
+
+			if97::region1(pt.p, pt.T, liq);
+			if97::region2(pt.p, pt.T, vap);
+
+			double x = (y2 - liq.s) / (vap.s - liq.s);
+			double h = liq.h + x * (vap.h - liq.h);
+			double v = liq.v + x * (vap.v - liq.v);
+			// Clausius-Clapeyron; the unit factors cancel out
+			double dpdT = (vap.s - liq.s) / (vap.v - liq.v);
+			double dT = (y1 - h) / (v * dpdT);
+
+			pt.T = std::min(std::max(pt.T + dT, T_min), T_13);
+			pt.p = if97::psat(pt.T);
+			pt = two_phase(pt.p, pt.T, y2, HS);
+			return std::fabs(dT) / pt.T;
+		}
+		default:
+			assert(not_reached);
+	}
+
+	double dp, dT;
+
+	// dh = cp dT + (v - T (dv/dT)_p) dp
+	// ds = cp / T dT - (dv/dT)_p dp
+	switch (target)
+	{
+		case PH:
+			dp = y1 - pt.p;
+			dT = (y2 - ps.h - (ps.v - pt.T * dv.dvdT) * dp * 1000.) / ps.cp;
+			break;
+		case PS:
+			dp = y1 - pt.p;
+			dT = pt.T * (y2 - ps.s + dv.dvdT * dp * 1000.) / ps.cp;
+			break;
+		case HS:
+			// dh - T ds = v dp
+			dp = (y1 - ps.h - pt.T * (y2 - ps.s)) / (ps.v * 1000.);
+			dT = pt.T * (y2 - ps.s + dv.dvdT * dp * 1000.) / ps.cp;
+			break;
+		case PT:
+			dp = y1 - pt.p;
+			dT = 0.;
+			break;
+		case RHOT:
+			// dv = (dv/dT)_p dT + (dv/dp)_T dp
+			dT = y2 - pt.T;
+			dp = (1. / y1 - ps.v - dv.dvdT * dT) / dv.dvdp;
+			break;
+		case RHOU:
+		{
+			// dv as above, and du as in saturated_phase()
+			double dudT = ps.cp - pt.p * dv.dvdT * 1000.;
+			double dudp = -(pt.T * dv.dvdT + pt.p * dv.dvdp) * 1000.;
+			double det = dv.dvdT * dudp - dv.dvdp * dudT;
+			double dv_ = 1. / y1 - ps.v;
+			double du = y2 - ps.u;
+
+			dT = (dv_ * dudp - dv.dvdp * du) / det;
+			dp = (dv.dvdT * du - dudT * dv_) / det;
+
+			// keep far-off starting points within the physical range
+			dT = std::max(dT, -pt.T / 2.);
+			dp = std::max(dp, -pt.p * 0.9);
+			break;
+		}
+		default:
+			assert(not_reached);
+			return 0.;
+	}
+
+	pt.T += dT;
+	if (pt.region == Region::R3)
+		pt.rho = 1. / (ps.v + dv.dvdT * dT + dv.dvdp * dp);
+	else
+		pt.p += dp;
+
+	// the pressure of a liquid is determined by (rho,u) only as well
+	// as the compressibility allows
+	if (target == RHOU)
+		return std::max(std::fabs(dT) / pt.T,
+				std::fabs(dv.dvdp * dp / ps.v));
+	return std::max(std::fabs(dT) / pt.T, std::fabs(dp / pt.p));
+}
+
+/**
+ * Find the two-phase state point with the given (rho,u), by Newton
+ * iteration on T along the isochore, safeguarded by bisection.
+ *
+ * Returns false if there is no solution in the two-phase temperature
+ * range, up to @T_hi. Otherwise, the state point is two-phase if its dryness
+ * is within [0,1], and close to the saturation line if it is not.
+ */
+static bool two_phase_rhou(double rho, double u, double T_hi,
+		Point& out, int& iterations)
+{
+	double v = 1. / rho;
+
+	if (v < v_dome_min || v > v_dome_max || u > u_dome_max)
+		return false;
+
+	// u(T) along the isochore is increasing
+	double lo = T_min, hi = T_hi;
+	double T = (lo + hi) / 2.;
+
+	for (int i = 0; i < 3 * max_iterations; ++i)
+	{
+		double f, dfdT, dxdT;
+		double x = two_phase_vu(T, v, u, f, dfdT, dxdT);
+
+		++iterations;
+		if (f > 0.)
+			hi = T;
+		else
+			lo = T;
+
+		double next = T - f / dfdT;
+
+		if (std::fabs(next - T) <= step_tolerance * T)
+		{
+			out = region4_point(if97::psat(next), next,
+					x + dxdT * (next - T));
+			return true;
+		}
+		else if (!(next > lo && next < hi))
+		{
+			if (hi - lo <= step_tolerance * T)
+				return false;
+
+			// try the range limits first, so that the states
+			// with no solution are rejected quickly
+			if (next >= hi && hi == T_hi && T != T_hi)
+				next = T_hi;
+			else if (next <= lo && lo == T_min && T != T_min)
+				next = T_min;
+			else
+				next = (lo + hi) / 2.;
+		}
+
+		T = next;
+	}
+
+	return false;
+}
+
+namespace
+{
+	typedef enum
+	{
+		PHASE_UNKNOWN,
+		SINGLE_PHASE,
+		TWO_PHASE
+	} phase_type;
+}
+
+/**
+ * Tell whether the (rho,u) state point is two-phase, without iterating
+ * through the dome. Along the isochore, u increases with T, so the state
+ * point is two-phase if u is below the saturated u where the isochore
+ * meets the saturation line. That temperature is estimated using
+ * the auxiliary density equations, and refined by Newton steps
+ * on the saturated phase (counted in @iterations).
+ *
+ * Returns PHASE_UNKNOWN if the state point is too close
+ * to the saturation line, or to the critical point, to tell.
+ * For the two-phase state points, @T_sat is set to the temperature
+ * at which the isochore leaves the dome.
+ */
+static phase_type screen_rhou(double rho, double u, double& T_sat,
+		int& iterations)
+{
+	double v = 1. / rho;
+
+	if (v < v_dome_min || v > v_dome_max || u > u_dome_max)
+		return SINGLE_PHASE;
+	if (v < v_screen_min)
+		return PHASE_UNKNOWN;
+
+	// rho' decreases and rho'' increases with T
+	bool vapour = v > v_c;
+	double lo = T_min, hi = T_screen;
+	double T = (lo + hi) / 2.;
+
+	for (int i = 0; i < 3 * max_iterations; ++i)
+	{
+		double dlnrho;
+		double f = std::log(auxiliary_density(T, vapour, dlnrho) / rho);
+
+		if ((f > 0.) == vapour)
+			hi = T;
+		else
+			lo = T;
+
+		double next = T - f / dlnrho;
+
+		if (!(next > lo && next < hi))
+			next = (lo + hi) / 2.;
+		if (std::fabs(next - T) <= 1E-4 * T)
+			break;
+		T = next;
+	}
+
+	for (int i = 0; i < 4; ++i)
+	{
+		SaturatedPhase sat;
+
+		if (!(T > T_min && T < T_screen))
+			break;
+
+		++iterations;
+		saturated(T, vapour, sat);
+
+		double dT = (v - sat.v) / sat.dvdT;
+
+		if (std::fabs(dT) <= 1E-5 * T)
+		{
+			double du = u - (sat.u + sat.dudT * dT);
+
+			if (std::fabs(du) <= u_screen_margin)
+				break;
+			T_sat = T + dT;
+			return du < 0. ? TWO_PHASE : SINGLE_PHASE;
+		}
+
+		T += dT;
+	}
+
+	return PHASE_UNKNOWN;
+}
+
+/**
+ * Move @y to @limit if it is beyond it by rounding errors only.
+ */
+static inline void snap(double& y, double limit, bool upper)
+{
+	if (upper ? y > limit && y <= limit * (1. + 1E-9)
+			: y < limit && y >= limit * (1. - 1E-9))
+		y = limit;
+}
+
+/**
+ * Find the single-phase state point with the given (rho,u), by Newton
+ * iteration, and switching the region whenever the iteration leaves
+ * it. The iteration starts at @sat (the solution of two_phase_rhou(),
+ * close to the saturation line) if specified, and at a rough estimate
+ * otherwise.
+ */
+static Point single_phase_rhou(double rho, double u, const Point* sat,
+		int& iterations)
+{
+	double v = 1. / rho;
+	Point pt;
+
+	if (sat)
+	{
+		if (sat->T > T_13)
+			pt = region3_point(rho, sat->T);
+		else
+			pt = gibbs_point(sat->x < 0. ? Region::R1 : Region::R2,
+					sat->p, sat->T);
+	}
+	else if (v < v_c && u < u_13)
+	{
+		// liquid-like: u(T_min) = 0, cv ~ 4.2 kJ/kgK
+		double T = std::min(T_min + std::max(u, 0.) / 4.2, T_13);
+
+		pt = gibbs_point(Region::R1, std::max(if97::psat(T), p_min), T);
+	}
+	else if (rho > rho_dense)
+	{
+		// the region 3 equation (one-dimensional in T) extrapolates
+		// well into the adjacent parts of regions 1 and 2, so it gives
+		// good starting points for them as well
+		pt = region3_point(rho, (T_13 + T_25) / 2.);
+	}
+	else
+	{
+		// gas-like: u''(T_min) ~ 2375 kJ/kg, cv ~ 1.5 kJ/kgK,
+		// and the ideal gas law
+		double T = std::min(std::max(T_min + (u - 2375.) / 1.5, T_min),
+				T_max);
+
+		// the estimate for dense vapour can fall far below
+		// the saturation line, where region 2 extrapolates poorly
+		for (int i = 0; i < 3 && R * T / v / 1000. < p_c; ++i)
+			T = std::max(T, if97::Tsat(R * T / v / 1000.));
+
+		double p = R * T / v / 1000.;
+
+		// (a liquid at this point would be far off)
+		if (region_of(p, T) == Region::R3)
+			pt = region3_point(rho, T);
+		else
+			pt = gibbs_point(T > T_25 ? Region::R5 : Region::R2, p, T);
+	}
+
+	// the iteration can cross each region boundary once
+	for (int i = 0; i < 4; ++i)
+	{
+		bool converged = false;
+
+		for (int j = 0; j < max_iterations && !converged; ++j)
+		{
+			++iterations;
+			converged = newton_step(pt, RHOU, rho, u) <= step_tolerance;
+		}
+
+		snap(pt.p, p_max, true);
+		snap(pt.T, T_max, true);
+		snap(pt.T, T_min, false);
+
+		Region r = region_of(pt.p, pt.T);
+
+		if (r == pt.region)
+			return converged ? pt : gibbs_point(Region::OOR, 0., 0.);
+		// the saturated states can fall on either side
+		else if (converged && pt.T <= T_13 && r != Region::OOR
+				&& std::fabs(pt.p - if97::psat(pt.T)) <= 1E-9 * pt.p)
+			return region4_point(if97::psat(pt.T), pt.T,
+					pt.region == Region::R1 ? 0. : 1.);
+
+		// continue in the region of the nearest in-range point,
+		// the equations extrapolate well enough
+		double T = std::min(std::max(pt.T, T_min), T_max);
+
+		r = region_of(std::min(pt.p, T > T_25 ? p_5 : p_max), T);
+		if (r == pt.region || r == Region::OOR)
+			break;
+		else if (r == Region::R3)
+			pt = region3_point(rho, pt.T);
+		else
+			pt = gibbs_point(r, pt.p, pt.T);
+	}
+
+	return gibbs_point(Region::OOR, 0., 0.);
+}
+
+/**
+ * Get the state point from (rho,u). There are no backward equations
+ * for (rho,u), so the state points which can not be screened out
+ * as single-phase are checked for the two-phase region first, and then
+ * the single-phase state point is iterated.
+ */
+static Point solve_rhou(double rho, double u, int& iterations)
+{
+	Point pt;
+
+	iterations = 0;
+	if (!(rho > 0.))
+		return gibbs_point(Region::OOR, 0., 0.);
+	// the two-phase state points are below the saturation temperature
+	// of the isochore, if known
+	double T_sat = T_dome;
+
+	if (screen_rhou(rho, u, T_sat, iterations) == SINGLE_PHASE
+			|| !two_phase_rhou(rho, u, T_sat, pt, iterations))
+		return single_phase_rhou(rho, u, 0, iterations);
+	else if (pt.x < 0. || pt.x > 1.)
+		return single_phase_rhou(rho, u, &pt, iterations);
+	return pt;
+}
+
+/**
+ * Get the state point for the given target, and store the number
+ * of Newton steps performed in @iterations.
+ */
+static H2O solve(target_type target, double y1, double y2, mode_type mode,
+		int& iterations)
+{
+	Point pt;
+	bool native;
+
+	if (target == RHOU)
+		return to_state(solve_rhou(y1, y2, iterations));
+
+	switch (target)
+	{
+		case HS:
+			native = fast_hs(y1, y2, pt);
+			break;
+		case PT:
+			native = fast_pT(y1, y2, pt);
+			break;
+		case RHOT:
+			// there are no backward equations for (rho,T)
+			native = false;
+			break;
+		default:
+			native = fast_py(y1, y2, target, pt);
+	}
+
+	if (!native)
+	{
+		switch (target)
+		{
+			case PH:
+				pt = from_state(H2O::ph(y1, y2));
+				break;
+			case PS:
+				pt = from_state(H2O::ps(y1, y2));
+				break;
+			case HS:
+				pt = from_state(H2O::hs(y1, y2));
+				break;
+			case RHOT:
+				pt = from_state(H2O::rhoT(y1, y2));
+				break;
+			default:
+				assert(not_reached);
+		}
+	}
+
+	if (pt.region == Region::OOR)
+		out_of_range();
+
+	iterations = 0;
+	if (mode != FAST)
+	{
+		int steps = mode == EXACT ? max_iterations : 1;
+
+		while (iterations < steps)
+		{
+			++iterations;
+			if (newton_step(pt, target, y1, y2) <= step_tolerance)
+				break;
+		}
+	}
+
+	if (target == PT && pt.region == Region::R3)
+		pt.p = y1;
+	return to_state(pt);
+}
+
+static H2O solve(target_type target, double y1, double y2, mode_type mode)
+{
+	int iterations;
+	H2O ret = solve(target, y1, y2, mode, iterations);
+
+	H2O_RECORD_ITERATIONS(iterations);
+	return ret;
+}
+
+/**
+ * Check whether a state point lies within its region. Subcritical
+ * region 3 state points are never accepted, since they could be
+ * two-phase.
+ */
+static bool in_region(const Point& pt)
+{
+	switch (pt.region)
+	{
+		case Region::R1:
+			return pt.T >= T_min && pt.T <= T_13
+				&& pt.p <= p_max && pt.p >= if97::psat(pt.T);
+		case Region::R2:
+			if (pt.p <= 0. || pt.T < T_min || pt.T > T_25)
+				return false;
+			else if (pt.T <= T_13)
+				return pt.p <= if97::psat(pt.T);
+			return pt.p <= if97::pB23(pt.T);
+		case Region::R3:
+			return pt.p >= p_c && pt.p <= p_max && pt.T > T_13
+				&& pt.p > if97::pB23(pt.T);
+		case Region::R5:
+			return pt.p > 0. && pt.p <= p_5
+				&& pt.T >= T_25 && pt.T <= T_max;
+		default:
+			return false;
+	}
+}
+
+/**
+ * Check whether a state point lies within its region, as above.
+ * For (rho,u), the two-phase state points are accepted as well, since
+ * the iteration determines their dryness.
+ */
+static bool in_region(const Point& pt, target_type target)
+{
+	if (target == RHOU && pt.region == Region::R4)
+		return pt.T >= T_min && pt.T <= T_dome
+			&& pt.x >= 0. && pt.x <= 1.;
+	return in_region(pt);
+}
+
+/**
+ * Get the state point by Newton iteration starting at @hint,
+ * and store the number of Newton steps performed in @iterations.
+ * @warm is set to whether the iteration converged from the hint.
+ *
+ * If the hint is unusable, or the iteration does not converge within
+ * the region of the hint, falls back to solve() in EXACT mode.
+ */
+static H2O warm_solve(target_type target, double y1, double y2,
+		const H2O& hint, int& iterations, bool& warm)
+{
+	iterations = 0;
+	warm = false;
+	Point pt = hint.initialized() ? from_state(hint)
+		: gibbs_point(Region::OOR, 0., 0.);
+
+	if (in_region(pt, target))
+	{
+		while (iterations < max_iterations)
+		{
+			++iterations;
+			if (newton_step(pt, target, y1, y2) <= warm_step_tolerance)
+			{
+				if (in_region(pt, target))
+				{
+					warm = true;
+					return to_state(pt);
+				}
+				break;
+			}
+		}
+	}
+
+	int cold_iterations;
+	H2O ret = solve(target, y1, y2, EXACT, cold_iterations);
+
+	iterations += cold_iterations;
+	return ret;
+}
+
+H2O backward::ph(double p, double h, mode_type mode)
+{
+	return solve(PH, p, h, mode);
+}
+
+H2O backward::ps(double p, double s, mode_type mode)
+{
+	return solve(PS, p, s, mode);
+}
+
+H2O backward::hs(double h, double s, mode_type mode)
+{
+	return solve(HS, h, s, mode);
+}
+
+H2O backward::pT(double p, double T, mode_type mode)
+{
+	return solve(PT, p, T, mode);
+}
+
+H2O backward::ph(double p, double h, const H2O& hint)
+{
+	int iterations;
+	bool warm;
+	H2O ret = warm_solve(PH, p, h, hint, iterations, warm);
+
+	H2O_RECORD_ITERATIONS(iterations);
+	return ret;
+}
+
+H2O backward::ps(double p, double s, const H2O& hint)
+{
+	int iterations;
+	bool warm;
+	H2O ret = warm_solve(PS, p, s, hint, iterations, warm);
+
+	H2O_RECORD_ITERATIONS(iterations);
+	return ret;
+}
+
+H2O backward::hs(double h, double s, const H2O& hint)
+{
+	int iterations;
+	bool warm;
+	H2O ret = warm_solve(HS, h, s, hint, iterations, warm);
+
+	H2O_RECORD_ITERATIONS(iterations);
+	return ret;
+}
+
+H2O backward::rhou(double rho, double u)
+{
+	int iterations;
+	H2O ret = to_state(solve_rhou(rho, u, iterations));
+
+	H2O_RECORD_ITERATIONS(iterations);
+	return ret;
+}
+
+H2O backward::try_rhou(double rho, double u) noexcept
+{
+	int iterations;
+	H2O ret = try_to_state(solve_rhou(rho, u, iterations));
+
+	H2O_RECORD_ITERATIONS(iterations);
+	return ret;
+}
+
+H2O backward::rhou(double rho, double u, const H2O& hint)
+{
+	int iterations;
+	bool warm;
+	H2O ret = warm_solve(RHOU, rho, u, hint, iterations, warm);
+
+	H2O_RECORD_ITERATIONS(iterations);
+	return ret;
+}
+
+H2O backward::rhoT(double rho, double T, const H2O& hint)
+{
+	int iterations;
+	bool warm;
+	H2O ret = warm_solve(RHOT, rho, T, hint, iterations, warm);
+
+	H2O_RECORD_ITERATIONS(iterations);
+	return ret;
+}
+
+WarmStart::WarmStart()
+	: _iterations(0), _warm(false)
+{
+}
+
+WarmStart::WarmStart(const H2O& initial)
+	: _state(initial), _iterations(0), _warm(false)
+{
+}
+
+const H2O& WarmStart::solve(int target, double y1, double y2)
+{
+	int iterations;
+	bool warm;
+	// (keep the previous state if this one is out-of-range)
+	H2O next = warm_solve(static_cast<target_type>(target), y1, y2,
+			_state, iterations, warm);
+
+	H2O_RECORD_ITERATIONS(iterations);
+	_state = next;
+	_iterations = iterations;
+	_warm = warm;
+	return _state;
+}
+
+const H2O& WarmStart::ph(double p, double h)
+{
+	return solve(PH, p, h);
+}
+
+const H2O& WarmStart::ps(double p, double s)
+{
+	return solve(PS, p, s);
+}
+
+const H2O& WarmStart::hs(double h, double s)
+{
+	return solve(HS, h, s);
+}
+
+const H2O& WarmStart::rhoT(double rho, double T)
+{
+	return solve(RHOT, rho, T);
+}
+
+const H2O& WarmStart::rhou(double rho, double u)
+{
+	return solve(RHOU, rho, u);
+}
+
+const H2O& WarmStart::state() const
+{
+	return _state;
+}
+
+int WarmStart::iterations() const
+{
+	return _iterations;
+}
+
+bool WarmStart::warm() const
+{
+	return _warm;
+}
+
+H2O backward::expand(const H2O& in, double pout, double eta,
+		mode_type mode)
+{
+	if (in.region() == Region::R5)
+		throw std::range_error("Expansion not supported in region 5");
+
+	H2O ideal = backward::ps(pout, in.s(), mode);
+
+	if (eta == 1.)
+		return ideal;
+
+	double hin = in.h();
+	double hout = hin - (hin - ideal.h()) * eta;
+
+	return backward::ph(pout, hout, mode);
+}
+
+H2O backward::expand(const H2O& in, double pout, double eta,
+		const H2O& hint)
+{
+	if (in.region() == Region::R5)
+		throw std::range_error("Expansion not supported in region 5");
+
+	H2O ideal = backward::ps(pout, in.s(), hint);
+
+	if (eta == 1.)
+		return ideal;
+
+	double hin = in.h();
+	double hout = hin - (hin - ideal.h()) * eta;
+
+	return backward::ph(pout, hout, ideal);
+}
+
+static Deviation check(target_type target, double y1, double y2,
+		mode_type mode)
+{
+	Deviation ret;
+
+	ret.state = solve(target, y1, y2, mode);
+	ret.exact = solve(target, y1, y2, EXACT, ret.iterations);
+
+	ret.dT = ret.state.T() - ret.exact.T();
+	ret.dp = ret.state.p() - ret.exact.p();
+	ret.dv = ret.state.v() / ret.exact.v() - 1.;
+
+	return ret;
+}
+
+Deviation backward::check_ph(double p, double h, mode_type mode)
+{
+	return check(PH, p, h, mode);
+}
+
+Deviation backward::check_ps(double p, double s, mode_type mode)
+{
+	return check(PS, p, s, mode);
+}
+
+Deviation backward::check_hs(double h, double s, mode_type mode)
+{
+	return check(HS, h, s, mode);
+}
+
+Deviation backward::check_pT(double p, double T, mode_type mode)
+{
+	return check(PT, p, T, mode);
+}
@@ -0,0 +1,281 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+
+#include "batch.hxx"
+#include "if97.hxx"
+#include "simd.hxx"
+
+using namespace h2o;
+using namespace h2o::batch;
+
+static const double nan_value = std::numeric_limits<double>::quiet_NaN();
+
+H2OArray::H2OArray()
+{
+}
+
+H2OArray::H2OArray(size_t n)
+{
+	resize(n);
+}
+
+size_t H2OArray::size() const
+{
+	return region.size();
+}
+
+void H2OArray::resize(size_t n)
+{
+	region.resize(n, Region::OOR);
+
+	p.resize(n, nan_value);
+	T.resize(n, nan_value);
+	x.resize(n, nan_value);
+	rho.resize(n, nan_value);
+
+	v.resize(n, nan_value);
+	u.resize(n, nan_value);
+	h.resize(n, nan_value);
+	s.resize(n, nan_value);
+	cp.resize(n, nan_value);
+	cv.resize(n, nan_value);
+	w.resize(n, nan_value);
+}
+
+H2O H2OArray::at(size_t i) const
+{
+	assert(i < size());
+
+	switch (region[i])
+	{
+		case Region::R3:
+			return H2O::rhoT(rho[i], T[i]);
+		case Region::R4:
+			return H2O::px(p[i], x[i]);
+		case Region::OOR:
+			throw std::range_error("Requested parameters out-of-range.");
+		default:
+			return H2O::pT(p[i], T[i]);
+	}
+}
+
+View::View(const double* data, size_t size, ptrdiff_t stride)
+	: _data(data), _size(size), _stride(stride)
+{
+}
+
+View::View(const std::vector<double>& data)
+	: _data(data.empty() ? 0 : &data[0]), _size(data.size()), _stride(1)
+{
+}
+
+View::View(const double& value, size_t size)
+	: _data(&value), _size(size), _stride(0)
+{
+}
+
+size_t View::size() const
+{
+	return _size;
+}
+
+// columns that are obtained directly from the libh2o state
+static const unsigned fused_columns = H2OArray::COL_P | H2OArray::COL_T
+	| H2OArray::COL_X | H2OArray::COL_RHO;
+
+static inline void store(H2OArray& out, size_t i,
+		const internals::h2o_t& st, unsigned columns)
+{
+	Region r = st.region;
+
+	out.region[i] = r;
+
+	if (r == Region::OOR)
+	{
+		out.p[i] = out.T[i] = out.x[i] = out.rho[i] = nan_value;
+		out.v[i] = out.u[i] = out.h[i] = out.s[i] = nan_value;
+		out.cp[i] = out.cv[i] = out.w[i] = nan_value;
+		return;
+	}
+
+	// when more than the state is requested, evaluate everything
+	// in one pass rather than calling the particular getters
+	if (columns & ~fused_columns & H2OArray::COL_ALL)
+	{
+		PropertySet ps = if97::properties(st);
+
+		out.p[i] = columns & H2OArray::COL_P ? ps.p : nan_value;
+		out.T[i] = columns & H2OArray::COL_T ? ps.T : nan_value;
+		out.x[i] = columns & H2OArray::COL_X ? ps.x : nan_value;
+		out.rho[i] = columns & H2OArray::COL_RHO ? ps.rho : nan_value;
+
+		out.v[i] = columns & H2OArray::COL_V ? ps.v : nan_value;
+		out.u[i] = columns & H2OArray::COL_U ? ps.u : nan_value;
+		out.h[i] = columns & H2OArray::COL_H ? ps.h : nan_value;
+		out.s[i] = columns & H2OArray::COL_S ? ps.s : nan_value;
+		out.cp[i] = columns & H2OArray::COL_CP ? ps.cp : nan_value;
+		out.cv[i] = columns & H2OArray::COL_CV ? ps.cv : nan_value;
+		out.w[i] = columns & H2OArray::COL_W ? ps.w : nan_value;
+		return;
+	}
+
+	out.p[i] = columns & H2OArray::COL_P ? h2o_get_p(st) : nan_value;
+	out.T[i] = columns & H2OArray::COL_T ? h2o_get_T(st) : nan_value;
+	out.x[i] = columns & H2OArray::COL_X && r != Region::R3
+		? h2o_get_x(st) : nan_value;
+	out.rho[i] = columns & H2OArray::COL_RHO ? h2o_get_rho(st) : nan_value;
+
+	out.v[i] = out.u[i] = out.h[i] = out.s[i] = nan_value;
+	out.cp[i] = out.cv[i] = out.w[i] = nan_value;
+}
+
+namespace
+{
+	/**
+	 * The region 1 or 2 state points waiting for the bulk kernel,
+	 * along with their positions in the output.
+	 */
+	struct Pending
+	{
+		Region region;
+		simd::Block block;
+		size_t index[simd::Block::capacity];
+	};
+}
+
+static void flush(simd::kernel_func_t kernel, Pending& q, H2OArray& out,
+		unsigned columns)
+{
+	simd::Block& b = q.block;
+
+	if (!b.n)
+		return;
+
+	kernel(q.region, b);
+
+	for (size_t j = 0; j < b.n; ++j)
+	{
+		size_t i = q.index[j];
+
+		out.region[i] = q.region;
+
+		out.p[i] = columns & H2OArray::COL_P ? b.p[j] : nan_value;
+		out.T[i] = columns & H2OArray::COL_T ? b.T[j] : nan_value;
+		out.x[i] = columns & H2OArray::COL_X
+			? (q.region == Region::R1 ? 0. : 1.) : nan_value;
+		out.rho[i] = columns & H2OArray::COL_RHO ? b.rho[j] : nan_value;
+
+		out.v[i] = columns & H2OArray::COL_V ? b.v[j] : nan_value;
+		out.u[i] = columns & H2OArray::COL_U ? b.u[j] : nan_value;
+		out.h[i] = columns & H2OArray::COL_H ? b.h[j] : nan_value;
+		out.s[i] = columns & H2OArray::COL_S ? b.s[j] : nan_value;
+		out.cp[i] = columns & H2OArray::COL_CP ? b.cp[j] : nan_value;
+		out.cv[i] = columns & H2OArray::COL_CV ? b.cv[j] : nan_value;
+		out.w[i] = columns & H2OArray::COL_W ? b.w[j] : nan_value;
+	}
+
+	b.n = 0;
+}
+
+size_t batch::construct_range(constructor_func_t f, const View& a,
+		const View& b, H2OArray& out, unsigned columns,
+		size_t begin, size_t end)
+{
+	assert(end <= out.size());
+
+	size_t oor = 0;
+	// the bulk kernels are used only if the properties are requested
+	simd::kernel_func_t kernel = columns & ~fused_columns
+		& H2OArray::COL_ALL ? simd::kernel() : 0;
+	Pending pending[2];
+
+	pending[0].region = Region::R1;
+	pending[0].block.n = 0;
+	pending[1].region = Region::R2;
+	pending[1].block.n = 0;
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		internals::h2o_t st = f(a[i], b[i]);
+
+		if (st.region == internals::H2O_REGION_OUT_OF_RANGE)
+			++oor;
+
+		if (kernel && (st.region == internals::H2O_REGION1
+					|| st.region == internals::H2O_REGION2))
+		{
+			Pending& q = pending[st.region == internals::H2O_REGION2];
+			simd::Block& blk = q.block;
+
+			q.index[blk.n] = i;
+			blk.p[blk.n] = h2o_get_p(st);
+			blk.T[blk.n] = h2o_get_T(st);
+			if (++blk.n == simd::Block::capacity)
+				flush(kernel, q, out, columns);
+		}
+		else
+			store(out, i, st, columns);
+	}
+
+	if (kernel)
+	{
+		flush(kernel, pending[0], out, columns);
+		flush(kernel, pending[1], out, columns);
+	}
+
+	return oor;
+}
+
+static size_t construct(constructor_func_t f, const View& a, const View& b,
+		H2OArray& out, unsigned columns)
+{
+	assert(a.size() == b.size());
+
+	out.resize(a.size());
+	return construct_range(f, a, b, out, columns, 0, a.size());
+}
+
+size_t batch::pT(View p, View T, H2OArray& out, unsigned columns)
+{
+	return construct(internals::h2o_new_pT, p, T, out, columns);
+}
+
+size_t batch::Tx(View T, View x, H2OArray& out, unsigned columns)
+{
+	return construct(internals::h2o_new_Tx, T, x, out, columns);
+}
+
+size_t batch::px(View p, View x, H2OArray& out, unsigned columns)
+{
+	return construct(internals::h2o_new_px, p, x, out, columns);
+}
+
+size_t batch::ph(View p, View h, H2OArray& out, unsigned columns)
+{
+	return construct(internals::h2o_new_ph, p, h, out, columns);
+}
+
+size_t batch::ps(View p, View s, H2OArray& out, unsigned columns)
+{
+	return construct(internals::h2o_new_ps, p, s, out, columns);
+}
+
+size_t batch::hs(View h, View s, H2OArray& out, unsigned columns)
+{
+	return construct(internals::h2o_new_hs, h, s, out, columns);
+}
+
+size_t batch::rhoT(View rho, View T, H2OArray& out, unsigned columns)
+{
+	return construct(internals::h2o_new_rhoT, rho, T, out, columns);
+}
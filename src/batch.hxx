@@ -0,0 +1,36 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#pragma once
+
+#ifndef _H2O_BATCH_INTERNAL_HXX
+#define _H2O_BATCH_INTERNAL_HXX 1
+
+#include "h2o_batch"
+
+namespace h2o
+{
+	namespace batch
+	{
+		typedef internals::h2o_t (*constructor_func_t)(double, double);
+
+		/**
+		 * Construct the state points [@begin, @end) using @f, and store
+		 * them in @out (which must be already large enough). Returns
+		 * the number of out-of-range points.
+		 *
+		 * This is an internal interface, shared with the parallel
+		 * executor. The particular points are independent, so disjoint
+		 * ranges can be processed concurrently.
+		 */
+		size_t construct_range(constructor_func_t f, const View& a,
+				const View& b, H2OArray& out, unsigned columns,
+				size_t begin, size_t end);
+	}
+}
+
+#endif /*_H2O_BATCH_INTERNAL_HXX*/
+
+// vim:ft=cpp
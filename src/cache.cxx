@@ -0,0 +1,308 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include <cassert>
+#include <climits>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "h2o_cache"
+
+using namespace h2o;
+
+static const bool not_reached = false; // for assert()
+
+namespace
+{
+	struct Key
+	{
+		StateCache::constructor_type constr;
+		uint64_t a, b;
+
+		bool operator==(const Key& other) const
+		{
+			return constr == other.constr && a == other.a && b == other.b;
+		}
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key& k) const
+		{
+			uint64_t h = k.a * 0x9E3779B97F4A7C15ULL;
+
+			h ^= k.b + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2);
+			h ^= static_cast<uint64_t>(k.constr) << 59;
+			// finalizer from splitmix64
+			h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+			return static_cast<size_t>(h ^ (h >> 31));
+		}
+	};
+
+	struct Slot
+	{
+		Key key;
+		StateCache::Entry entry;
+		bool used;
+		bool referenced;
+	};
+}
+
+struct StateCache::Shard
+{
+	std::mutex lock;
+	std::unordered_map<Key, size_t, KeyHash> index;
+	std::vector<Slot> slots;
+	size_t hand;
+
+	uint64_t hits;
+	uint64_t misses;
+
+	void reset()
+	{
+		index.clear();
+		for (size_t i = 0; i < slots.size(); ++i)
+			slots[i].used = false;
+		hand = 0;
+		hits = 0;
+		misses = 0;
+	}
+
+	// pick a slot to overwrite, using the CLOCK algorithm
+	size_t victim()
+	{
+		while (slots[hand].used && slots[hand].referenced)
+		{
+			slots[hand].referenced = false;
+			hand = (hand + 1) % slots.size();
+		}
+
+		size_t ret = hand;
+		hand = (hand + 1) % slots.size();
+		return ret;
+	}
+};
+
+static inline uint64_t bits(double x)
+{
+	uint64_t ret;
+
+	std::memcpy(&ret, &x, sizeof(ret));
+	return ret;
+}
+
+static H2O construct(StateCache::constructor_type constr, double a, double b)
+{
+	switch (constr)
+	{
+		case StateCache::PT:
+			return H2O::pT(a, b);
+		case StateCache::TX:
+			return H2O::Tx(a, b);
+		case StateCache::PX:
+			return H2O::px(a, b);
+		case StateCache::PH:
+			return H2O::ph(a, b);
+		case StateCache::PS:
+			return H2O::ps(a, b);
+		case StateCache::HS:
+			return H2O::hs(a, b);
+		case StateCache::RHOT:
+			return H2O::rhoT(a, b);
+	}
+
+	assert(not_reached);
+	return H2O();
+}
+
+StateCache::StateCache(size_t capacity, size_t shards)
+{
+	assert(capacity > 0);
+	assert(shards > 0);
+
+	// every shard needs at least one slot
+	_shard_count = 1;
+	while (_shard_count < shards && _shard_count * 2 <= capacity)
+		_shard_count <<= 1;
+
+	// the first (capacity % shards) shards get one extra slot
+	size_t per_shard = capacity / _shard_count;
+	size_t extra = capacity % _shard_count;
+
+	_shards.reset(new Shard[_shard_count]);
+	for (size_t i = 0; i < _shard_count; ++i)
+	{
+		size_t slots = per_shard + (i < extra ? 1 : 0);
+
+		_shards[i].slots.resize(slots);
+		_shards[i].index.reserve(slots);
+		_shards[i].reset();
+	}
+}
+
+StateCache::~StateCache()
+{
+}
+
+StateCache::Shard& StateCache::shard_for(constructor_type constr,
+		uint64_t a, uint64_t b) const
+{
+	Key k = { constr, a, b };
+
+	// use the high 16 bits, the low ones select the hash map bucket
+	return _shards[(KeyHash()(k) >> (sizeof(size_t) * CHAR_BIT - 16))
+		& (_shard_count - 1)];
+}
+
+StateCache::Entry StateCache::get(constructor_type constr,
+		double a, double b)
+{
+	Key k = { constr, bits(a), bits(b) };
+	Shard& s = shard_for(constr, k.a, k.b);
+
+	{
+		std::lock_guard<std::mutex> l(s.lock);
+		std::unordered_map<Key, size_t, KeyHash>::iterator it
+			= s.index.find(k);
+
+		if (it != s.index.end())
+		{
+			Slot& slot = s.slots[it->second];
+
+			++s.hits;
+			slot.referenced = true;
+			return slot.entry;
+		}
+
+		++s.misses;
+	}
+
+	// compute outside the lock, so that other threads can proceed
+	Entry e;
+	e.state = construct(constr, a, b);
+	e.properties = e.state.properties();
+
+	{
+		std::lock_guard<std::mutex> l(s.lock);
+
+		// another thread could have inserted it meanwhile
+		if (s.index.find(k) == s.index.end())
+		{
+			size_t i = s.victim();
+			Slot& slot = s.slots[i];
+
+			if (slot.used)
+				s.index.erase(slot.key);
+
+			slot.key = k;
+			slot.entry = e;
+			slot.used = true;
+			slot.referenced = false;
+			s.index[k] = i;
+		}
+	}
+
+	return e;
+}
+
+H2O StateCache::pT(double p, double T)
+{
+	return get(PT, p, T).state;
+}
+
+H2O StateCache::Tx(double T, double x)
+{
+	return get(TX, T, x).state;
+}
+
+H2O StateCache::px(double p, double x)
+{
+	return get(PX, p, x).state;
+}
+
+H2O StateCache::ph(double p, double h)
+{
+	return get(PH, p, h).state;
+}
+
+H2O StateCache::ps(double p, double s)
+{
+	return get(PS, p, s).state;
+}
+
+H2O StateCache::hs(double h, double s)
+{
+	return get(HS, h, s).state;
+}
+
+H2O StateCache::rhoT(double rho, double T)
+{
+	return get(RHOT, rho, T).state;
+}
+
+uint64_t StateCache::hits() const
+{
+	uint64_t ret = 0;
+
+	for (size_t i = 0; i < _shard_count; ++i)
+	{
+		std::lock_guard<std::mutex> l(_shards[i].lock);
+		ret += _shards[i].hits;
+	}
+
+	return ret;
+}
+
+uint64_t StateCache::misses() const
+{
+	uint64_t ret = 0;
+
+	for (size_t i = 0; i < _shard_count; ++i)
+	{
+		std::lock_guard<std::mutex> l(_shards[i].lock);
+		ret += _shards[i].misses;
+	}
+
+	return ret;
+}
+
+size_t StateCache::size() const
+{
+	size_t ret = 0;
+
+	for (size_t i = 0; i < _shard_count; ++i)
+	{
+		std::lock_guard<std::mutex> l(_shards[i].lock);
+		ret += _shards[i].index.size();
+	}
+
+	return ret;
+}
+
+size_t StateCache::capacity() const
+{
+	size_t ret = 0;
+
+	for (size_t i = 0; i < _shard_count; ++i)
+		ret += _shards[i].slots.size();
+
+	return ret;
+}
+
+void StateCache::clear()
+{
+	for (size_t i = 0; i < _shard_count; ++i)
+	{
+		std::lock_guard<std::mutex> l(_shards[i].lock);
+		_shards[i].reset();
+	}
+}
@@ -0,0 +1,471 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "classifier.hxx"
+#include "if97.hxx"
+
+using namespace h2o;
+
+static const bool not_reached = false; // for assert()
+
+// region limits
+static const double T_min = 273.15;
+static const double T_13 = 623.15;
+static const double T_25 = 1073.15;
+static const double T_max = 2273.15;
+
+static const double p_min = 611.212677E-6; // psat(T_min)
+static const double p_13 = 16.5291642526045; // psat(T_13)
+static const double p_c = 22.064;
+static const double p_5 = 50.;
+static const double p_max = 100.;
+
+// grid size (ln p x y) and the number of boundary samples per column
+static const size_t grid_np = 128;
+static const size_t grid_ny = 256;
+static const size_t column_samples = 5;
+
+// marks the cells which need the exact classification
+static const unsigned char boundary_cell = 0xFF;
+
+namespace
+{
+	typedef enum
+	{
+		PT,
+		PH,
+		PS
+	} kind_type;
+
+	/**
+	 * The region boundaries, as y(p) curves.
+	 */
+	typedef enum
+	{
+		LIQUID_MIN, // region 1 at T_min
+		LIQUID, // saturated liquid, up to p_13
+		LIQUID_13, // region 1 at T_13, above p_13
+		VAPOUR, // saturated vapour, up to p_13
+		VAPOUR_B23, // region 2 at B23, above p_13
+		LIQUID_3, // saturated liquid in region 3
+		VAPOUR_3, // saturated vapour in region 3
+		VAPOUR_25, // region 2 at T_25
+		HOT_MAX, // region 5 at T_max
+
+		CURVE_MAX
+	} curve_type;
+
+	struct Grid
+	{
+		double lnp0, dlnp;
+		double y0, dy;
+		std::vector<unsigned char> cells;
+		size_t fallback_cells;
+	};
+}
+
+static inline double y_of(kind_type kind, const PropertySet& ps)
+{
+	return kind == PH ? ps.h : ps.s;
+}
+
+static double region1_y(kind_type kind, double p, double T)
+{
+	PropertySet ps;
+
+	if97::region1(p, T, ps);
+	return y_of(kind, ps);
+}
+
+static double region2_y(kind_type kind, double p, double T)
+{
+	PropertySet ps;
+
+	if97::region2(p, T, ps);
+	return y_of(kind, ps);
+}
+
+static double region5_y(kind_type kind, double p, double T)
+{
+	PropertySet ps;
+
+	if97::region5(p, T, ps);
+	return y_of(kind, ps);
+}
+
+/**
+ * Get the saturated state in region 3 (p_13 <= p <= p_c).
+ */
+static double region3_sat_y(kind_type kind, double p, double x)
+{
+	H2O st = H2O::px(p, x);
+
+	return kind == PH ? st.h() : st.s();
+}
+
+/**
+ * Get the pressure range where a boundary curve applies.
+ */
+static void curve_range(curve_type curve, double& lo, double& hi)
+{
+	switch (curve)
+	{
+		case LIQUID:
+		case VAPOUR:
+			lo = p_min;
+			hi = p_13;
+			break;
+		case LIQUID_3:
+		case VAPOUR_3:
+			lo = p_13;
+			hi = p_c;
+			break;
+		case LIQUID_13:
+		case VAPOUR_B23:
+			lo = p_13;
+			hi = p_max;
+			break;
+		case HOT_MAX:
+			lo = p_min;
+			hi = p_5;
+			break;
+		default:
+			lo = p_min;
+			hi = p_max;
+	}
+}
+
+static double curve_y(kind_type kind, curve_type curve, double p)
+{
+	if (kind == PT)
+	{
+		switch (curve)
+		{
+			case LIQUID_MIN:
+				return T_min;
+			case LIQUID:
+			case VAPOUR:
+				return if97::Tsat(p);
+			case LIQUID_13:
+				return T_13;
+			case VAPOUR_B23:
+				return if97::TB23(p);
+			case VAPOUR_25:
+				return T_25;
+			case HOT_MAX:
+				return T_max;
+			default:
+				// (p,T) can not be two-phase
+				assert(not_reached);
+				return 0.;
+		}
+	}
+
+	switch (curve)
+	{
+		case LIQUID_MIN:
+			return region1_y(kind, p, T_min);
+		case LIQUID:
+			return region1_y(kind, p, if97::Tsat(p));
+		case LIQUID_13:
+			return region1_y(kind, p, T_13);
+		case VAPOUR:
+			return region2_y(kind, p, if97::Tsat(p));
+		case VAPOUR_B23:
+			return region2_y(kind, p, if97::TB23(p));
+		case LIQUID_3:
+			return region3_sat_y(kind, p, 0.);
+		case VAPOUR_3:
+			return region3_sat_y(kind, p, 1.);
+		case VAPOUR_25:
+			return region2_y(kind, p, T_25);
+		case HOT_MAX:
+			return region5_y(kind, p, T_max);
+		default:
+			assert(not_reached);
+			return 0.;
+	}
+}
+
+Region classifier::exact_pT(double p, double T)
+{
+	if (!(p > 0. && p <= p_max && T >= T_min && T <= T_max))
+		return Region::OOR;
+	else if (T <= T_13)
+		return p >= if97::psat(T) ? Region::R1 : Region::R2;
+	else if (T <= T_25)
+		return p > if97::pB23(T) ? Region::R3 : Region::R2;
+	else if (p <= p_5)
+		return Region::R5;
+	return Region::OOR;
+}
+
+static Region exact_py(kind_type kind, double p, double y)
+{
+	if (!(p > 0. && p <= p_max))
+		return Region::OOR;
+
+	if (p < p_min)
+	{
+		// region 2 only
+		if (y < region2_y(kind, p, T_min))
+			return Region::OOR;
+	}
+	else
+	{
+		if (y < region1_y(kind, p, T_min))
+			return Region::OOR;
+
+		double T_1 = p <= p_13 ? if97::Tsat(p) : T_13;
+		if (y <= region1_y(kind, p, T_1))
+			return Region::R1;
+
+		double T_2 = p <= p_13 ? T_1 : if97::TB23(p);
+		if (y < region2_y(kind, p, T_2))
+		{
+			if (p <= p_13)
+				return Region::R4;
+			else if (p >= p_c)
+				return Region::R3;
+			else if (y <= region3_sat_y(kind, p, 0.)
+					|| y >= region3_sat_y(kind, p, 1.))
+				return Region::R3;
+			return Region::R4;
+		}
+	}
+
+	if (y <= region2_y(kind, p, T_25))
+		return Region::R2;
+	else if (p <= p_5 && y <= region5_y(kind, p, T_max))
+		return Region::R5;
+	return Region::OOR;
+}
+
+Region classifier::exact_ph(double p, double h)
+{
+	return exact_py(PH, p, h);
+}
+
+Region classifier::exact_ps(double p, double s)
+{
+	return exact_py(PS, p, s);
+}
+
+static Region exact(kind_type kind, double p, double y)
+{
+	return kind == PT ? classifier::exact_pT(p, y)
+		: exact_py(kind, p, y);
+}
+
+static Grid build_grid(kind_type kind)
+{
+	Grid g;
+
+	g.lnp0 = std::log(p_min);
+	g.dlnp = (std::log(p_max) - g.lnp0) / grid_np;
+
+	// the covered y range: from the liquid at T_min and high pressure
+	// to region 5 at T_max and low pressure
+	double y_lo, y_hi;
+	if (kind == PT)
+	{
+		y_lo = T_min;
+		y_hi = T_max;
+	}
+	else
+	{
+		y_lo = std::min(region1_y(kind, p_min, T_min),
+				region1_y(kind, p_max, T_min));
+		y_hi = region5_y(kind, p_min, T_max);
+	}
+	g.y0 = y_lo;
+	g.dy = (y_hi - y_lo) / grid_ny;
+
+	g.cells.assign(grid_np * grid_ny, boundary_cell);
+	g.fallback_cells = 0;
+
+	static const double vertical[] = { p_13, p_c, p_5 };
+
+	for (size_t i = 0; i < grid_np; ++i)
+	{
+		double p_lo = std::exp(g.lnp0 + i * g.dlnp);
+		double p_hi = std::exp(g.lnp0 + (i + 1) * g.dlnp);
+		bool straddles = false;
+
+		for (size_t k = 0; k < sizeof(vertical) / sizeof(*vertical); ++k)
+			if (p_lo < vertical[k] && vertical[k] < p_hi)
+				straddles = true;
+
+		// the y ranges blocked by the boundary curves in this column,
+		// with a margin for the curvature between the samples
+		std::vector<std::pair<double, double> > blocked;
+
+		for (int c = 0; !straddles && c < CURVE_MAX; ++c)
+		{
+			curve_type curve = static_cast<curve_type>(c);
+			double lo, hi;
+
+			if (kind == PT && (curve == LIQUID_3 || curve == VAPOUR_3))
+				continue;
+			curve_range(curve, lo, hi);
+			lo = std::max(lo, p_lo);
+			hi = std::min(hi, p_hi);
+			if (lo > hi)
+				continue;
+
+			double y_min = curve_y(kind, curve, lo);
+			double y_max = y_min;
+
+			for (size_t k = 1; k < column_samples; ++k)
+			{
+				double p = std::exp(std::log(lo) + (std::log(hi)
+							- std::log(lo)) * k / (column_samples - 1));
+				double y = curve_y(kind, curve, p);
+
+				y_min = std::min(y_min, y);
+				y_max = std::max(y_max, y);
+			}
+
+			double margin = 0.25 * (y_max - y_min)
+				+ 1E-6 * (std::fabs(y_max) + 1.);
+			blocked.push_back(std::make_pair(y_min - margin,
+						y_max + margin));
+		}
+
+		for (size_t j = 0; j < grid_ny; ++j)
+		{
+			double y_lo = g.y0 + j * g.dy;
+			double y_hi = y_lo + g.dy;
+			bool crossed = straddles;
+
+			for (size_t k = 0; !crossed && k < blocked.size(); ++k)
+				crossed = blocked[k].first <= y_hi
+					&& blocked[k].second >= y_lo;
+
+			if (crossed)
+				++g.fallback_cells;
+			else
+			{
+				double p = std::sqrt(p_lo * p_hi);
+				double y = y_lo + g.dy / 2.;
+
+				g.cells[i * grid_ny + j] = static_cast<Region::enum_type>(
+						exact(kind, p, y));
+			}
+		}
+	}
+
+	return g;
+}
+
+static const Grid& grid(kind_type kind)
+{
+	static const Grid grids[] =
+	{
+		build_grid(PT),
+		build_grid(PH),
+		build_grid(PS)
+	};
+
+	return grids[kind];
+}
+
+static bool lookup(kind_type kind, double p, double y, Region& out)
+{
+	const Grid& g = grid(kind);
+
+	// (also false for NaNs)
+	if (!(p >= p_min && p <= p_max))
+		return false;
+
+	double a = (std::log(p) - g.lnp0) / g.dlnp;
+	double b = (y - g.y0) / g.dy;
+
+	if (!(b >= 0. && b < grid_ny))
+		return false;
+
+	size_t i = std::min(static_cast<size_t>(a), grid_np - 1);
+	size_t j = static_cast<size_t>(b);
+	unsigned char cell = g.cells[i * grid_ny + j];
+
+	if (cell == boundary_cell)
+		return false;
+
+	out = static_cast<Region::enum_type>(cell);
+	return true;
+}
+
+bool classifier::lookup_pT(double p, double T, Region& out)
+{
+	return lookup(PT, p, T, out);
+}
+
+bool classifier::lookup_ph(double p, double h, Region& out)
+{
+	return lookup(PH, p, h, out);
+}
+
+bool classifier::lookup_ps(double p, double s, Region& out)
+{
+	return lookup(PS, p, s, out);
+}
+
+Region classifier::pT(double p, double T)
+{
+	Region ret;
+
+	if (!lookup(PT, p, T, ret))
+		ret = exact_pT(p, T);
+	return ret;
+}
+
+Region classifier::ph(double p, double h)
+{
+	Region ret;
+
+	if (!lookup(PH, p, h, ret))
+		ret = exact_ph(p, h);
+	return ret;
+}
+
+Region classifier::ps(double p, double s)
+{
+	Region ret;
+
+	if (!lookup(PS, p, s, ret))
+		ret = exact_ps(p, s);
+	return ret;
+}
+
+static double fallback_ratio(kind_type kind)
+{
+	const Grid& g = grid(kind);
+
+	return static_cast<double>(g.fallback_cells) / g.cells.size();
+}
+
+double classifier::fallback_ratio_pT()
+{
+	return fallback_ratio(PT);
+}
+
+double classifier::fallback_ratio_ph()
+{
+	return fallback_ratio(PH);
+}
+
+double classifier::fallback_ratio_ps()
+{
+	return fallback_ratio(PS);
+}
@@ -0,0 +1,28 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#pragma once
+
+#ifndef _H2O_CLASSIFIER_INTERNAL_HXX
+#define _H2O_CLASSIFIER_INTERNAL_HXX 1
+
+#include "h2o_classifier"
+
+namespace h2o
+{
+	namespace classifier
+	{
+		/**
+		 * Look the region up in the grid only. Returns false
+		 * (leaving @out untouched) if the state point is in a boundary
+		 * cell, or outside the grid.
+		 */
+		bool lookup_pT(double p, double T, Region& out);
+		bool lookup_ph(double p, double h, Region& out);
+		bool lookup_ps(double p, double s, Region& out);
+	}
+}
+
+#endif /*_H2O_CLASSIFIER_INTERNAL_HXX*/
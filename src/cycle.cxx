@@ -0,0 +1,468 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "h2o_backward"
+#include "h2o_cycle"
+
+using namespace h2o;
+using namespace h2o::cycle;
+
+static const bool not_reached = false; // for assert()
+
+const size_t Cycle::npos;
+
+Cycle::Cycle(size_t nodes)
+	: _states(nodes), _h(nodes), _flows(nodes), _known(nodes),
+	_sourced(nodes), _last_h(nodes), _last_flows(nodes),
+	_reference(0), _reference_flow(1.), _iterations(0)
+{
+	assert(nodes > 0);
+}
+
+size_t Cycle::add(component_type type, size_t in, size_t out)
+{
+	assert(in < nodes());
+	assert(out < nodes());
+	assert(!_sourced[out]);
+
+	Component c;
+
+	c.type = type;
+	c.in = in;
+	c.in2 = c.in3 = c.out2 = npos;
+	c.out = out;
+	c.p = c.T = std::numeric_limits<double>::quiet_NaN();
+	c.eta = 1.;
+	c.dT = 0.;
+	c.duty = 0.;
+
+	_sourced[out] = 1;
+	_components.push_back(c);
+	return _components.size() - 1;
+}
+
+size_t Cycle::pump(size_t in, size_t out, double p, double eta)
+{
+	size_t i = add(PUMP, in, out);
+
+	_components[i].p = p;
+	_components[i].eta = eta;
+	return i;
+}
+
+size_t Cycle::turbine(size_t in, size_t out, double p, double eta)
+{
+	size_t i = add(TURBINE, in, out);
+
+	_components[i].p = p;
+	_components[i].eta = eta;
+	return i;
+}
+
+size_t Cycle::heater(size_t in, size_t out, double p, double T)
+{
+	size_t i = add(HEATER, in, out);
+
+	_components[i].p = p;
+	_components[i].T = T;
+	return i;
+}
+
+size_t Cycle::condenser(size_t in, size_t out, double dT)
+{
+	size_t i = add(CONDENSER, in, out);
+
+	_components[i].dT = dT;
+	return i;
+}
+
+size_t Cycle::valve(size_t in, size_t out, double p)
+{
+	size_t i = add(VALVE, in, out);
+
+	_components[i].p = p;
+	return i;
+}
+
+size_t Cycle::splitter(size_t in, size_t out, size_t bleed)
+{
+	assert(bleed < nodes());
+	assert(!_sourced[bleed]);
+
+	size_t i = add(SPLITTER, in, out);
+
+	_components[i].out2 = bleed;
+	_sourced[bleed] = 1;
+	return i;
+}
+
+size_t Cycle::mixer(size_t in, size_t in2, size_t out)
+{
+	assert(in2 < nodes());
+
+	size_t i = add(MIXER, in, out);
+
+	_components[i].in2 = in2;
+	return i;
+}
+
+size_t Cycle::open_heater(size_t feed, size_t steam, size_t out)
+{
+	assert(steam < nodes());
+
+	size_t i = add(OPEN_HEATER, feed, out);
+
+	_components[i].in2 = steam;
+	return i;
+}
+
+size_t Cycle::closed_heater(size_t feed_in, size_t feed_out,
+		size_t steam, size_t drain, double dT, size_t drain_in)
+{
+	assert(steam < nodes());
+	assert(drain < nodes());
+	assert(!_sourced[drain]);
+	assert(drain_in == npos || drain_in < nodes());
+
+	size_t i = add(CLOSED_HEATER, feed_in, feed_out);
+
+	_components[i].in2 = steam;
+	_components[i].in3 = drain_in;
+	_components[i].out2 = drain;
+	_components[i].dT = dT;
+	_sourced[drain] = 1;
+	return i;
+}
+
+void Cycle::set_flow(size_t node, double m)
+{
+	assert(node < nodes());
+
+	_reference = node;
+	_reference_flow = m;
+	_flows[node] = m;
+}
+
+void Cycle::set_state(size_t node, const H2O& st)
+{
+	_states[node] = st;
+	_h[node] = st.h();
+	_known[node] = 1;
+}
+
+void Cycle::put_flow(size_t node, double m)
+{
+	_flows[node] = node == _reference ? _reference_flow : m;
+}
+
+/**
+ * Get the starting point for the inversions giving the state in @node:
+ * its state from the previous iteration, or the state in @fallback
+ * (an inlet) in the first one.
+ */
+const H2O& Cycle::hint(size_t node, size_t fallback) const
+{
+	return _known[node] ? _states[node] : _states[fallback];
+}
+
+/**
+ * Update the outlet states and flows of a single component, using
+ * the current states and flows in its inlets. Components whose inlets
+ * are not known yet are skipped; unknown drain and mixer inlets are
+ * assumed to carry no flow.
+ */
+void Cycle::update(Component& c)
+{
+	switch (c.type)
+	{
+		case PUMP:
+		case TURBINE:
+			if (!_known[c.in])
+				return;
+
+			if (c.type == TURBINE)
+				set_state(c.out, backward::expand(_states[c.in], c.p,
+							c.eta, hint(c.out, c.in)));
+			else
+			{
+				double hin = _h[c.in];
+				H2O ideal = backward::ps(c.p, _states[c.in].s(),
+						hint(c.out, c.in));
+
+				if (c.eta == 1.)
+					set_state(c.out, ideal);
+				else
+					set_state(c.out, backward::ph(c.p,
+								hin + (ideal.h() - hin) / c.eta, ideal));
+			}
+
+			put_flow(c.out, _flows[c.in]);
+			if (c.type == TURBINE)
+				c.duty = (_h[c.in] - _h[c.out]) * _flows[c.in];
+			else
+				c.duty = (_h[c.out] - _h[c.in]) * _flows[c.in];
+			break;
+		case HEATER:
+			set_state(c.out, H2O::pT(c.p, c.T));
+			if (!_known[c.in])
+				put_flow(c.out, 0.);
+			else
+			{
+				put_flow(c.out, _flows[c.in]);
+				c.duty = (_h[c.out] - _h[c.in]) * _flows[c.in];
+			}
+			break;
+		case CONDENSER:
+			if (!_known[c.in])
+				return;
+
+			{
+				double p = _states[c.in].p();
+				H2O sat = H2O::px(p, 0.);
+
+				if (c.dT > 0.)
+					set_state(c.out, H2O::pT(p, sat.T() - c.dT));
+				else
+					set_state(c.out, sat);
+			}
+
+			put_flow(c.out, _flows[c.in]);
+			c.duty = (_h[c.in] - _h[c.out]) * _flows[c.in];
+			break;
+		case VALVE:
+			if (!_known[c.in])
+				return;
+
+			set_state(c.out, backward::ph(c.p, _h[c.in],
+						hint(c.out, c.in)));
+			put_flow(c.out, _flows[c.in]);
+			break;
+		case SPLITTER:
+			if (!_known[c.in])
+				return;
+
+			set_state(c.out, _states[c.in]);
+			set_state(c.out2, _states[c.in]);
+			put_flow(c.out, _flows[c.in] - _flows[c.out2]);
+			break;
+		case MIXER:
+			if (!_known[c.in])
+				return;
+
+			{
+				double m1 = _flows[c.in];
+				double m2 = _known[c.in2] ? _flows[c.in2] : 0.;
+				double h = _h[c.in];
+
+				if (m1 + m2 != 0.)
+					h = (m1 * h + m2 * _h[c.in2]) / (m1 + m2);
+
+				set_state(c.out, backward::ph(_states[c.in].p(), h,
+							hint(c.out, c.in)));
+				put_flow(c.out, m1 + m2);
+			}
+			break;
+		case OPEN_HEATER:
+			if (!_known[c.in] || !_known[c.in2])
+				return;
+
+			set_state(c.out, H2O::px(_states[c.in2].p(), 0.));
+
+			{
+				double hout = _h[c.out];
+				double m = _flows[c.in] * (hout - _h[c.in])
+					/ (_h[c.in2] - hout);
+
+				put_flow(c.in2, m);
+				put_flow(c.out, _flows[c.in] + m);
+			}
+			break;
+		case CLOSED_HEATER:
+			if (!_known[c.in] || !_known[c.in2])
+				return;
+
+			set_state(c.out2, H2O::px(_states[c.in2].p(), 0.));
+			set_state(c.out, H2O::pT(_states[c.in].p(),
+						_states[c.out2].T() - c.dT));
+
+			{
+				double hdrain = _h[c.out2];
+				double q = _flows[c.in] * (_h[c.out] - _h[c.in]);
+				double md = 0.;
+
+				if (c.in3 != npos && _known[c.in3])
+				{
+					md = _flows[c.in3];
+					q -= md * (_h[c.in3] - hdrain);
+				}
+
+				double m = q / (_h[c.in2] - hdrain);
+
+				put_flow(c.in2, m);
+				put_flow(c.out, _flows[c.in]);
+				put_flow(c.out2, m + md);
+			}
+			break;
+		default:
+			assert(not_reached);
+	}
+}
+
+int Cycle::solve(double tolerance, int max_iterations)
+{
+	if (std::find(_sourced.begin(), _sourced.end(), 0) != _sourced.end())
+		throw std::runtime_error("Cycle node without a source");
+
+	size_t unknown = std::count(_known.begin(), _known.end(), 0);
+
+	for (_iterations = 1; _iterations <= max_iterations; ++_iterations)
+	{
+		size_t last_unknown = unknown;
+
+		std::copy(_h.begin(), _h.end(), _last_h.begin());
+		std::copy(_flows.begin(), _flows.end(), _last_flows.begin());
+
+		for (std::vector<Component>::iterator it = _components.begin();
+				it != _components.end(); ++it)
+			update(*it);
+
+		unknown = std::count(_known.begin(), _known.end(), 0);
+		if (unknown > 0)
+		{
+			// every iteration has to reach some new nodes
+			if (unknown == last_unknown)
+				throw std::runtime_error(
+						"Cycle nodes unreachable from the heaters");
+			continue;
+		}
+		// the values from the previous iteration are incomplete
+		if (last_unknown > 0)
+			continue;
+
+		bool converged = true;
+
+		for (size_t i = 0; i < nodes() && converged; ++i)
+		{
+			if (std::fabs(_h[i] - _last_h[i])
+					> tolerance * std::max(std::fabs(_h[i]), 1.))
+				converged = false;
+			else if (std::fabs(_flows[i] - _last_flows[i])
+					> tolerance * std::fabs(_reference_flow))
+				converged = false;
+		}
+
+		if (converged)
+		{
+			for (size_t i = 0; i < nodes(); ++i)
+			{
+				if (_flows[i] < 0.)
+					throw std::runtime_error(
+							"Infeasible cycle: negative mass flow");
+			}
+
+			return _iterations;
+		}
+	}
+
+	_iterations = max_iterations;
+	throw std::runtime_error("Cycle did not converge");
+}
+
+size_t Cycle::components() const
+{
+	return _components.size();
+}
+
+Component& Cycle::component(size_t i)
+{
+	assert(i < _components.size());
+
+	return _components[i];
+}
+
+const Component& Cycle::component(size_t i) const
+{
+	assert(i < _components.size());
+
+	return _components[i];
+}
+
+size_t Cycle::nodes() const
+{
+	return _states.size();
+}
+
+const H2O& Cycle::state(size_t node) const
+{
+	assert(node < nodes());
+
+	return _states[node];
+}
+
+double Cycle::flow(size_t node) const
+{
+	assert(node < nodes());
+
+	return _flows[node];
+}
+
+double Cycle::total(component_type type) const
+{
+	double ret = 0.;
+
+	for (std::vector<Component>::const_iterator it = _components.begin();
+			it != _components.end(); ++it)
+	{
+		if (it->type == type)
+			ret += it->duty;
+	}
+
+	return ret;
+}
+
+double Cycle::heat_input() const
+{
+	return total(HEATER);
+}
+
+double Cycle::heat_rejected() const
+{
+	return total(CONDENSER);
+}
+
+double Cycle::turbine_work() const
+{
+	return total(TURBINE);
+}
+
+double Cycle::pump_work() const
+{
+	return total(PUMP);
+}
+
+double Cycle::net_work() const
+{
+	return turbine_work() - pump_work();
+}
+
+double Cycle::efficiency() const
+{
+	return net_work() / heat_input();
+}
+
+int Cycle::iterations() const
+{
+	return _iterations;
+}
@@ -0,0 +1,166 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+#include "h2o_backward"
+#include "h2o_expansion"
+
+using namespace h2o;
+
+// the largest pressure ratio of a single integration step
+// of the polytropic expansion
+static const double max_step_ratio = 1.5;
+// the number of times a step crossing a region boundary is halved
+static const int max_step_splits = 10;
+
+static void check_inlet(const H2O& in)
+{
+	if (in.region() == Region::R5)
+		throw std::range_error("Expansion not supported in region 5");
+}
+
+/**
+ * The slope of the polytropic expansion path, dh/d(ln p) [kJ/kg],
+ * at (p,h). @hint is updated to the state point at (p,h).
+ */
+static double polytropic_slope(double p, double h, double eta, H2O& hint)
+{
+	hint = backward::ph(p, h, hint);
+
+	return eta * p * hint.v() * 1000.;
+}
+
+/**
+ * Perform a single step of the classic Runge-Kutta method in ln p,
+ * and return h at its end. The derivatives of v are discontinuous
+ * at the region boundaries (i.e. the saturation line), so the steps
+ * crossing them are split.
+ */
+static double polytropic_step(double lnp, double h, double dlnp,
+		double eta, H2O& st, int splits)
+{
+	double k1 = polytropic_slope(std::exp(lnp), h, eta, st);
+	Region start = st.region();
+	double k2 = polytropic_slope(std::exp(lnp + dlnp / 2.),
+			h + k1 * dlnp / 2., eta, st);
+	double k3 = polytropic_slope(std::exp(lnp + dlnp / 2.),
+			h + k2 * dlnp / 2., eta, st);
+	double k4 = polytropic_slope(std::exp(lnp + dlnp),
+			h + k3 * dlnp, eta, st);
+
+	if (st.region() != start && splits > 0)
+	{
+		h = polytropic_step(lnp, h, dlnp / 2., eta, st, splits - 1);
+		return polytropic_step(lnp + dlnp / 2., h, dlnp / 2., eta, st,
+				splits - 1);
+	}
+
+	return h + (k1 + 2. * k2 + 2. * k3 + k4) * dlnp / 6.;
+}
+
+/**
+ * Perform a single stage of the expansion, like H2O::expand().
+ */
+static H2O expand_stage(const H2O& in, double pout, double eta)
+{
+	return backward::expand(in, pout, eta, in);
+}
+
+ExpansionLine::ExpansionLine()
+{
+}
+
+void ExpansionLine::expand(const H2O& in, const std::vector<double>& pout,
+		const std::vector<double>& eta)
+{
+	assert(eta.size() == pout.size());
+
+	check_inlet(in);
+	_states.resize(pout.size() + 1);
+	_states[0] = in;
+
+	for (size_t i = 0; i < pout.size(); ++i)
+		_states[i + 1] = expand_stage(_states[i], pout[i], eta[i]);
+}
+
+void ExpansionLine::expand(const H2O& in, const std::vector<double>& pout,
+		double eta)
+{
+	check_inlet(in);
+	_states.resize(pout.size() + 1);
+	_states[0] = in;
+
+	for (size_t i = 0; i < pout.size(); ++i)
+		_states[i + 1] = expand_stage(_states[i], pout[i], eta);
+}
+
+void ExpansionLine::expand_polytropic(const H2O& in,
+		const std::vector<double>& pout, double eta)
+{
+	check_inlet(in);
+	_states.resize(pout.size() + 1);
+	_states[0] = in;
+
+	for (size_t i = 0; i < pout.size(); ++i)
+	{
+		H2O st = _states[i];
+		double lnp = std::log(st.p());
+		double h = st.h();
+
+		double span = std::log(pout[i]) - lnp;
+		int steps = static_cast<int>(std::ceil(std::fabs(span)
+					/ std::log(max_step_ratio)));
+		double dlnp = span / std::max(steps, 1);
+
+		for (int j = 0; j < steps; ++j)
+		{
+			h = polytropic_step(lnp, h, dlnp, eta, st, max_step_splits);
+			lnp += dlnp;
+		}
+
+		_states[i + 1] = backward::ph(pout[i], h, st);
+	}
+}
+
+size_t ExpansionLine::size() const
+{
+	return _states.size();
+}
+
+const H2O& ExpansionLine::operator[](size_t i) const
+{
+	assert(i < size());
+
+	return _states[i];
+}
+
+const H2O* ExpansionLine::data() const
+{
+	assert(size() > 0);
+
+	return &_states[0];
+}
+
+const H2O& ExpansionLine::inlet() const
+{
+	assert(size() > 0);
+
+	return _states.front();
+}
+
+const H2O& ExpansionLine::outlet() const
+{
+	assert(size() > 0);
+
+	return _states.back();
+}
@@ -11,6 +11,10 @@
 #include <stdexcept>
 
 #include "h2o"
+#include "h2o_backward"
+#include "if97.hxx"
+#include "if97_kernels.hxx"
+#include "instrumentation.hxx"
 
 namespace h2o
 {
@@ -27,12 +31,45 @@ namespace h2o
 using namespace h2o;
 
 typedef double (*twoarg_func_t)(double, double);
+typedef double (*getter_func_t)(internals::h2o_t);
 
 static inline void out_of_range()
 {
 	throw std::range_error("Requested parameters out-of-range.");
 }
 
+/**
+ * Get a property of a state point, either through libh2o or using
+ * the inlined basic equation kernels (in regions 1, 2 and 5, where
+ * the state point is stored as (p,T)).
+ */
+static inline double get(const internals::h2o_t& d, getter_func_t getter,
+		double PropertySet::*field)
+{
+#ifdef H2OXX_NATIVE_GETTERS
+	PropertySet ps;
+
+	switch (d.region)
+	{
+		case internals::H2O_REGION1:
+			if97::kernels::region1(h2o_get_p(d), h2o_get_T(d), ps);
+			return ps.*field;
+		case internals::H2O_REGION2:
+			if97::kernels::region2(h2o_get_p(d), h2o_get_T(d), ps);
+			return ps.*field;
+		case internals::H2O_REGION5:
+			if97::kernels::region5(h2o_get_p(d), h2o_get_T(d), ps);
+			return ps.*field;
+		default:
+			break;
+	}
+#else
+	(void) field;
+#endif
+
+	return getter(d);
+}
+
 H2O::H2O(internals::h2o_t data)
 	: _data(data)
 {
@@ -54,37 +91,149 @@ H2O::H2O(double p, double T)
 
 H2O H2O::pT(double p, double T)
 {
-	return H2O(p, T);
+	H2O_PROBE(CONSTRUCT_PT);
+	return H2O_RECORD(H2O(p, T));
 }
 
 H2O H2O::Tx(double T, double x)
 {
-	return H2O(internals::h2o_new_Tx(T, x));
+	H2O_PROBE(CONSTRUCT_TX);
+	return H2O_RECORD(H2O(internals::h2o_new_Tx(T, x)));
 }
 
 H2O H2O::px(double p, double x)
 {
-	return H2O(internals::h2o_new_px(p, x));
+	H2O_PROBE(CONSTRUCT_PX);
+	return H2O_RECORD(H2O(internals::h2o_new_px(p, x)));
 }
 
 H2O H2O::ph(double p, double h)
 {
-	return H2O(internals::h2o_new_ph(p, h));
+	H2O_PROBE(CONSTRUCT_PH);
+	return H2O_RECORD(H2O(internals::h2o_new_ph(p, h)));
 }
 
 H2O H2O::ps(double p, double s)
 {
-	return H2O(internals::h2o_new_ps(p, s));
+	H2O_PROBE(CONSTRUCT_PS);
+	return H2O_RECORD(H2O(internals::h2o_new_ps(p, s)));
 }
 
 H2O H2O::hs(double h, double s)
 {
-	return H2O(internals::h2o_new_hs(h, s));
+	H2O_PROBE(CONSTRUCT_HS);
+	return H2O_RECORD(H2O(internals::h2o_new_hs(h, s)));
 }
 
 H2O H2O::rhoT(double rho, double T)
 {
-	return H2O(internals::h2o_new_rhoT(rho, T));
+	H2O_PROBE(CONSTRUCT_RHOT);
+	return H2O_RECORD(H2O(internals::h2o_new_rhoT(rho, T)));
+}
+
+H2O H2O::rhou(double rho, double u)
+{
+	H2O_PROBE(CONSTRUCT_RHOU);
+	return H2O_RECORD(backward::rhou(rho, u));
+}
+
+H2O H2O::vu(double v, double u)
+{
+	H2O_PROBE(CONSTRUCT_RHOU);
+	return H2O_RECORD(backward::rhou(1. / v, u));
+}
+
+H2O H2O::warm_ph(double p, double h, const H2O& hint)
+{
+	H2O_PROBE(CONSTRUCT_PH);
+	return H2O_RECORD(backward::ph(p, h, hint));
+}
+
+H2O H2O::warm_ps(double p, double s, const H2O& hint)
+{
+	H2O_PROBE(CONSTRUCT_PS);
+	return H2O_RECORD(backward::ps(p, s, hint));
+}
+
+H2O H2O::warm_hs(double h, double s, const H2O& hint)
+{
+	H2O_PROBE(CONSTRUCT_HS);
+	return H2O_RECORD(backward::hs(h, s, hint));
+}
+
+H2O H2O::warm_rhoT(double rho, double T, const H2O& hint)
+{
+	H2O_PROBE(CONSTRUCT_RHOT);
+	return H2O_RECORD(backward::rhoT(rho, T, hint));
+}
+
+H2O H2O::warm_rhou(double rho, double u, const H2O& hint)
+{
+	H2O_PROBE(CONSTRUCT_RHOU);
+	return H2O_RECORD(backward::rhou(rho, u, hint));
+}
+
+H2O H2O::unchecked(internals::h2o_t data) noexcept
+{
+	H2O ret;
+
+	// out-of-range data simply leaves the object uninitialized
+	ret._data = data;
+	return ret;
+}
+
+H2O H2O::try_pT(double p, double T) noexcept
+{
+	H2O_PROBE(CONSTRUCT_PT);
+	return H2O_RECORD(unchecked(internals::h2o_new_pT(p, T)));
+}
+
+H2O H2O::try_Tx(double T, double x) noexcept
+{
+	H2O_PROBE(CONSTRUCT_TX);
+	return H2O_RECORD(unchecked(internals::h2o_new_Tx(T, x)));
+}
+
+H2O H2O::try_px(double p, double x) noexcept
+{
+	H2O_PROBE(CONSTRUCT_PX);
+	return H2O_RECORD(unchecked(internals::h2o_new_px(p, x)));
+}
+
+H2O H2O::try_ph(double p, double h) noexcept
+{
+	H2O_PROBE(CONSTRUCT_PH);
+	return H2O_RECORD(unchecked(internals::h2o_new_ph(p, h)));
+}
+
+H2O H2O::try_ps(double p, double s) noexcept
+{
+	H2O_PROBE(CONSTRUCT_PS);
+	return H2O_RECORD(unchecked(internals::h2o_new_ps(p, s)));
+}
+
+H2O H2O::try_hs(double h, double s) noexcept
+{
+	H2O_PROBE(CONSTRUCT_HS);
+	return H2O_RECORD(unchecked(internals::h2o_new_hs(h, s)));
+}
+
+H2O H2O::try_rhoT(double rho, double T) noexcept
+{
+	H2O_PROBE(CONSTRUCT_RHOT);
+	return H2O_RECORD(unchecked(internals::h2o_new_rhoT(rho, T)));
+}
+
+H2O H2O::try_rhou(double rho, double u) noexcept
+{
+	H2O_PROBE(CONSTRUCT_RHOU);
+	return H2O_RECORD(backward::try_rhou(rho, u));
+}
+
+H2O H2O::try_vu(double v, double u) noexcept
+{
+	H2O_PROBE(CONSTRUCT_RHOU);
+	return H2O_RECORD(backward::try_rhou(1. / v, u));
 }
 
 bool H2O::initialized() const
@@ -101,14 +250,16 @@ double H2O::p() const
 {
 	assert(initialized());
 
-	return h2o_get_p(_data);
+	H2O_PROBE_AT(GET_P, _data.region);
+	return H2O_RECORD(h2o_get_p(_data));
 }
 
 double H2O::T() const
 {
 	assert(initialized());
 
-	return h2o_get_T(_data);
+	H2O_PROBE_AT(GET_T, _data.region);
+	return H2O_RECORD(h2o_get_T(_data));
 }
 
 double H2O::x() const
@@ -116,80 +267,115 @@ double H2O::x() const
 	assert(initialized());
 	assert(region() != Region::R3);
 
-	return h2o_get_x(_data);
+	H2O_PROBE_AT(GET_X, _data.region);
+	return H2O_RECORD(h2o_get_x(_data));
 }
 
 double H2O::rho() const
 {
 	assert(initialized());
 
-	return h2o_get_rho(_data);
+	H2O_PROBE_AT(GET_RHO, _data.region);
+	return H2O_RECORD(get(_data, internals::h2o_get_rho,
+				&PropertySet::rho));
 }
 
 double H2O::v() const
 {
 	assert(initialized());
 
-	return h2o_get_v(_data);
+	H2O_PROBE_AT(GET_V, _data.region);
+	return H2O_RECORD(get(_data, internals::h2o_get_v, &PropertySet::v));
 }
 
 double H2O::u() const
 {
 	assert(initialized());
 
-	return h2o_get_u(_data);
+	H2O_PROBE_AT(GET_U, _data.region);
+	return H2O_RECORD(get(_data, internals::h2o_get_u, &PropertySet::u));
 }
 
 double H2O::h() const
 {
 	assert(initialized());
 
-	return h2o_get_h(_data);
+	H2O_PROBE_AT(GET_H, _data.region);
+	return H2O_RECORD(get(_data, internals::h2o_get_h, &PropertySet::h));
 }
 
 double H2O::s() const
 {
 	assert(initialized());
 
-	return h2o_get_s(_data);
+	H2O_PROBE_AT(GET_S, _data.region);
+	return H2O_RECORD(get(_data, internals::h2o_get_s, &PropertySet::s));
 }
 
 double H2O::cp() const
 {
 	assert(initialized());
 
-	return h2o_get_cp(_data);
+	H2O_PROBE_AT(GET_CP, _data.region);
+	return H2O_RECORD(get(_data, internals::h2o_get_cp, &PropertySet::cp));
 }
 
 double H2O::cv() const
 {
 	assert(initialized());
 
-	return h2o_get_cv(_data);
+	H2O_PROBE_AT(GET_CV, _data.region);
+	return H2O_RECORD(get(_data, internals::h2o_get_cv, &PropertySet::cv));
 }
 
 double H2O::w() const
 {
 	assert(initialized());
 
-	return h2o_get_w(_data);
+	H2O_PROBE_AT(GET_W, _data.region);
+	return H2O_RECORD(get(_data, internals::h2o_get_w, &PropertySet::w));
 }
 
-H2O H2O::expand(double pout) const
+PropertySet H2O::properties() const
+{
+	assert(initialized());
+
+	H2O_PROBE_AT(GET_PROPERTIES, _data.region);
+	return H2O_RECORD(if97::properties(_data));
+}
+
+double H2O::derivative(property::type x, property::type y,
+		property::type z) const
 {
-	if (region() == Region::R5)
+	assert(initialized());
+	assert(y != z);
+
+	H2O_PROBE_AT(GET_DERIVATIVE, _data.region);
+	return H2O_RECORD(if97::derivative(_data, x, y, z));
+}
+
+static H2O isentropic(const H2O& in, double pout)
+{
+	if (in.region() == Region::R5)
 		throw std::range_error("Expansion not supported in region 5");
 
-	return H2O::ps(pout, s());
+	return H2O::ps(pout, in.s());
+}
+
+H2O H2O::expand(double pout) const
+{
+	H2O_PROBE(EXPAND);
+	return H2O_RECORD(isentropic(*this, pout));
 }
 
 H2O H2O::expand(double pout, double eta) const
 {
-	H2O ideal = expand(pout);
+	H2O_PROBE(EXPAND);
+	H2O ideal = isentropic(*this, pout);
 
 	double hin = h();
 	double hout = ideal.h();
 	double houtr = hin - (hin - hout) * eta;
 
-	return H2O::ph(pout, houtr);
+	return H2O_RECORD(H2O::ph(pout, houtr));
 }
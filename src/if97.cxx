@@ -0,0 +1,439 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "if97.hxx"
+#include "if97_kernels.hxx"
+
+using namespace h2o;
+using namespace h2o::if97::kernels;
+
+static const bool not_reached = false; // for assert()
+
+static const double region4_coeffs[] =
+{
+	0.11670521452767E4,
+	-0.72421316703206E6,
+	-0.17073846940092E2,
+	0.12020824702470E5,
+	-0.32325550322333E7,
+	0.14915108613530E2,
+	-0.48232657361591E4,
+	0.40511340542057E6,
+	-0.23855557567849,
+	0.65017534844798E3
+};
+
+static const double b23_coeffs[] =
+{
+	0.34805185628969E3,
+	-0.11671859879975E1,
+	0.10192970039326E-2,
+	0.57254459862746E3,
+	0.13918839778870E2
+};
+
+static void gibbs_volume_derivatives(const Derivatives<>& g, double p,
+		double T, double pi, double tau, double v,
+		if97::VolumeDerivatives& out)
+{
+	out.dvdT = v / T * (g.fa - tau * g.fat) / g.fa;
+	out.dvdp = v * pi * g.faa / (g.fa * p);
+}
+
+void if97::region1(double p, double T, PropertySet& out)
+{
+	kernels::region1(p, T, out);
+}
+
+void if97::region1(double p, double T, PropertySet& out,
+		VolumeDerivatives& dv)
+{
+	double pi = p / 16.53;
+	double tau = 1386. / T;
+	Derivatives<> g = region1_gibbs(pi, tau);
+
+	gibbs_properties(g, p, T, pi, tau, out);
+	gibbs_volume_derivatives(g, p, T, pi, tau, out.v, dv);
+}
+
+void if97::region2(double p, double T, PropertySet& out)
+{
+	kernels::region2(p, T, out);
+}
+
+void if97::region2(double p, double T, PropertySet& out,
+		VolumeDerivatives& dv)
+{
+	double pi = p;
+	double tau = 540. / T;
+	Derivatives<> g = region2_gibbs(pi, tau);
+
+	gibbs_properties(g, p, T, pi, tau, out);
+	gibbs_volume_derivatives(g, p, T, pi, tau, out.v, dv);
+}
+
+void if97::region5(double p, double T, PropertySet& out)
+{
+	kernels::region5(p, T, out);
+}
+
+void if97::region5(double p, double T, PropertySet& out,
+		VolumeDerivatives& dv)
+{
+	double pi = p;
+	double tau = 1000. / T;
+	Derivatives<> g = region5_gibbs(pi, tau);
+
+	gibbs_properties(g, p, T, pi, tau, out);
+	gibbs_volume_derivatives(g, p, T, pi, tau, out.v, dv);
+}
+
+void if97::region3(double rho, double T, PropertySet& out)
+{
+	kernels::region3(rho, T, out);
+}
+
+void if97::region3(double rho, double T, PropertySet& out,
+		VolumeDerivatives& dv)
+{
+	double delta = rho / 322.;
+	double tau = 647.096 / T;
+	Derivatives<> f = region3_helmholtz(delta, tau);
+
+	helmholtz_properties(f, rho, T, delta, tau, out);
+
+	double a = delta * f.fa - delta * tau * f.fat;
+	double b = 2. * delta * f.fa + delta * delta * f.faa;
+
+	// from (dp/drho)_T = RTb and (dp/dT)_rho = rho R a
+	dv.dvdT = a / (rho * T * b);
+	dv.dvdp = -1000. / (rho * rho * R * T * b);
+}
+
+double if97::psat(double T)
+{
+	const double* n = region4_coeffs;
+
+	double theta = T + n[8] / (T - n[9]);
+	double A = theta * theta + n[0] * theta + n[1];
+	double B = n[2] * theta * theta + n[3] * theta + n[4];
+	double C = n[5] * theta * theta + n[6] * theta + n[7];
+	double ret = 2. * C / (-B + std::sqrt(B * B - 4. * A * C));
+
+	return ret * ret * ret * ret;
+}
+
+double if97::dpsat_dT(double T)
+{
+	const double* n = region4_coeffs;
+
+	double theta = T + n[8] / (T - n[9]);
+	double A = theta * theta + n[0] * theta + n[1];
+	double B = n[2] * theta * theta + n[3] * theta + n[4];
+	double C = n[5] * theta * theta + n[6] * theta + n[7];
+	double beta = 2. * C / (-B + std::sqrt(B * B - 4. * A * C));
+
+	// differentiate A beta² + B beta + C = 0 implicitly
+	double dA = 2. * theta + n[0];
+	double dB = 2. * n[2] * theta + n[3];
+	double dC = 2. * n[5] * theta + n[6];
+	double dbeta = -(dA * beta * beta + dB * beta + dC)
+		/ (2. * A * beta + B);
+	double dtheta = 1. - n[8] / ((T - n[9]) * (T - n[9]));
+
+	return 4. * beta * beta * beta * dbeta * dtheta;
+}
+
+double if97::Tsat(double p)
+{
+	const double* n = region4_coeffs;
+
+	double beta = std::pow(p, 0.25);
+	double E = beta * beta + n[2] * beta + n[5];
+	double F = n[0] * beta * beta + n[3] * beta + n[6];
+	double G = n[1] * beta * beta + n[4] * beta + n[7];
+	double D = 2. * G / (-F - std::sqrt(F * F - 4. * E * G));
+
+	return (n[9] + D - std::sqrt((n[9] + D) * (n[9] + D)
+				- 4. * (n[8] + n[9] * D))) / 2.;
+}
+
+double if97::pB23(double T)
+{
+	const double* n = b23_coeffs;
+
+	return n[0] + n[1] * T + n[2] * T * T;
+}
+
+double if97::TB23(double p)
+{
+	const double* n = b23_coeffs;
+
+	return n[3] + std::sqrt((p - n[4]) / n[2]);
+}
+
+if97::backward_type if97::backward_ph(Region region, double p, double h)
+{
+	switch (region)
+	{
+		case Region::R1:
+			return BACKWARD_1;
+		case Region::R2:
+			if (p <= 4.)
+				return BACKWARD_2A;
+			// the 2b-2c boundary
+			return p < 0.90584278514723E3 - 0.67955786399241 * h
+				+ 0.12809002730136E-3 * h * h
+				? BACKWARD_2B : BACKWARD_2C;
+		case Region::R3:
+			// the 3a-3b boundary
+			return h <= 0.201464004206875E4 + 0.374696550136983E1 * p
+				- 0.219921901054187E-1 * p * p
+				+ 0.875131686009950E-4 * p * p * p
+				? BACKWARD_3A : BACKWARD_3B;
+		case Region::R4:
+			return BACKWARD_4;
+		case Region::R5:
+			return BACKWARD_5;
+		default:
+			assert(not_reached);
+			return BACKWARD_1;
+	}
+}
+
+if97::backward_type if97::backward_ps(Region region, double p, double s)
+{
+	switch (region)
+	{
+		case Region::R1:
+			return BACKWARD_1;
+		case Region::R2:
+			if (p <= 4.)
+				return BACKWARD_2A;
+			return s >= 5.85 ? BACKWARD_2B : BACKWARD_2C;
+		case Region::R3:
+			return s <= 4.41202148223476 ? BACKWARD_3A : BACKWARD_3B;
+		case Region::R4:
+			return BACKWARD_4;
+		case Region::R5:
+			return BACKWARD_5;
+		default:
+			assert(not_reached);
+			return BACKWARD_1;
+	}
+}
+
+PropertySet if97::properties(const internals::h2o_t& st)
+{
+	PropertySet ret;
+
+	assert(st.region != internals::H2O_REGION_OUT_OF_RANGE);
+
+	ret.p = h2o_get_p(st);
+	ret.T = h2o_get_T(st);
+
+	switch (st.region)
+	{
+		case internals::H2O_REGION1:
+			ret.x = 0.;
+			region1(ret.p, ret.T, ret);
+			break;
+		case internals::H2O_REGION2:
+			ret.x = 1.;
+			region2(ret.p, ret.T, ret);
+			break;
+		case internals::H2O_REGION3:
+			ret.x = std::numeric_limits<double>::quiet_NaN();
+			region3(h2o_get_rho(st), ret.T, ret);
+			break;
+		case internals::H2O_REGION4:
+			ret.x = h2o_get_x(st);
+			// below 623.15 K, both saturation lines are in regions
+			// 1 & 2; above it, they are in region 3, and finding them
+			// requires iteration -- leave that to libh2o
+			if (ret.T <= 623.15)
+			{
+				PropertySet liq, vap;
+
+				region1(ret.p, ret.T, liq);
+				region2(ret.p, ret.T, vap);
+
+				ret.v = liq.v + ret.x * (vap.v - liq.v);
+				ret.rho = 1. / ret.v;
+				ret.u = liq.u + ret.x * (vap.u - liq.u);
+				ret.h = liq.h + ret.x * (vap.h - liq.h);
+				ret.s = liq.s + ret.x * (vap.s - liq.s);
+			}
+			else
+			{
+				ret.rho = h2o_get_rho(st);
+				ret.v = h2o_get_v(st);
+				ret.u = h2o_get_u(st);
+				ret.h = h2o_get_h(st);
+				ret.s = h2o_get_s(st);
+			}
+			ret.cp = h2o_get_cp(st);
+			ret.cv = h2o_get_cv(st);
+			ret.w = h2o_get_w(st);
+			break;
+		case internals::H2O_REGION5:
+			ret.x = 1.;
+			region5(ret.p, ret.T, ret);
+			break;
+		default:
+			assert(not_reached);
+	}
+
+	return ret;
+}
+
+namespace
+{
+	/**
+	 * The first derivatives of all the properties with respect
+	 * to a pair of independent variables, indexed by property::type.
+	 * The pair is (T,p) for single-phase state points, and (T,x)
+	 * in region 4.
+	 */
+	struct Differentials
+	{
+		double a[property::s + 1];
+		double b[property::s + 1];
+	};
+}
+
+/**
+ * Get the differentials of a single-phase state point, in terms
+ * of (T,p). 1000 is the MPa·m³/kg to kJ/kg factor.
+ */
+static Differentials differentials(double p, double T,
+		const PropertySet& ps, const if97::VolumeDerivatives& dv)
+{
+	Differentials ret;
+
+	ret.a[property::p] = 0.;
+	ret.b[property::p] = 1.;
+	ret.a[property::T] = 1.;
+	ret.b[property::T] = 0.;
+	ret.a[property::v] = dv.dvdT;
+	ret.b[property::v] = dv.dvdp;
+	ret.a[property::u] = ps.cp - p * dv.dvdT * 1000.;
+	ret.b[property::u] = -(T * dv.dvdT + p * dv.dvdp) * 1000.;
+	ret.a[property::h] = ps.cp;
+	ret.b[property::h] = (ps.v - T * dv.dvdT) * 1000.;
+	ret.a[property::s] = ps.cp / T;
+	ret.b[property::s] = -dv.dvdT * 1000.;
+
+	return ret;
+}
+
+/**
+ * Get the differentials of a two-phase state point, in terms of (T,x).
+ */
+static Differentials two_phase_differentials(const internals::h2o_t& st)
+{
+	double p = h2o_get_p(st);
+	double T = h2o_get_T(st);
+	double x = h2o_get_x(st);
+
+	PropertySet liq, vap;
+	if97::VolumeDerivatives liq_dv, vap_dv;
+
+	// see properties() for the saturated states above 623.15 K
+	if (T <= 623.15)
+	{
+		if97::region1(p, T, liq, liq_dv);
+		if97::region2(p, T, vap, vap_dv);
+	}
+	else
+	{
+		if97::region3(h2o_get_rho(internals::h2o_new_Tx(T, 0.)), T,
+				liq, liq_dv);
+		if97::region3(h2o_get_rho(internals::h2o_new_Tx(T, 1.)), T,
+				vap, vap_dv);
+	}
+
+	Differentials dliq = differentials(p, T, liq, liq_dv);
+	Differentials dvap = differentials(p, T, vap, vap_dv);
+	// rho is derived from v afterwards
+	double liq_values[] = { p, T, 0., liq.v, liq.u, liq.h, liq.s };
+	double vap_values[] = { p, T, 0., vap.v, vap.u, vap.h, vap.s };
+
+	double dpdT = if97::dpsat_dT(T);
+
+	Differentials ret;
+
+	for (int i = property::p; i <= property::s; ++i)
+	{
+		// along the saturation lines
+		double liq_dT = dliq.a[i] + dliq.b[i] * dpdT;
+		double vap_dT = dvap.a[i] + dvap.b[i] * dpdT;
+
+		ret.a[i] = liq_dT + x * (vap_dT - liq_dT);
+		ret.b[i] = vap_values[i] - liq_values[i];
+	}
+
+	return ret;
+}
+
+double if97::derivative(const internals::h2o_t& st, property::type x,
+		property::type y, property::type z)
+{
+	Differentials d;
+	PropertySet ps;
+	VolumeDerivatives dv;
+	double p = h2o_get_p(st);
+	double T = h2o_get_T(st);
+
+	assert(st.region != internals::H2O_REGION_OUT_OF_RANGE);
+
+	switch (st.region)
+	{
+		case internals::H2O_REGION1:
+			region1(p, T, ps, dv);
+			d = differentials(p, T, ps, dv);
+			break;
+		case internals::H2O_REGION2:
+			region2(p, T, ps, dv);
+			d = differentials(p, T, ps, dv);
+			break;
+		case internals::H2O_REGION3:
+			region3(h2o_get_rho(st), T, ps, dv);
+			d = differentials(p, T, ps, dv);
+			break;
+		case internals::H2O_REGION4:
+			// p and T are not independent in the two-phase region
+			if ((y == property::p || y == property::T)
+					&& (z == property::p || z == property::T))
+				return std::numeric_limits<double>::quiet_NaN();
+
+			d = two_phase_differentials(st);
+			ps.v = h2o_get_v(st);
+			break;
+		case internals::H2O_REGION5:
+			region5(p, T, ps, dv);
+			d = differentials(p, T, ps, dv);
+			break;
+		default:
+			assert(not_reached);
+	}
+
+	// drho = -rho² dv
+	d.a[property::rho] = -d.a[property::v] / (ps.v * ps.v);
+	d.b[property::rho] = -d.b[property::v] / (ps.v * ps.v);
+
+	// (dx/dy)_z = d(x,z)/d(y,z), with the Jacobians in terms
+	// of the independent variables
+	return (d.a[x] * d.b[z] - d.b[x] * d.a[z])
+		/ (d.a[y] * d.b[z] - d.b[y] * d.a[z]);
+}
@@ -0,0 +1,102 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#pragma once
+
+#ifndef _H2O_IF97_HXX
+#define _H2O_IF97_HXX 1
+
+#include "h2o"
+
+namespace h2o
+{
+	/**
+	 * Native evaluation of the IAPWS-IF97 basic equations.
+	 *
+	 * These functions evaluate the basic equation of a region once,
+	 * along with all its derivatives, and fill in v, u, h, s, cp,
+	 * cv and w (and rho & p in region 3) in @out. The remaining
+	 * fields are left untouched.
+	 *
+	 * This is an internal interface. The arguments are not checked
+	 * against the region boundaries.
+	 */
+	namespace if97
+	{
+		void region1(double p, double T, PropertySet& out);
+		void region2(double p, double T, PropertySet& out);
+		void region3(double rho, double T, PropertySet& out);
+		void region5(double p, double T, PropertySet& out);
+
+		/**
+		 * The partial derivatives of the specific volume,
+		 * (dv/dT)_p [m³/kgK] and (dv/dp)_T [m³/kgMPa]. Along with cp,
+		 * they determine all the first derivatives of a single-phase
+		 * state point.
+		 */
+		struct VolumeDerivatives
+		{
+			double dvdT;
+			double dvdp;
+		};
+
+		void region1(double p, double T, PropertySet& out,
+				VolumeDerivatives& dv);
+		void region2(double p, double T, PropertySet& out,
+				VolumeDerivatives& dv);
+		void region3(double rho, double T, PropertySet& out,
+				VolumeDerivatives& dv);
+		void region5(double p, double T, PropertySet& out,
+				VolumeDerivatives& dv);
+
+		/**
+		 * Region boundaries: the saturation line (region 4)
+		 * and the region 2-3 boundary (B23).
+		 */
+		double psat(double T);
+		double Tsat(double p);
+		double dpsat_dT(double T);
+		double pB23(double T);
+		double TB23(double p);
+
+		/**
+		 * The equations used by the backward functions T(p,h)
+		 * and T(p,s) in a region: the subregions 2a to 2c
+		 * and 3a & 3b. The other regions have a single one.
+		 */
+		typedef enum
+		{
+			BACKWARD_1,
+			BACKWARD_2A,
+			BACKWARD_2B,
+			BACKWARD_2C,
+			BACKWARD_3A,
+			BACKWARD_3B,
+			BACKWARD_4,
+			BACKWARD_5
+		} backward_type;
+
+		/**
+		 * Get the backward equation for a state point in @region.
+		 */
+		backward_type backward_ph(Region region, double p, double h);
+		backward_type backward_ps(Region region, double p, double s);
+
+		/**
+		 * Get all the properties of a libh2o state point. The state
+		 * point must not be out-of-range.
+		 */
+		PropertySet properties(const internals::h2o_t& st);
+
+		/**
+		 * Get the partial derivative (dx/dy)_z at a libh2o state
+		 * point. The state point must not be out-of-range.
+		 */
+		double derivative(const internals::h2o_t& st, property::type x,
+				property::type y, property::type z);
+	}
+}
+
+#endif /*_H2O_IF97_HXX*/
@@ -0,0 +1,571 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#pragma once
+
+#ifndef _H2O_IF97_KERNELS_HXX
+#define _H2O_IF97_KERNELS_HXX 1
+
+#include <cstddef>
+#include <cmath>
+
+#include "h2o"
+
+namespace h2o
+{
+	namespace if97
+	{
+		/**
+		 * The basic equation kernels.
+		 *
+		 * The basic equations of regions 1, 2, 3 and 5, inlined into
+		 * the callers and templated over the floating-point type.
+		 * The type can be also a SIMD vector type (see simd.hxx),
+		 * providing the arithmetic operators, log() and sqrt().
+		 * Instead of calling pow() for every term,
+		 * all the integer powers of a reduced argument are built once
+		 * per state point (a 'power ladder') and shared by the terms
+		 * and their derivatives. The ladder bounds are obtained from
+		 * the coefficient tables at compile time.
+		 */
+		namespace kernels
+		{
+			// specific gas constant [kJ/kgK]
+			static constexpr double R = 0.461526;
+
+			struct Term
+			{
+				int I, J;
+				double n;
+			};
+
+			static constexpr Term region1_terms[] =
+			{
+				{ 0, -2, 0.14632971213167 },
+				{ 0, -1, -0.84548187169114 },
+				{ 0, 0, -0.37563603672040E1 },
+				{ 0, 1, 0.33855169168385E1 },
+				{ 0, 2, -0.95791963387872 },
+				{ 0, 3, 0.15772038513228 },
+				{ 0, 4, -0.16616417199501E-1 },
+				{ 0, 5, 0.81214629983568E-3 },
+				{ 1, -9, 0.28319080123804E-3 },
+				{ 1, -7, -0.60706301565874E-3 },
+				{ 1, -1, -0.18990068218419E-1 },
+				{ 1, 0, -0.32529748770505E-1 },
+				{ 1, 1, -0.21841717175414E-1 },
+				{ 1, 3, -0.52838357969930E-4 },
+				{ 2, -3, -0.47184321073267E-3 },
+				{ 2, 0, -0.30001780793026E-3 },
+				{ 2, 1, 0.47661393906987E-4 },
+				{ 2, 3, -0.44141845330846E-5 },
+				{ 2, 17, -0.72694996297594E-15 },
+				{ 3, -4, -0.31679644845054E-4 },
+				{ 3, 0, -0.28270797985312E-5 },
+				{ 3, 6, -0.85205128120103E-9 },
+				{ 4, -5, -0.22425281908000E-5 },
+				{ 4, -2, -0.65171222895601E-6 },
+				{ 4, 10, -0.14341729937924E-12 },
+				{ 5, -8, -0.40516996860117E-6 },
+				{ 8, -11, -0.12734301741641E-8 },
+				{ 8, -6, -0.17424871230634E-9 },
+				{ 21, -29, -0.68762131295531E-18 },
+				{ 23, -31, 0.14478307828521E-19 },
+				{ 29, -38, 0.26335781662795E-22 },
+				{ 30, -39, -0.11947622640071E-22 },
+				{ 31, -40, 0.18228094581404E-23 },
+				{ 32, -41, -0.93537087292458E-25 }
+			};
+
+			static constexpr Term region2_ideal_terms[] =
+			{
+				{ 0, 0, -0.96927686500217E1 },
+				{ 0, 1, 0.10086655968018E2 },
+				{ 0, -5, -0.56087911283020E-2 },
+				{ 0, -4, 0.71452738081455E-1 },
+				{ 0, -3, -0.40710498223928 },
+				{ 0, -2, 0.14240819171444E1 },
+				{ 0, -1, -0.43839511319450E1 },
+				{ 0, 2, -0.28408632460772 },
+				{ 0, 3, 0.21268463753307E-1 }
+			};
+
+			static constexpr Term region2_residual_terms[] =
+			{
+				{ 1, 0, -0.17731742473213E-2 },
+				{ 1, 1, -0.17834862292358E-1 },
+				{ 1, 2, -0.45996013696365E-1 },
+				{ 1, 3, -0.57581259083432E-1 },
+				{ 1, 6, -0.50325278727930E-1 },
+				{ 2, 1, -0.33032641670203E-4 },
+				{ 2, 2, -0.18948987516315E-3 },
+				{ 2, 4, -0.39392777243355E-2 },
+				{ 2, 7, -0.43797295650573E-1 },
+				{ 2, 36, -0.26674547914087E-4 },
+				{ 3, 0, 0.20481737692309E-7 },
+				{ 3, 1, 0.43870667284435E-6 },
+				{ 3, 3, -0.32277677238570E-4 },
+				{ 3, 6, -0.15033924542148E-2 },
+				{ 3, 35, -0.40668253562649E-1 },
+				{ 4, 1, -0.78847309559367E-9 },
+				{ 4, 2, 0.12790717852285E-7 },
+				{ 4, 3, 0.48225372718507E-6 },
+				{ 5, 7, 0.22922076337661E-5 },
+				{ 6, 3, -0.16714766451061E-10 },
+				{ 6, 16, -0.21171472321355E-2 },
+				{ 6, 35, -0.23895741934104E2 },
+				{ 7, 0, -0.59059564324270E-17 },
+				{ 7, 11, -0.12621808899101E-5 },
+				{ 7, 25, -0.38946842435739E-1 },
+				{ 8, 8, 0.11256211360459E-10 },
+				{ 8, 36, -0.82311340897998E1 },
+				{ 9, 13, 0.19809712802088E-7 },
+				{ 10, 4, 0.10406965210174E-18 },
+				{ 10, 10, -0.10234747095929E-12 },
+				{ 10, 14, -0.10018179379511E-8 },
+				{ 16, 29, -0.80882908646985E-10 },
+				{ 16, 50, 0.10693031879409 },
+				{ 18, 57, -0.33662250574171 },
+				{ 20, 20, 0.89185845355421E-24 },
+				{ 20, 35, 0.30629316876232E-12 },
+				{ 20, 48, -0.42002467698208E-5 },
+				{ 21, 21, -0.59056029685639E-25 },
+				{ 22, 53, 0.37826947613457E-5 },
+				{ 23, 39, -0.12768608934681E-14 },
+				{ 24, 26, 0.73087610595061E-28 },
+				{ 24, 40, 0.55414715350778E-16 },
+				{ 24, 58, -0.94369707241210E-6 }
+			};
+
+			static constexpr Term region5_ideal_terms[] =
+			{
+				{ 0, 0, -0.13179983674201E2 },
+				{ 0, 1, 0.68540841634434E1 },
+				{ 0, -3, -0.24805148933466E-1 },
+				{ 0, -2, 0.36901534980333 },
+				{ 0, -1, -0.31161318213925E1 },
+				{ 0, 2, -0.32961626538917 }
+			};
+
+			static constexpr Term region5_residual_terms[] =
+			{
+				{ 1, 1, 0.15736404855259E-2 },
+				{ 1, 2, 0.90153761673944E-3 },
+				{ 1, 3, -0.50270077677648E-2 },
+				{ 2, 3, 0.22440037409485E-5 },
+				{ 2, 9, -0.41163275453471E-5 },
+				{ 3, 7, 0.37919454822955E-7 }
+			};
+
+			static constexpr double region3_n1 = 0.10658070028513E1;
+
+			static constexpr Term region3_terms[] =
+			{
+				{ 0, 0, -0.15732845290239E2 },
+				{ 0, 1, 0.20944396974307E2 },
+				{ 0, 2, -0.76867707878716E1 },
+				{ 0, 7, 0.26185947787954E1 },
+				{ 0, 10, -0.28080781148620E1 },
+				{ 0, 12, 0.12053369696517E1 },
+				{ 0, 23, -0.84566812812502E-2 },
+				{ 1, 2, -0.12654315477714E1 },
+				{ 1, 6, -0.11524407806681E1 },
+				{ 1, 15, 0.88521043984318 },
+				{ 1, 17, -0.64207765181607 },
+				{ 2, 0, 0.38493460186671 },
+				{ 2, 2, -0.85214708824206 },
+				{ 2, 6, 0.48972281541877E1 },
+				{ 2, 7, -0.30502617256965E1 },
+				{ 2, 22, 0.39420536879154E-1 },
+				{ 2, 26, 0.12558408424308 },
+				{ 3, 0, -0.27999329698710 },
+				{ 3, 2, 0.13899799569460E1 },
+				{ 3, 4, -0.20189915023570E1 },
+				{ 3, 16, -0.82147637173963E-2 },
+				{ 3, 26, -0.47596035734923 },
+				{ 4, 0, 0.43984074473500E-1 },
+				{ 4, 2, -0.44476435428739 },
+				{ 4, 4, 0.90572070719733 },
+				{ 4, 26, 0.70522450087967 },
+				{ 5, 1, 0.10770512626332 },
+				{ 5, 3, -0.32913623258954 },
+				{ 5, 26, -0.50871062041158 },
+				{ 6, 0, -0.22175400873096E-1 },
+				{ 6, 2, 0.94260751665092E-1 },
+				{ 6, 26, 0.16436278447961 },
+				{ 7, 2, -0.13503372241348E-1 },
+				{ 8, 26, -0.14834345352472E-1 },
+				{ 9, 2, 0.57922953628084E-3 },
+				{ 9, 26, 0.32308904703711E-2 },
+				{ 10, 0, 0.80964802996215E-4 },
+				{ 10, 1, -0.16557679795037E-3 },
+				{ 11, 26, -0.44923899061815E-4 }
+			};
+
+			/**
+			 * The smallest and largest I (J) exponent in a table.
+			 */
+			template <size_t N>
+			constexpr int min_I(const Term (&t)[N], size_t i = 0,
+					int acc = 0)
+			{
+				return i == N ? acc
+					: min_I(t, i + 1, i == 0 || t[i].I < acc ? t[i].I : acc);
+			}
+
+			template <size_t N>
+			constexpr int max_I(const Term (&t)[N], size_t i = 0,
+					int acc = 0)
+			{
+				return i == N ? acc
+					: max_I(t, i + 1, i == 0 || t[i].I > acc ? t[i].I : acc);
+			}
+
+			template <size_t N>
+			constexpr int min_J(const Term (&t)[N], size_t i = 0,
+					int acc = 0)
+			{
+				return i == N ? acc
+					: min_J(t, i + 1, i == 0 || t[i].J < acc ? t[i].J : acc);
+			}
+
+			template <size_t N>
+			constexpr int max_J(const Term (&t)[N], size_t i = 0,
+					int acc = 0)
+			{
+				return i == N ? acc
+					: max_J(t, i + 1, i == 0 || t[i].J > acc ? t[i].J : acc);
+			}
+
+			/**
+			 * The lowest power needed for the second derivatives
+			 * of x^k, k >= @min. The derivatives of x^0 and x^1 do not
+			 * need negative powers.
+			 */
+			constexpr int ladder_min(int min)
+			{
+				return min < 0 || min >= 2 ? min - 2 : 0;
+			}
+
+			/**
+			 * All the integer powers x^Min ... x^Max, obtained
+			 * by repeated multiplication.
+			 */
+			template <int Min, int Max, class Real = double>
+			class PowerLadder
+			{
+				Real _pow[Max - Min + 1];
+
+			public:
+				PowerLadder(Real x)
+				{
+					Real xk = 1;
+
+					for (int k = 0; k <= Max; ++k, xk *= x)
+						if (k >= Min)
+							_pow[k - Min] = xk;
+
+					if (Min < 0)
+					{
+						Real inv = 1 / x;
+
+						xk = inv;
+						for (int k = -1; k >= Min; --k, xk *= inv)
+							if (k <= Max)
+								_pow[k - Min] = xk;
+					}
+				}
+
+				Real operator[](int k) const
+				{
+					return _pow[k - Min];
+				}
+			};
+
+			/**
+			 * Coefficient scaling for sum_terms(). The region 2 residual
+			 * part is summed over pi/10 rather than pi, with the n
+			 * coefficients scaled by 10^I, so that pi^I does not
+			 * overflow single precision at high pressures. The y^J powers
+			 * are then split (see times_power()), since a subnormal y^J
+			 * may be significant next to a large x^I.
+			 */
+			struct Unscaled
+			{
+				static constexpr bool decimal = false;
+			};
+
+			struct Decimal
+			{
+				static constexpr bool decimal = true;
+			};
+
+			static constexpr double decimal_powers[] =
+			{
+				1E0, 1E1, 1E2, 1E3, 1E4, 1E5, 1E6, 1E7, 1E8, 1E9,
+				1E10, 1E11, 1E12, 1E13, 1E14, 1E15, 1E16, 1E17,
+				1E18, 1E19, 1E20, 1E21, 1E22, 1E23, 1E24
+			};
+
+			/**
+			 * A dimensionless function of two reduced arguments along
+			 * with its first and second derivatives. For the Gibbs free
+			 * energy (regions 1, 2 and 5), the arguments are (pi, tau);
+			 * for the Helmholtz free energy (region 3), they are
+			 * (delta, tau).
+			 */
+			template <class Real = double>
+			struct Derivatives
+			{
+				Real f;
+				Real fa, faa;
+				Real ft, ftt;
+				Real fat;
+			};
+
+			/**
+			 * Multiply @a by y^k. With @split, y^k is applied in two
+			 * halves, so that the intermediate result stays normal
+			 * while a * y^k does.
+			 */
+			template <class Ladder, class Real>
+			inline Real times_power(Real a, const Ladder& yp, int k,
+					bool split)
+			{
+				return split ? (a * yp[k / 2]) * yp[k - k / 2] : a * yp[k];
+			}
+
+			/**
+			 * Sum up n * x^I * y^J, and its derivatives, using
+			 * the power ladders @xp and @yp. @dxda is the derivative
+			 * of x over the first reduced argument (the derivative of y
+			 * over tau is always 1). With @Scale = Decimal, n is
+			 * multiplied by 10^I.
+			 */
+			template <class Scale = Unscaled, size_t N, class Real,
+					class XLadder, class YLadder>
+			inline void sum_terms(Derivatives<Real>& out,
+					const Term (&terms)[N], const XLadder& xp,
+					const YLadder& yp, Real dxda)
+			{
+				for (size_t i = 0; i < N; ++i)
+				{
+					const Term& c = terms[i];
+
+					Real n = static_cast<Real>(Scale::decimal
+							? c.n * decimal_powers[c.I] : c.n);
+					Real xi = xp[c.I];
+					Real xi1 = c.I ? c.I * xp[c.I - 1] * dxda : 0;
+					Real xi2 = c.I > 1
+						? c.I * (c.I - 1) * xp[c.I - 2] * dxda * dxda : 0;
+					Real j1 = c.J;
+					Real j2 = c.J * (c.J - 1);
+					const bool split = Scale::decimal;
+
+					// the powers first, so that a large scaled n does not
+					// overflow when the term is negligible
+					out.f += n * times_power(xi, yp, c.J, split);
+					out.fa += n * times_power(xi1, yp, c.J, split);
+					out.faa += n * times_power(xi2, yp, c.J, split);
+					if (c.J)
+					{
+						out.ft += n * j1 * times_power(xi, yp, c.J - 1, split);
+						out.fat += n * j1
+							* times_power(xi1, yp, c.J - 1, split);
+					}
+					if (c.J && c.J != 1)
+						out.ftt += n * j2
+							* times_power(xi, yp, c.J - 2, split);
+				}
+			}
+
+			/**
+			 * The ideal-gas part of the Gibbs equation for regions
+			 * 2 & 5. The ideal-gas terms have I = 0, so only a tau
+			 * ladder is needed.
+			 */
+			template <size_t N, class Real, class Ladder>
+			inline Derivatives<Real> ideal_gas(const Term (&terms)[N],
+					Real pi, const Ladder& taup)
+			{
+				Derivatives<Real> g = { 0, 0, 0, 0, 0, 0 };
+
+				for (size_t i = 0; i < N; ++i)
+				{
+					const Term& c = terms[i];
+					Real n = static_cast<Real>(c.n);
+
+					g.f += n * taup[c.J];
+					if (c.J)
+						g.ft += n * c.J * taup[c.J - 1];
+					if (c.J && c.J != 1)
+						g.ftt += n * c.J * (c.J - 1) * taup[c.J - 2];
+				}
+
+				using std::log;
+
+				g.f += log(pi);
+				g.fa = 1 / pi;
+				g.faa = -1 / (pi * pi);
+
+				return g;
+			}
+
+			template <class Real>
+			inline Derivatives<Real> region1_gibbs(Real pi, Real tau)
+			{
+				Derivatives<Real> g = { 0, 0, 0, 0, 0, 0 };
+				PowerLadder<ladder_min(min_I(region1_terms)),
+					max_I(region1_terms), Real> pip(Real(7.1) - pi);
+				PowerLadder<ladder_min(min_J(region1_terms)),
+					max_J(region1_terms), Real> taup(tau - Real(1.222));
+
+				sum_terms(g, region1_terms, pip, taup, Real(-1));
+				return g;
+			}
+
+			template <class Real>
+			inline Derivatives<Real> region2_gibbs(Real pi, Real tau)
+			{
+				PowerLadder<ladder_min(min_J(region2_ideal_terms)),
+					max_J(region2_ideal_terms), Real> idealp(tau);
+				Derivatives<Real> g = ideal_gas(region2_ideal_terms, pi,
+						idealp);
+				PowerLadder<ladder_min(min_I(region2_residual_terms)),
+					max_I(region2_residual_terms), Real> pip(pi / 10);
+				PowerLadder<ladder_min(min_J(region2_residual_terms)),
+					max_J(region2_residual_terms), Real> taup(tau - Real(0.5));
+
+				sum_terms<Decimal>(g, region2_residual_terms, pip, taup,
+						Real(0.1));
+				return g;
+			}
+
+			template <class Real>
+			inline Derivatives<Real> region5_gibbs(Real pi, Real tau)
+			{
+				PowerLadder<ladder_min(min_J(region5_ideal_terms)),
+					max_J(region5_ideal_terms), Real> idealp(tau);
+				Derivatives<Real> g = ideal_gas(region5_ideal_terms, pi,
+						idealp);
+				PowerLadder<ladder_min(min_I(region5_residual_terms)),
+					max_I(region5_residual_terms), Real> pip(pi);
+				PowerLadder<ladder_min(min_J(region5_residual_terms)),
+					max_J(region5_residual_terms), Real> taup(tau);
+
+				sum_terms(g, region5_residual_terms, pip, taup, Real(1));
+				return g;
+			}
+
+			template <class Real>
+			inline Derivatives<Real> region3_helmholtz(Real delta, Real tau)
+			{
+				Derivatives<Real> f = { 0, 0, 0, 0, 0, 0 };
+				PowerLadder<ladder_min(min_I(region3_terms)),
+					max_I(region3_terms), Real> deltap(delta);
+				PowerLadder<ladder_min(min_J(region3_terms)),
+					max_J(region3_terms), Real> taup(tau);
+				Real n1 = static_cast<Real>(region3_n1);
+
+				using std::log;
+
+				sum_terms(f, region3_terms, deltap, taup, Real(1));
+				f.f += n1 * log(delta);
+				f.fa += n1 / delta;
+				f.faa -= n1 / (delta * delta);
+				return f;
+			}
+
+			/**
+			 * Fill in v, rho, u, h, s, cp, cv and w from the Gibbs
+			 * equation. @Out is either a PropertySet or a BasicPropertySet.
+			 */
+			template <class Real, class Out>
+			inline void gibbs_properties(const Derivatives<Real>& g, Real p,
+					Real T, Real pi, Real tau, Out& out)
+			{
+				using std::sqrt;
+
+				const Real R_ = static_cast<Real>(R);
+				Real a = g.fa - tau * g.fat;
+
+				out.v = pi * g.fa * R_ * T / p / 1000;
+				out.rho = 1 / out.v;
+				out.u = R_ * T * (tau * g.ft - pi * g.fa);
+				out.h = R_ * T * tau * g.ft;
+				out.s = R_ * (tau * g.ft - g.f);
+				out.cp = -R_ * tau * tau * g.ftt;
+				out.cv = R_ * (-tau * tau * g.ftt + a * a / g.faa);
+				out.w = sqrt(R_ * T * 1000 * g.fa * g.fa
+						/ (a * a / (tau * tau * g.ftt) - g.faa));
+			}
+
+			/**
+			 * Fill in p, rho, v, u, h, s, cp, cv and w from the Helmholtz
+			 * equation.
+			 */
+			template <class Real, class Out>
+			inline void helmholtz_properties(const Derivatives<Real>& f,
+					Real rho, Real T, Real delta, Real tau, Out& out)
+			{
+				using std::sqrt;
+
+				const Real R_ = static_cast<Real>(R);
+				Real a = delta * f.fa - delta * tau * f.fat;
+				Real b = 2 * delta * f.fa + delta * delta * f.faa;
+
+				out.p = rho * R_ * T * delta * f.fa / 1000;
+				out.rho = rho;
+				out.v = 1 / rho;
+				out.u = R_ * T * tau * f.ft;
+				out.h = R_ * T * (tau * f.ft + delta * f.fa);
+				out.s = R_ * (tau * f.ft - f.f);
+				out.cv = -R_ * tau * tau * f.ftt;
+				out.cp = R_ * (-tau * tau * f.ftt + a * a / b);
+				out.w = sqrt(R_ * T * 1000
+						* (b - a * a / (tau * tau * f.ftt)));
+			}
+
+			template <class Real, class Out>
+			inline void region1(Real p, Real T, Out& out)
+			{
+				Real pi = p / Real(16.53);
+				Real tau = Real(1386) / T;
+
+				gibbs_properties(region1_gibbs(pi, tau), p, T, pi, tau, out);
+			}
+
+			template <class Real, class Out>
+			inline void region2(Real p, Real T, Out& out)
+			{
+				Real pi = p;
+				Real tau = Real(540) / T;
+
+				gibbs_properties(region2_gibbs(pi, tau), p, T, pi, tau, out);
+			}
+
+			template <class Real, class Out>
+			inline void region3(Real rho, Real T, Out& out)
+			{
+				Real delta = rho / Real(322);
+				Real tau = Real(647.096) / T;
+
+				helmholtz_properties(region3_helmholtz(delta, tau), rho, T,
+						delta, tau, out);
+			}
+
+			template <class Real, class Out>
+			inline void region5(Real p, Real T, Out& out)
+			{
+				Real pi = p;
+				Real tau = Real(1000) / T;
+
+				gibbs_properties(region5_gibbs(pi, tau), p, T, pi, tau, out);
+			}
+		}
+	}
+}
+
+#endif /*_H2O_IF97_KERNELS_HXX*/
@@ -0,0 +1,312 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include <cassert>
+#include <cstring>
+
+#ifdef H2OXX_INSTRUMENTATION
+#	include <algorithm>
+#	include <atomic>
+#	include <mutex>
+#	include <new>
+#	include <vector>
+#endif
+
+#include "instrumentation.hxx"
+
+using namespace h2o;
+using namespace h2o::instrumentation;
+
+static const bool not_reached = false; // for assert()
+
+uint64_t Counters::total() const
+{
+	uint64_t ret = 0;
+
+	for (size_t i = 0; i < 6; ++i)
+		ret += calls[i];
+	return ret;
+}
+
+double Counters::out_of_range_rate() const
+{
+	uint64_t n = total();
+
+	return n ? static_cast<double>(calls[Region::OOR]) / n : 0.;
+}
+
+const char* instrumentation::name(operation_type op)
+{
+	switch (op)
+	{
+		case CONSTRUCT_PT:
+			return "H2O::pT";
+		case CONSTRUCT_TX:
+			return "H2O::Tx";
+		case CONSTRUCT_PX:
+			return "H2O::px";
+		case CONSTRUCT_PH:
+			return "H2O::ph";
+		case CONSTRUCT_PS:
+			return "H2O::ps";
+		case CONSTRUCT_HS:
+			return "H2O::hs";
+		case CONSTRUCT_RHOT:
+			return "H2O::rhoT";
+		case CONSTRUCT_RHOU:
+			return "H2O::rhou";
+		case GET_P:
+			return "H2O::p";
+		case GET_T:
+			return "H2O::T";
+		case GET_X:
+			return "H2O::x";
+		case GET_RHO:
+			return "H2O::rho";
+		case GET_V:
+			return "H2O::v";
+		case GET_U:
+			return "H2O::u";
+		case GET_H:
+			return "H2O::h";
+		case GET_S:
+			return "H2O::s";
+		case GET_CP:
+			return "H2O::cp";
+		case GET_CV:
+			return "H2O::cv";
+		case GET_W:
+			return "H2O::w";
+		case GET_PROPERTIES:
+			return "H2O::properties";
+		case GET_DERIVATIVE:
+			return "H2O::derivative";
+		case EXPAND:
+			return "H2O::expand";
+		case OPERATION_MAX:
+			break;
+	}
+
+	assert(not_reached);
+	return 0;
+}
+
+#ifdef H2OXX_INSTRUMENTATION
+
+namespace
+{
+	typedef std::atomic<uint64_t> counter;
+
+	/**
+	 * The counters of a single thread. They are written only
+	 * by the owning thread, and read by snapshot().
+	 */
+	struct Block
+	{
+		counter calls[OPERATION_MAX][6];
+		counter latency[OPERATION_MAX][latency_buckets];
+		counter solves;
+		counter iterations;
+		counter iteration_histogram[iteration_buckets];
+
+		Block()
+		{
+			clear();
+		}
+
+		void clear()
+		{
+			for (size_t i = 0; i < OPERATION_MAX; ++i)
+			{
+				for (size_t j = 0; j < 6; ++j)
+					calls[i][j].store(0, std::memory_order_relaxed);
+				for (size_t j = 0; j < latency_buckets; ++j)
+					latency[i][j].store(0, std::memory_order_relaxed);
+			}
+			solves.store(0, std::memory_order_relaxed);
+			iterations.store(0, std::memory_order_relaxed);
+			for (size_t j = 0; j < iteration_buckets; ++j)
+				iteration_histogram[j].store(0, std::memory_order_relaxed);
+		}
+
+		void merge_into(Snapshot& out) const
+		{
+			for (size_t i = 0; i < OPERATION_MAX; ++i)
+			{
+				Counters& c = out.operations[i];
+
+				for (size_t j = 0; j < 6; ++j)
+					c.calls[j] += calls[i][j].load(std::memory_order_relaxed);
+				for (size_t j = 0; j < latency_buckets; ++j)
+					c.latency[j] += latency[i][j].load(
+							std::memory_order_relaxed);
+			}
+			out.solves += solves.load(std::memory_order_relaxed);
+			out.iterations += iterations.load(std::memory_order_relaxed);
+			for (size_t j = 0; j < iteration_buckets; ++j)
+				out.iteration_histogram[j] += iteration_histogram[j].load(
+						std::memory_order_relaxed);
+		}
+	};
+
+	struct Registry
+	{
+		std::mutex lock;
+		std::vector<Block*> blocks;
+		// the counters of the threads which have exited
+		Snapshot retired;
+
+		Registry()
+		{
+			std::memset(&retired, 0, sizeof(retired));
+		}
+	};
+
+	Registry& registry()
+	{
+		static Registry r;
+
+		return r;
+	}
+
+	/**
+	 * Registers the counters of the current thread, and merges them
+	 * into the retired ones when the thread exits.
+	 *
+	 * The handle is created on the first probe in a thread, possibly
+	 * inside the noexcept H2O::try_*() functions, so it must not
+	 * throw. If the registration fails, the thread's samples are
+	 * dropped.
+	 */
+	struct Handle
+	{
+		Block* block;
+
+		Handle() noexcept
+			: block(new (std::nothrow) Block)
+		{
+			if (!block)
+				return;
+
+			try
+			{
+				Registry& r = registry();
+				std::lock_guard<std::mutex> l(r.lock);
+
+				r.blocks.push_back(block);
+			}
+			catch (...)
+			{
+				delete block;
+				block = 0;
+			}
+		}
+
+		~Handle()
+		{
+			if (!block)
+				return;
+
+			Registry& r = registry();
+			std::lock_guard<std::mutex> l(r.lock);
+
+			block->merge_into(r.retired);
+			r.blocks.erase(std::find(r.blocks.begin(), r.blocks.end(),
+						block));
+			delete block;
+		}
+	};
+
+	thread_local Handle handle;
+
+	// the owning thread is the only writer, so no atomic RMW is needed
+	inline void bump(counter& c, uint64_t n = 1)
+	{
+		c.store(c.load(std::memory_order_relaxed) + n,
+				std::memory_order_relaxed);
+	}
+}
+
+void instrumentation::record(operation_type op, Region region,
+		uint64_t ns)
+{
+	if (!handle.block)
+		return;
+
+	Block& b = *handle.block;
+	size_t bucket = 0;
+
+	while (ns >>= 1)
+		++bucket;
+
+	bump(b.calls[op][static_cast<Region::enum_type>(region)]);
+	bump(b.latency[op][std::min(bucket, latency_buckets - 1)]);
+}
+
+void instrumentation::record_iterations(int iterations)
+{
+	if (!handle.block)
+		return;
+
+	Block& b = *handle.block;
+	size_t bucket = std::min(static_cast<size_t>(iterations),
+			iteration_buckets - 1);
+
+	bump(b.solves);
+	bump(b.iterations, iterations);
+	bump(b.iteration_histogram[bucket]);
+}
+
+bool instrumentation::enabled()
+{
+	return true;
+}
+
+Snapshot instrumentation::snapshot()
+{
+	Registry& r = registry();
+	std::lock_guard<std::mutex> l(r.lock);
+	Snapshot ret = r.retired;
+
+	for (size_t i = 0; i < r.blocks.size(); ++i)
+		r.blocks[i]->merge_into(ret);
+
+	return ret;
+}
+
+void instrumentation::reset()
+{
+	Registry& r = registry();
+	std::lock_guard<std::mutex> l(r.lock);
+
+	std::memset(&r.retired, 0, sizeof(r.retired));
+	for (size_t i = 0; i < r.blocks.size(); ++i)
+		r.blocks[i]->clear();
+}
+
+#else /*!H2OXX_INSTRUMENTATION*/
+
+bool instrumentation::enabled()
+{
+	return false;
+}
+
+Snapshot instrumentation::snapshot()
+{
+	Snapshot ret;
+
+	std::memset(&ret, 0, sizeof(ret));
+	return ret;
+}
+
+void instrumentation::reset()
+{
+}
+
+#endif /*H2OXX_INSTRUMENTATION*/
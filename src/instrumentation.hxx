@@ -0,0 +1,104 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#pragma once
+
+#ifndef _H2O_INSTRUMENTATION_INTERNAL_HXX
+#define _H2O_INSTRUMENTATION_INTERNAL_HXX 1
+
+#include "h2o"
+#include "h2o_instrumentation"
+
+/**
+ * The instrumentation hooks.
+ *
+ * H2O_PROBE(op) starts timing an operation, and H2O_RECORD(value)
+ * records it -- with the region of @value if it is a H2O, or with
+ * the region passed to H2O_PROBE_AT(op, region) otherwise -- and
+ * evaluates to @value. If the probe goes out of scope without
+ * recording (i.e. an exception was thrown), the call is recorded
+ * as out-of-range.
+ *
+ * H2O_RECORD_ITERATIONS(n) records a backward equation solve.
+ *
+ * Without H2OXX_INSTRUMENTATION, the hooks compile to nothing.
+ */
+
+#ifdef H2OXX_INSTRUMENTATION
+
+#include <chrono>
+
+namespace h2o
+{
+	namespace instrumentation
+	{
+		void record(operation_type op, Region region, uint64_t ns);
+		void record_iterations(int iterations);
+
+		class Probe
+		{
+			typedef std::chrono::steady_clock clock;
+
+			operation_type _op;
+			Region _region;
+			clock::time_point _start;
+			bool _done;
+
+			void finish(Region region)
+			{
+				_done = true;
+				record(_op, region,
+						std::chrono::duration_cast<std::chrono::nanoseconds>(
+							clock::now() - _start).count());
+			}
+
+		public:
+			Probe(operation_type op, Region region = Region::OOR)
+				: _op(op), _region(region), _start(clock::now()),
+				_done(false)
+			{
+			}
+
+			~Probe()
+			{
+				if (!_done)
+					finish(Region::OOR);
+			}
+
+			const H2O& operator()(const H2O& st)
+			{
+				finish(st.region());
+				return st;
+			}
+
+			template <class T>
+			const T& operator()(const T& value)
+			{
+				finish(_region);
+				return value;
+			}
+		};
+	}
+}
+
+#	define H2O_PROBE(op) \
+		h2o::instrumentation::Probe probe_(h2o::instrumentation::op)
+#	define H2O_PROBE_AT(op, region) \
+		h2o::instrumentation::Probe probe_(h2o::instrumentation::op, \
+				region)
+#	define H2O_RECORD(value) probe_(value)
+#	define H2O_RECORD_ITERATIONS(n) \
+		h2o::instrumentation::record_iterations(n)
+
+#else /*!H2OXX_INSTRUMENTATION*/
+
+#	define H2O_PROBE(op) ((void) 0)
+#	define H2O_PROBE_AT(op, region) ((void) 0)
+#	define H2O_RECORD(value) (value)
+#	define H2O_RECORD_ITERATIONS(n) ((void) 0)
+
+#endif /*H2OXX_INSTRUMENTATION*/
+
+#endif /*_H2O_INSTRUMENTATION_INTERNAL_HXX*/
@@ -0,0 +1,315 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+
+#include "h2o_parallel"
+#include "batch.hxx"
+
+using namespace h2o;
+using namespace h2o::parallel;
+
+// the number of state points in a single task; small enough to let
+// the idle threads steal the expensive parts of an input
+static const size_t batch_grain = 64;
+
+struct ThreadPool::Job
+{
+	const std::function<void(size_t, size_t)>* f;
+	std::atomic<size_t> remaining;
+
+	std::mutex lock;
+	std::condition_variable done;
+	std::exception_ptr error;
+};
+
+struct ThreadPool::Task
+{
+	Job* job;
+	size_t begin, end;
+};
+
+struct ThreadPool::Queue
+{
+	std::mutex lock;
+	std::deque<Task> tasks;
+};
+
+struct ThreadPool::Shared
+{
+	size_t queue_count;
+
+	// the number of queued (not yet taken) tasks
+	std::atomic<size_t> pending;
+
+	std::mutex lock;
+	std::condition_variable wake;
+	bool stop;
+};
+
+ThreadPool::ThreadPool(size_t threads)
+	: _shared(new Shared)
+{
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+	if (threads == 0)
+		threads = 1;
+
+	// the calling thread has its own queue too
+	_shared->queue_count = threads;
+	_shared->pending = 0;
+	_shared->stop = false;
+	_queues.reset(new Queue[threads]);
+
+	for (size_t i = 1; i < threads; ++i)
+		_threads.push_back(std::thread(&ThreadPool::work, this, i));
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> l(_shared->lock);
+		_shared->stop = true;
+	}
+	_shared->wake.notify_all();
+
+	for (size_t i = 0; i < _threads.size(); ++i)
+		_threads[i].join();
+}
+
+size_t ThreadPool::size() const
+{
+	return _shared->queue_count;
+}
+
+bool ThreadPool::steal(size_t first, Task& out)
+{
+	size_t n = _shared->queue_count;
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		Queue& q = _queues[(first + i) % n];
+		std::lock_guard<std::mutex> l(q.lock);
+
+		if (q.tasks.empty())
+			continue;
+
+		// own queue from the front, others' from the back
+		if (i == 0)
+		{
+			out = q.tasks.front();
+			q.tasks.pop_front();
+		}
+		else
+		{
+			out = q.tasks.back();
+			q.tasks.pop_back();
+		}
+
+		--_shared->pending;
+		return true;
+	}
+
+	return false;
+}
+
+void ThreadPool::run(const Task& t)
+{
+	Job& j = *t.job;
+
+	try
+	{
+		(*j.f)(t.begin, t.end);
+	}
+	catch (...)
+	{
+		std::lock_guard<std::mutex> l(j.lock);
+
+		if (!j.error)
+			j.error = std::current_exception();
+	}
+
+	// decrement under the lock, so that the waiter can not destroy
+	// the job before we are done with it
+	std::lock_guard<std::mutex> l(j.lock);
+	if (--j.remaining == 0)
+		j.done.notify_all();
+}
+
+void ThreadPool::work(size_t id)
+{
+	for (;;)
+	{
+		Task t;
+
+		if (steal(id, t))
+		{
+			run(t);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> l(_shared->lock);
+		_shared->wake.wait(l, [this] {
+			return _shared->stop || _shared->pending > 0;
+		});
+
+		if (_shared->stop)
+			return;
+	}
+}
+
+void ThreadPool::for_each(size_t n, size_t grain,
+		const std::function<void(size_t, size_t)>& f)
+{
+	assert(grain > 0);
+
+	if (n == 0)
+		return;
+
+	size_t tasks = (n + grain - 1) / grain;
+	size_t queues = _shared->queue_count;
+
+	Job j;
+	j.f = &f;
+	j.remaining = tasks;
+
+	// a single task (or thread) does not need the machinery
+	if (tasks == 1 || queues == 1)
+	{
+		for (size_t i = 0; i < n; i += grain)
+		{
+			Task t = { &j, i, std::min(i + grain, n) };
+			run(t);
+		}
+
+		if (j.error)
+			std::rethrow_exception(j.error);
+		return;
+	}
+
+	// split the tasks evenly into contiguous blocks, one per queue
+	for (size_t q = 0; q < queues; ++q)
+	{
+		size_t first = tasks * q / queues;
+		size_t last = tasks * (q + 1) / queues;
+
+		std::lock_guard<std::mutex> l(_queues[q].lock);
+		for (size_t i = first; i < last; ++i)
+		{
+			Task t = { &j, i * grain, std::min((i + 1) * grain, n) };
+			_queues[q].tasks.push_back(t);
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> l(_shared->lock);
+		_shared->pending += tasks;
+	}
+	_shared->wake.notify_all();
+
+	// help out until there is nothing left to take; this may run tasks
+	// of the other callers' jobs too, which is fine
+	Task t;
+	while (j.remaining > 0 && steal(0, t))
+		run(t);
+
+	{
+		std::unique_lock<std::mutex> l(j.lock);
+		j.done.wait(l, [&j] { return j.remaining == 0; });
+	}
+
+	if (j.error)
+		std::rethrow_exception(j.error);
+}
+
+ThreadPool& parallel::default_pool()
+{
+	static ThreadPool pool;
+
+	return pool;
+}
+
+static size_t construct(batch::constructor_func_t f, const batch::View& a,
+		const batch::View& b, H2OArray& out, unsigned columns,
+		ThreadPool& pool)
+{
+	assert(a.size() == b.size());
+
+	std::atomic<size_t> oor(0);
+
+	out.resize(a.size());
+	pool.for_each(a.size(), batch_grain,
+		[&](size_t begin, size_t end)
+		{
+			oor += batch::construct_range(f, a, b, out, columns,
+					begin, end);
+		});
+
+	return oor;
+}
+
+size_t parallel::pT(batch::View p, batch::View T, H2OArray& out,
+		unsigned columns, ThreadPool& pool)
+{
+	return construct(internals::h2o_new_pT, p, T, out, columns, pool);
+}
+
+size_t parallel::Tx(batch::View T, batch::View x, H2OArray& out,
+		unsigned columns, ThreadPool& pool)
+{
+	return construct(internals::h2o_new_Tx, T, x, out, columns, pool);
+}
+
+size_t parallel::px(batch::View p, batch::View x, H2OArray& out,
+		unsigned columns, ThreadPool& pool)
+{
+	return construct(internals::h2o_new_px, p, x, out, columns, pool);
+}
+
+size_t parallel::ph(batch::View p, batch::View h, H2OArray& out,
+		unsigned columns, ThreadPool& pool)
+{
+	return construct(internals::h2o_new_ph, p, h, out, columns, pool);
+}
+
+size_t parallel::ps(batch::View p, batch::View s, H2OArray& out,
+		unsigned columns, ThreadPool& pool)
+{
+	return construct(internals::h2o_new_ps, p, s, out, columns, pool);
+}
+
+size_t parallel::hs(batch::View h, batch::View s, H2OArray& out,
+		unsigned columns, ThreadPool& pool)
+{
+	return construct(internals::h2o_new_hs, h, s, out, columns, pool);
+}
+
+size_t parallel::rhoT(batch::View rho, batch::View T, H2OArray& out,
+		unsigned columns, ThreadPool& pool)
+{
+	return construct(internals::h2o_new_rhoT, rho, T, out, columns, pool);
+}
+
+void parallel::properties(const std::vector<H2O>& states,
+		std::vector<PropertySet>& out, ThreadPool& pool)
+{
+	out.resize(states.size());
+	pool.for_each(states.size(), batch_grain,
+		[&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+				out[i] = states[i].properties();
+		});
+}
@@ -0,0 +1,442 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include <cassert>
+#include <limits>
+
+#ifdef __SSE__
+#	include <pmmintrin.h>
+#endif
+
+#include "h2o_precision"
+#include "if97_kernels.hxx"
+#include "simd.hxx"
+
+using namespace h2o;
+
+static const bool not_reached = false; // for assert()
+
+// above it, the saturated phases are in region 3
+static const double T_sep = 623.15;
+
+/**
+ * Flush subnormals to zero for the lifetime of the object.
+ *
+ * The high powers in the basic equations (e.g. (tau - 0.5)^58
+ * in region 2) reach the subnormal range of float, where every
+ * operation is many times slower. The terms are negligible there.
+ */
+namespace
+{
+	class FlushToZero
+	{
+#ifdef __SSE__
+		unsigned int _saved;
+
+	public:
+		FlushToZero()
+			: _saved(_mm_getcsr())
+		{
+			_mm_setcsr(_saved | _MM_FLUSH_ZERO_ON | _MM_DENORMALS_ZERO_ON);
+		}
+
+		~FlushToZero()
+		{
+			_mm_setcsr(_saved);
+		}
+#endif
+	};
+}
+
+template <class Real>
+BasicH2O<Real>::BasicH2O()
+	: _region(Region::OOR)
+{
+}
+
+template <class Real>
+BasicH2O<Real>::BasicH2O(const H2O& st)
+	: _region(st.region())
+{
+	const Real nan = std::numeric_limits<Real>::quiet_NaN();
+
+	assert(st.initialized());
+
+	_p = static_cast<Real>(st.p());
+	_T = static_cast<Real>(st.T());
+	_x = _region == Region::R3 ? nan : static_cast<Real>(st.x());
+	_rho = _region == Region::R3 ? static_cast<Real>(st.rho()) : nan;
+	_rho_liq = nan;
+	_rho_vap = nan;
+
+	if (_region == Region::R4 && st.T() > T_sep)
+	{
+		_rho_liq = static_cast<Real>(H2O::Tx(st.T(), 0.).rho());
+		_rho_vap = static_cast<Real>(H2O::Tx(st.T(), 1.).rho());
+	}
+}
+
+template <class Real>
+BasicH2O<Real> BasicH2O<Real>::pT(Real p, Real T)
+{
+	return BasicH2O(H2O::pT(p, T));
+}
+
+template <class Real>
+BasicH2O<Real> BasicH2O<Real>::Tx(Real T, Real x)
+{
+	return BasicH2O(H2O::Tx(T, x));
+}
+
+template <class Real>
+BasicH2O<Real> BasicH2O<Real>::px(Real p, Real x)
+{
+	return BasicH2O(H2O::px(p, x));
+}
+
+template <class Real>
+BasicH2O<Real> BasicH2O<Real>::rhoT(Real rho, Real T)
+{
+	return BasicH2O(H2O::rhoT(rho, T));
+}
+
+template <class Real>
+bool BasicH2O<Real>::initialized() const
+{
+	return _region != Region::OOR;
+}
+
+template <class Real>
+Region BasicH2O<Real>::region() const
+{
+	return _region;
+}
+
+template <class Real>
+BasicPropertySet<Real> BasicH2O<Real>::properties() const
+{
+	namespace kernels = if97::kernels;
+
+	BasicPropertySet<Real> ret;
+	FlushToZero ftz;
+
+	assert(initialized());
+
+	ret.p = _p;
+	ret.T = _T;
+	ret.x = _x;
+
+	switch (_region)
+	{
+		case Region::R1:
+			kernels::region1(_p, _T, ret);
+			break;
+		case Region::R2:
+			kernels::region2(_p, _T, ret);
+			break;
+		case Region::R3:
+			kernels::region3(_rho, _T, ret);
+			ret.p = _p;
+			break;
+		case Region::R4:
+		{
+			BasicPropertySet<Real> liq, vap;
+
+			if (_T <= T_sep)
+			{
+				kernels::region1(_p, _T, liq);
+				kernels::region2(_p, _T, vap);
+			}
+			else
+			{
+				kernels::region3(_rho_liq, _T, liq);
+				kernels::region3(_rho_vap, _T, vap);
+			}
+
+			ret.v = liq.v + _x * (vap.v - liq.v);
+			ret.rho = 1 / ret.v;
+			ret.u = liq.u + _x * (vap.u - liq.u);
+			ret.h = liq.h + _x * (vap.h - liq.h);
+			ret.s = liq.s + _x * (vap.s - liq.s);
+			ret.cp = std::numeric_limits<Real>::quiet_NaN();
+			ret.cv = ret.cp;
+			ret.w = ret.cp;
+			break;
+		}
+		case Region::R5:
+			kernels::region5(_p, _T, ret);
+			break;
+		default:
+			assert(not_reached);
+	}
+
+	return ret;
+}
+
+namespace
+{
+	/**
+	 * The bulk kernel for @Real (see simd.hxx). There are none
+	 * for long double.
+	 */
+	template <class Real>
+	struct Bulk
+	{
+		typedef void (*kernel_func_t)(Region region,
+				simd::BasicBlock<Real>& b);
+
+		static kernel_func_t kernel()
+		{
+			return 0;
+		}
+	};
+
+	template <>
+	Bulk<float>::kernel_func_t Bulk<float>::kernel()
+	{
+		return simd::float_kernel();
+	}
+
+	template <>
+	Bulk<double>::kernel_func_t Bulk<double>::kernel()
+	{
+		return simd::kernel();
+	}
+
+	/**
+	 * The region 1 or 2 state points waiting for the bulk kernel,
+	 * along with their positions in the output.
+	 */
+	template <class Real>
+	struct Pending
+	{
+		Region region;
+		simd::BasicBlock<Real> block;
+		size_t index[simd::BasicBlock<Real>::capacity];
+	};
+}
+
+template <class Real>
+static void flush(typename Bulk<Real>::kernel_func_t kernel,
+		Pending<Real>& q, BasicPropertySet<Real>* out)
+{
+	simd::BasicBlock<Real>& b = q.block;
+
+	if (!b.n)
+		return;
+
+	kernel(q.region, b);
+
+	for (size_t j = 0; j < b.n; ++j)
+	{
+		BasicPropertySet<Real>& ps = out[q.index[j]];
+
+		ps.p = b.p[j];
+		ps.T = b.T[j];
+		ps.x = q.region == Region::R1 ? 0 : 1;
+		ps.rho = b.rho[j];
+
+		ps.v = b.v[j];
+		ps.u = b.u[j];
+		ps.h = b.h[j];
+		ps.s = b.s[j];
+		ps.cp = b.cp[j];
+		ps.cv = b.cv[j];
+		ps.w = b.w[j];
+	}
+
+	b.n = 0;
+}
+
+template <class Real>
+size_t BasicH2O<Real>::pT(const Real* p, const Real* T, size_t n,
+		BasicPropertySet<Real>* out)
+{
+	const Real nan = std::numeric_limits<Real>::quiet_NaN();
+	const BasicPropertySet<Real> oor_set
+		= { nan, nan, nan, nan, nan, nan, nan, nan, nan, nan, nan };
+
+	typename Bulk<Real>::kernel_func_t kernel = Bulk<Real>::kernel();
+	Pending<Real> pending[2];
+	FlushToZero ftz;
+	size_t oor = 0;
+
+	pending[0].region = Region::R1;
+	pending[0].block.n = 0;
+	pending[1].region = Region::R2;
+	pending[1].block.n = 0;
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		H2O st = H2O::try_pT(p[i], T[i]);
+
+		if (!st.initialized())
+		{
+			out[i] = oor_set;
+			++oor;
+		}
+		else if (kernel && (st.region() == Region::R1
+					|| st.region() == Region::R2))
+		{
+			Pending<Real>& q = pending[st.region() == Region::R2];
+			simd::BasicBlock<Real>& blk = q.block;
+
+			q.index[blk.n] = i;
+			blk.p[blk.n] = static_cast<Real>(st.p());
+			blk.T[blk.n] = static_cast<Real>(st.T());
+			if (++blk.n == simd::BasicBlock<Real>::capacity)
+				flush(kernel, q, out);
+		}
+		else
+			out[i] = BasicH2O(st).properties();
+	}
+
+	if (kernel)
+	{
+		flush(kernel, pending[0], out);
+		flush(kernel, pending[1], out);
+	}
+
+	return oor;
+}
+
+template <class Real>
+Real BasicH2O<Real>::p() const
+{
+	assert(initialized());
+
+	return _p;
+}
+
+template <class Real>
+Real BasicH2O<Real>::T() const
+{
+	assert(initialized());
+
+	return _T;
+}
+
+template <class Real>
+Real BasicH2O<Real>::x() const
+{
+	assert(initialized());
+	assert(region() != Region::R3);
+
+	return _x;
+}
+
+template <class Real>
+Real BasicH2O<Real>::rho() const
+{
+	return properties().rho;
+}
+
+template <class Real>
+Real BasicH2O<Real>::v() const
+{
+	return properties().v;
+}
+
+template <class Real>
+Real BasicH2O<Real>::u() const
+{
+	return properties().u;
+}
+
+template <class Real>
+Real BasicH2O<Real>::h() const
+{
+	return properties().h;
+}
+
+template <class Real>
+Real BasicH2O<Real>::s() const
+{
+	return properties().s;
+}
+
+template <class Real>
+Real BasicH2O<Real>::cp() const
+{
+	return properties().cp;
+}
+
+template <class Real>
+Real BasicH2O<Real>::cv() const
+{
+	return properties().cv;
+}
+
+template <class Real>
+Real BasicH2O<Real>::w() const
+{
+	return properties().w;
+}
+
+static const double nan_value = std::numeric_limits<double>::quiet_NaN();
+
+/**
+ * The published accuracies, in the order of R1 through R5. These are
+ * the largest errors found over some 150000 random state points
+ * per region, rounded up with a safety margin of about 3. The errors
+ * of long double are those of the double precision reference itself.
+ */
+namespace
+{
+	template <class Real>
+	struct Published
+	{
+		static const typename BasicH2O<Real>::Accuracy table[];
+	};
+}
+
+template <>
+const BasicH2O<float>::Accuracy Published<float>::table[] =
+{
+	{ 1E-4, 1E-4, 2E-3, 5E-4, 2E-5, 1E-3, 1E-2, 5E-3 },
+	{ 5E-6, 5E-6, 2E-6, 2E-6, 2E-6, 1E-5, 2E-5, 1E-5 },
+	{ 1E-6, 1E-6, 5E-4, 5E-4, 5E-4, 1E-2, 1E-2, 2E-3 },
+	{ 2E-4, 2E-4, 5E-4, 5E-4, 1E-4, nan_value, nan_value, nan_value },
+	{ 2E-6, 2E-6, 2E-6, 2E-6, 2E-6, 2E-6, 2E-6, 2E-6 }
+};
+
+template <>
+const BasicH2O<double>::Accuracy Published<double>::table[] =
+{
+	{ 0, 0, 0, 0, 0, 0, 0, 0 },
+	{ 0, 0, 0, 0, 0, 0, 0, 0 },
+	{ 0, 0, 0, 0, 0, 0, 0, 0 },
+	{ 0, 0, 0, 0, 0, nan_value, nan_value, nan_value },
+	{ 0, 0, 0, 0, 0, 0, 0, 0 }
+};
+
+template <>
+const BasicH2O<long double>::Accuracy Published<long double>::table[] =
+{
+	{ 2E-13, 2E-13, 5E-12, 1E-12, 5E-14, 2E-12, 2E-11, 1E-11 },
+	{ 1E-14, 1E-14, 1E-14, 1E-14, 1E-14, 2E-14, 1E-13, 5E-14 },
+	{ 1E-15, 1E-15, 1E-12, 1E-12, 1E-12, 1E-11, 2E-11, 5E-12 },
+	{ 5E-13, 5E-13, 5E-13, 5E-13, 2E-13, nan_value, nan_value, nan_value },
+	{ 5E-15, 5E-15, 5E-15, 5E-15, 5E-15, 5E-15, 5E-15, 5E-15 }
+};
+
+template <class Real>
+typename BasicH2O<Real>::Accuracy BasicH2O<Real>::accuracy(Region region)
+{
+	assert(region != Region::OOR);
+
+	return Published<Real>::table[region - Region::R1];
+}
+
+namespace h2o
+{
+	template class BasicH2O<float>;
+	template class BasicH2O<double>;
+	template class BasicH2O<long double>;
+}
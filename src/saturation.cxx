@@ -0,0 +1,344 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "h2o_saturation"
+#include "if97.hxx"
+
+using namespace h2o;
+using namespace h2o::saturation;
+
+static const double nan_value = std::numeric_limits<double>::quiet_NaN();
+
+// covered range -- the triple point to the critical point
+static const double T_min = 273.15;
+static const double T_crit = 647.096;
+static const double p_crit = 22.064;
+
+// the region 1/2 and region 3 boundary, where Table is split
+static const double T_sep = 623.15;
+
+// the table grid sizes, in T below T_sep and in sqrt(Tc - T) above it
+static const size_t low_cells = 1400;
+static const size_t high_cells = 200;
+
+// the properties interpolated by Table; v is interpolated as ln v,
+// and cp (which diverges at the critical point) as 1/cp
+static double PropertySet::* const table_fields[] =
+{
+	&PropertySet::v,
+	&PropertySet::u,
+	&PropertySet::h,
+	&PropertySet::s,
+	&PropertySet::cp,
+	&PropertySet::cv,
+	&PropertySet::w
+};
+
+// the magnitude below which the tolerance is absolute
+static const double table_floors[] = { 0., 1., 1., 1., 0., 0., 0. };
+
+#define COUNT(a) (sizeof(a) / sizeof(*(a)))
+
+static inline void out_of_range()
+{
+	throw std::range_error("Requested parameters out-of-range.");
+}
+
+static inline bool within(double value, double expected, double tolerance,
+		double floor)
+{
+	return std::fabs(value - expected)
+		<= tolerance * std::max(std::fabs(expected), floor);
+}
+
+static inline double p_min()
+{
+	static const double p = if97::psat(T_min);
+
+	return p;
+}
+
+static inline double p_sep()
+{
+	static const double p = if97::psat(T_sep);
+
+	return p;
+}
+
+/**
+ * Evaluate both saturated phases at @T (and psat(T) = @p), in region 3
+ * if @region3 is true, or in regions 1 & 2 otherwise.
+ */
+static State evaluate(double p, double T, bool region3)
+{
+	State ret;
+
+	ret.p = p;
+	ret.T = T;
+
+	// see if97::properties() for the saturated states above 623.15 K
+	if (!region3)
+	{
+		if97::region1(p, T, ret.liquid);
+		if97::region2(p, T, ret.vapour);
+		ret.liquid.rho = 1. / ret.liquid.v;
+		ret.vapour.rho = 1. / ret.vapour.v;
+	}
+	else
+	{
+		if97::region3(h2o_get_rho(internals::h2o_new_Tx(T, 0.)), T,
+				ret.liquid);
+		if97::region3(h2o_get_rho(internals::h2o_new_Tx(T, 1.)), T,
+				ret.vapour);
+	}
+
+	// region 3 fills in p from the basic equation; psat is the one
+	// consistent with the remaining state points
+	ret.liquid.p = ret.vapour.p = p;
+	ret.liquid.T = ret.vapour.T = T;
+	ret.liquid.x = 0.;
+	ret.vapour.x = 1.;
+
+	return ret;
+}
+
+/**
+ * Get the weights of the four-point Lagrange polynomial through
+ * the nodes 0, 1, 2, 3 at @t.
+ */
+static inline void lagrange_weights(double t, double* w)
+{
+	double t0 = t, t1 = t - 1., t2 = t - 2., t3 = t - 3.;
+
+	w[0] = -t1 * t2 * t3 / 6.;
+	w[1] = t0 * t2 * t3 / 2.;
+	w[2] = -t0 * t1 * t3 / 2.;
+	w[3] = t0 * t1 * t2 / 6.;
+}
+
+static inline double to_field(size_t i, double value)
+{
+	switch (i)
+	{
+		case 0:
+			return std::log(value);
+		case 4:
+			return 1. / value;
+		default:
+			return value;
+	}
+}
+
+static inline double from_field(size_t i, double value)
+{
+	switch (i)
+	{
+		case 0:
+			return std::exp(value);
+		case 4:
+			return 1. / value;
+		default:
+			return value;
+	}
+}
+
+static void interpolate_phase(const std::vector<PropertySet>& nodes,
+		size_t first, const double* w, PropertySet& out)
+{
+	for (size_t i = 0; i < COUNT(table_fields); ++i)
+	{
+		double value = 0.;
+
+		for (size_t k = 0; k < 4; ++k)
+			value += w[k] * to_field(i, nodes[first + k].*table_fields[i]);
+
+		out.*table_fields[i] = from_field(i, value);
+	}
+
+	out.rho = 1. / out.v;
+}
+
+PropertySet State::mixture(double x) const
+{
+	PropertySet ret;
+
+	ret.p = p;
+	ret.T = T;
+	ret.x = x;
+	ret.v = liquid.v + x * (vapour.v - liquid.v);
+	ret.rho = 1. / ret.v;
+	ret.u = liquid.u + x * (vapour.u - liquid.u);
+	ret.h = liquid.h + x * (vapour.h - liquid.h);
+	ret.s = liquid.s + x * (vapour.s - liquid.s);
+	ret.cp = ret.cv = ret.w = nan_value;
+
+	return ret;
+}
+
+State saturation::T(double T)
+{
+	if (!(T >= T_min && T <= T_crit))
+		out_of_range();
+
+	return evaluate(if97::psat(T), T, T > T_sep);
+}
+
+State saturation::p(double p)
+{
+	if (!(p >= p_min() && p <= p_crit))
+		out_of_range();
+
+	// Tsat(p) may not exactly round-trip psat(T_sep), so decide
+	// on the region using p
+	return evaluate(p, std::min(if97::Tsat(p), T_crit), p > p_sep());
+}
+
+static inline double T_of(double x, bool critical)
+{
+	return critical ? T_crit - x * x : x;
+}
+
+void Table::build_segment(Segment& seg, double x_min, double x_max,
+		size_t cells, bool critical)
+{
+	seg.x0 = x_min;
+	seg.dx = (x_max - x_min) / cells;
+	seg.critical = critical;
+
+	seg.liquid.resize(cells + 1);
+	seg.vapour.resize(cells + 1);
+	for (size_t i = 0; i <= cells; ++i)
+	{
+		double x = i == cells ? x_max : x_min + i * seg.dx;
+		double T = T_of(x, critical);
+		State st = evaluate(if97::psat(T), T, critical);
+
+		seg.liquid[i] = st.liquid;
+		seg.vapour[i] = st.vapour;
+	}
+
+	// verify the interpolation at cell midpoints
+	seg.fallback.assign(cells, false);
+	for (size_t i = 0; i < cells; ++i)
+	{
+		double T = T_of(x_min + (i + 0.5) * seg.dx, critical);
+		State ref = evaluate(if97::psat(T), T, critical);
+		State got;
+
+		bool ok = interpolate(T, critical, got);
+		assert(ok);
+		(void) ok;
+
+		for (size_t j = 0; j < COUNT(table_fields); ++j)
+		{
+			double floor = table_floors[j];
+
+			if (!within(got.liquid.*table_fields[j],
+						ref.liquid.*table_fields[j], _tolerance, floor)
+					|| !within(got.vapour.*table_fields[j],
+						ref.vapour.*table_fields[j], _tolerance, floor))
+			{
+				seg.fallback[i] = true;
+				++_fallback_cells;
+				break;
+			}
+		}
+	}
+
+	_cells += cells;
+}
+
+Table::Table(double tolerance)
+	: _tolerance(tolerance), _fallback_cells(0), _cells(0)
+{
+	build_segment(_low, T_min, T_sep, low_cells, false);
+	build_segment(_high, 0., std::sqrt(T_crit - T_sep), high_cells, true);
+}
+
+bool Table::interpolate(double T, bool region3, State& out) const
+{
+	const Segment& seg = region3 ? _high : _low;
+	double x = seg.critical ? std::sqrt(T_crit - T) : T;
+	size_t cells = seg.liquid.size() - 1;
+	double t = (x - seg.x0) / seg.dx;
+	size_t i = std::min(static_cast<size_t>(std::max(t, 0.)), cells - 1);
+
+	if (seg.fallback[i])
+		return false;
+
+	// centered stencil, shifted inwards at both ends
+	size_t first = i == 0 ? 0 : std::min(i - 1, cells - 3);
+	double w[4];
+
+	lagrange_weights(t - first, w);
+	interpolate_phase(seg.liquid, first, w, out.liquid);
+	interpolate_phase(seg.vapour, first, w, out.vapour);
+
+	out.liquid.T = out.vapour.T = T;
+	out.liquid.x = 0.;
+	out.vapour.x = 1.;
+	return true;
+}
+
+State Table::T(double T) const
+{
+	if (!(T >= T_min && T <= T_crit))
+		out_of_range();
+
+	double p = if97::psat(T);
+	bool region3 = T > T_sep;
+	State ret;
+
+	if (!interpolate(T, region3, ret))
+		return evaluate(p, T, region3);
+
+	ret.p = ret.liquid.p = ret.vapour.p = p;
+	ret.T = T;
+	return ret;
+}
+
+State Table::p(double p) const
+{
+	if (!(p >= p_min() && p <= p_crit))
+		out_of_range();
+
+	double T = std::min(if97::Tsat(p), T_crit);
+	bool region3 = p > p_sep();
+	State ret;
+
+	if (!interpolate(T, region3, ret))
+		return evaluate(p, T, region3);
+
+	ret.p = ret.liquid.p = ret.vapour.p = p;
+	ret.T = T;
+	return ret;
+}
+
+double Table::tolerance() const
+{
+	return _tolerance;
+}
+
+double Table::fallback_ratio() const
+{
+	return static_cast<double>(_fallback_cells) / _cells;
+}
+
+const Table& saturation::table()
+{
+	static const Table table;
+
+	return table;
+}
@@ -0,0 +1,985 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef HAVE_MMAP
+#	include <sys/mman.h>
+#endif
+
+#include "h2o_sbtl"
+#include "if97.hxx"
+
+using namespace h2o;
+using namespace h2o::sbtl;
+
+static const double nan_value = std::numeric_limits<double>::quiet_NaN();
+
+// covered range
+static const double p_min = 0.001;
+static const double p_max = 100.;
+static const double T_min = 273.15;
+static const double T_max = 1073.15;
+
+// near-critical band, always evaluated using libh2o
+static const double p_crit_lo = 21.;
+static const double p_crit_hi = 23.;
+
+// the verification lattice: points per cell edge, and the fraction
+// of the tolerance they have to be within, as a margin for the error
+// between the points
+static const size_t verify_steps = 4;
+static const double verify_margin = 0.75;
+
+// grid sizes (ln p x xi)
+static const size_t sub_np = 241;
+static const size_t liquid_nx = 65;
+static const size_t vapour_nx = 97;
+static const size_t super_np = 81;
+static const size_t super_nx = 257;
+
+// the patch grids: p range, sizes
+struct Grid
+{
+	double pmin, pmax;
+	size_t np, nx;
+};
+
+static const Grid liquid_grid = { p_min, p_crit_lo, sub_np, liquid_nx };
+static const Grid vapour_grid = { p_min, p_crit_lo, sub_np, vapour_nx };
+static const Grid super_grid = { p_crit_hi, p_max, super_np, super_nx };
+
+/**
+ * The table file header. It is followed by the table data
+ * at file_data_offset, in the layout defined by Table::layout().
+ *
+ * The checksum is 64-bit FNV-1a over 64-bit words, covering the header
+ * fields following it and the data.
+ */
+struct FileHeader
+{
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t byte_order;
+	std::uint64_t checksum;
+
+	std::uint32_t kind;
+	std::uint32_t reserved;
+	double tolerance;
+	std::uint64_t fallback_cells;
+	std::uint64_t cells;
+	std::uint64_t grid[5];
+	std::uint64_t data_size;
+};
+
+static const char file_magic[8] = { 'H', '2', 'O', 'S', 'B', 'T', 'L', 0 };
+static const std::uint32_t file_version = 2;
+static const std::uint32_t file_byte_order = 0x01020304;
+static const size_t file_data_offset = 128;
+
+static_assert(sizeof(FileHeader) <= file_data_offset,
+		"FileHeader does not fit before the data");
+
+// patch boundaries
+enum bound_type
+{
+	BOUND_T_MIN,
+	BOUND_SAT_LIQUID,
+	BOUND_SAT_VAPOUR,
+	BOUND_T_MAX
+};
+
+static inline void out_of_range()
+{
+	throw std::range_error("Requested parameters out-of-range.");
+}
+
+static void file_error(const char* path, const char* what)
+{
+	throw std::runtime_error(std::string(path) + ": " + what);
+}
+
+static std::uint64_t checksum(const FileHeader& header, const char* data,
+		size_t size)
+{
+	const char* begin = reinterpret_cast<const char*>(&header.kind);
+	const char* end = reinterpret_cast<const char*>(&header + 1);
+	std::uint64_t ret = 14695981039346656037ULL;
+
+	for (int k = 0; k < 2; ++k)
+	{
+		for (const char* c = begin; c < end; c += sizeof(std::uint64_t))
+		{
+			std::uint64_t word;
+
+			std::memcpy(&word, c, sizeof(word));
+			ret = (ret ^ word) * 1099511628211ULL;
+		}
+
+		begin = data;
+		end = data + size;
+	}
+
+	return ret;
+}
+
+static void fill_header(FileHeader& header)
+{
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, file_magic, sizeof(header.magic));
+	header.version = file_version;
+	header.byte_order = file_byte_order;
+	header.grid[0] = sub_np;
+	header.grid[1] = liquid_nx;
+	header.grid[2] = vapour_nx;
+	header.grid[3] = super_np;
+	header.grid[4] = super_nx;
+}
+
+/**
+ * Take n elements of type T from the table data at @base + @offset,
+ * or just count them if @base is null.
+ */
+template <class T>
+static T* take(char* base, size_t& offset, size_t n)
+{
+	T* ret = base ? reinterpret_cast<T*>(base + offset) : 0;
+
+	offset += n * sizeof(T);
+	return ret;
+}
+
+static inline void cubic_weights(double t, double* w)
+{
+	double t2 = t * t;
+	double t3 = t2 * t;
+
+	w[0] = (-t3 + 2. * t2 - t) / 2.;
+	w[1] = (3. * t3 - 5. * t2 + 2.) / 2.;
+	w[2] = (-3. * t3 + 4. * t2 + t) / 2.;
+	w[3] = (t3 - t2) / 2.;
+}
+
+static inline bool within(double value, double expected, double tolerance,
+		double floor)
+{
+	return std::fabs(value - expected)
+		<= tolerance * std::max(std::fabs(expected), floor);
+}
+
+static PropertySet exact(Table::kind_type kind, double p, double y)
+{
+	if (kind == Table::PH)
+		return H2O::ph(p, y).properties();
+	else
+		return H2O::ps(p, y).properties();
+}
+
+static PropertySet bound_state(bound_type bound, double p)
+{
+	PropertySet ret;
+
+	switch (bound)
+	{
+		case BOUND_T_MIN:
+			ret.p = p;
+			ret.T = T_min;
+			if97::region1(p, T_min, ret);
+			break;
+		case BOUND_SAT_LIQUID:
+			ret = H2O::px(p, 0.).properties();
+			break;
+		case BOUND_SAT_VAPOUR:
+			ret = H2O::px(p, 1.).properties();
+			break;
+		case BOUND_T_MAX:
+			ret.p = p;
+			ret.T = T_max;
+			if97::region2(p, T_max, ret);
+			break;
+	}
+
+	return ret;
+}
+
+/**
+ * Find the state point at a node by bisection over pT, between the two
+ * bounding states. Used where libh2o rejects (p,h) or (p,s) itself,
+ * i.e. when the backward equations put the point just outside
+ * the region.
+ */
+static PropertySet solve_node(Table::kind_type kind, double p, double y,
+		const PropertySet& lo, const PropertySet& hi)
+{
+	double T_lo = lo.T;
+	double T_hi = hi.T;
+	PropertySet ret;
+
+	for (int i = 0; i < 64; ++i)
+	{
+		double T = (T_lo + T_hi) / 2.;
+
+		ret = H2O::pT(p, T).properties();
+		if ((kind == Table::PH ? ret.h : ret.s) < y)
+			T_lo = T;
+		else
+			T_hi = T;
+	}
+
+	return ret;
+}
+
+// get the independent (y) and dependent (z) variable
+static inline double y_of(Table::kind_type kind, const PropertySet& ps)
+{
+	return kind == Table::PH ? ps.h : ps.s;
+}
+
+static inline double z_of(Table::kind_type kind, const PropertySet& ps)
+{
+	return kind == Table::PH ? ps.s : ps.h;
+}
+
+/**
+ * Get the equation libh2o evaluates a node @st at pressure @p with:
+ * the region, and the subregion of the backward equations. The splines
+ * are smooth, so they can not follow the jumps and kinks where
+ * the equation changes. @liquid is true for the nodes below
+ * the saturated vapour line (where the region 1 states are).
+ */
+static if97::backward_type equation_of(Table::kind_type kind, double p,
+		const PropertySet& st, bool liquid)
+{
+	Region region;
+
+	if (st.T <= 623.15)
+		region = liquid ? Region::R1 : Region::R2;
+	else
+		region = p > if97::pB23(st.T) ? Region::R3 : Region::R2;
+
+	if (kind == Table::PH)
+		return if97::backward_ph(region, p, st.h);
+	else
+		return if97::backward_ps(region, p, st.s);
+}
+
+// fill in the ghost nodes of a 1D column using quadratic extrapolation
+static void extrapolate(double* values, size_t first, size_t n,
+		size_t stride)
+{
+	double* v = values + first;
+
+	v[0] = 3. * v[stride] - 3. * v[2 * stride] + v[3 * stride];
+	v[(n + 1) * stride] = 3. * v[n * stride] - 3. * v[(n - 1) * stride]
+		+ v[(n - 2) * stride];
+}
+
+double Table::Curve::operator()(size_t i, double t) const
+{
+	double w[4];
+
+	cubic_weights(t, w);
+
+	return w[0] * values[i] + w[1] * values[i + 1]
+		+ w[2] * values[i + 2] + w[3] * values[i + 3];
+}
+
+/**
+ * Set up the patch grids and point all the splines at the table data
+ * starting at @base (which must be 8-byte aligned). If @base is null,
+ * only compute the size. Returns the data size, in bytes.
+ *
+ * The data consists of the spline nodes (doubles) of the liquid, vapour
+ * and supercritical patches (y_lo, y_hi, T, ln v, z each), the saturation
+ * curves (T_sat, ln v_liq, ln v_vap, z_liq, z_vap), and then the fallback
+ * flags (bytes) of the three patches and the saturation curves.
+ */
+size_t Table::layout(char* base)
+{
+	Patch* patches[] = { &_liquid, &_vapour, &_super };
+	const Grid* grids[] = { &liquid_grid, &vapour_grid, &super_grid };
+	Curve* curves[] = { &_T_sat, &_lnv_liq, &_lnv_vap, &_z_liq, &_z_vap };
+	size_t offset = 0;
+
+	for (int k = 0; k < 3; ++k)
+	{
+		Patch& patch = *patches[k];
+		const Grid& grid = *grids[k];
+		size_t nodes = (grid.np + 2) * (grid.nx + 2);
+
+		patch.lnp0 = std::log(grid.pmin);
+		patch.dlnp = (std::log(grid.pmax) - patch.lnp0) / (grid.np - 1);
+		patch.np = grid.np;
+		patch.nx = grid.nx;
+
+		patch.y_lo.values = take<double>(base, offset, grid.np + 2);
+		patch.y_hi.values = take<double>(base, offset, grid.np + 2);
+		patch.T = take<double>(base, offset, nodes);
+		patch.lnv = take<double>(base, offset, nodes);
+		patch.z = take<double>(base, offset, nodes);
+	}
+
+	// saturation curves, sharing the grid of the subcritical patches
+	for (int k = 0; k < 5; ++k)
+		curves[k]->values = take<double>(base, offset, sub_np + 2);
+
+	for (int k = 0; k < 3; ++k)
+		patches[k]->fallback = take<unsigned char>(base, offset,
+				(patches[k]->np - 1) * (patches[k]->nx - 1));
+	_sat_fallback = take<unsigned char>(base, offset, sub_np - 1);
+
+	// pad to whole words for the checksum
+	return (offset + 7) & ~static_cast<size_t>(7);
+}
+
+void Table::build_patch(Patch& patch, double pmin, double pmax,
+		int lo, int hi)
+{
+	const size_t np = patch.np, nx = patch.nx;
+	const size_t stride = nx + 2;
+	std::vector<if97::backward_type> equations(np * nx);
+
+	for (size_t i = 0; i < np; ++i)
+	{
+		// avoid rounding the end points out of range
+		double p = i == 0 ? pmin : i == np - 1 ? pmax
+			: std::exp(patch.lnp0 + i * patch.dlnp);
+		PropertySet lo_st = bound_state(static_cast<bound_type>(lo), p);
+		PropertySet hi_st = bound_state(static_cast<bound_type>(hi), p);
+		double y_lo = y_of(_kind, lo_st);
+		double y_hi = y_of(_kind, hi_st);
+
+		patch.y_lo.values[i + 1] = y_lo;
+		patch.y_hi.values[i + 1] = y_hi;
+
+		for (size_t j = 0; j < nx; ++j)
+		{
+			size_t k = (i + 1) * stride + j + 1;
+			PropertySet st;
+
+			double y = y_lo + (y_hi - y_lo) * j / (nx - 1);
+
+			// use libh2o wherever it accepts the point, so that
+			// the table follows its backward equations
+			try
+			{
+				st = exact(_kind, p, y);
+			}
+			catch (std::range_error& e)
+			{
+				if (j == 0)
+					st = lo_st;
+				else if (j == nx - 1)
+					st = hi_st;
+				else
+				{
+					// keep the spline continuous, but leave the cells
+					// around the node to libh2o
+					st = solve_node(_kind, p, y, lo_st, hi_st);
+					for (size_t a = i ? i - 1 : 0; a <= i && a < np - 1; ++a)
+						for (size_t b = j - 1; b <= j && b < nx - 1; ++b)
+							patch.fallback[a * (nx - 1) + b] = true;
+				}
+			}
+
+			patch.T[k] = st.T;
+			patch.lnv[k] = std::log(st.v);
+			patch.z[k] = z_of(_kind, st);
+			equations[i * nx + j] = equation_of(_kind, p, st,
+					lo == BOUND_T_MIN);
+		}
+
+		extrapolate(patch.T, (i + 1) * stride, nx, 1);
+		extrapolate(patch.lnv, (i + 1) * stride, nx, 1);
+		extrapolate(patch.z, (i + 1) * stride, nx, 1);
+	}
+
+	// fall back in the cells whose 4x4 nodes are not all evaluated
+	// using the same equation
+	for (size_t i = 0; i < np - 1; ++i)
+	{
+		for (size_t j = 0; j < nx - 1; ++j)
+		{
+			size_t a1 = std::min(i + 2, np - 1);
+			size_t b1 = std::min(j + 2, nx - 1);
+			if97::backward_type eq = equations[i * nx + j];
+
+			for (size_t a = i ? i - 1 : 0; a <= a1; ++a)
+				for (size_t b = j ? j - 1 : 0; b <= b1; ++b)
+					if (equations[a * nx + b] != eq)
+						patch.fallback[i * (nx - 1) + j] = true;
+		}
+	}
+
+	extrapolate(patch.y_lo.values, 0, np, 1);
+	extrapolate(patch.y_hi.values, 0, np, 1);
+	for (size_t j = 0; j < stride; ++j)
+	{
+		extrapolate(patch.T, j, np, stride);
+		extrapolate(patch.lnv, j, np, stride);
+		extrapolate(patch.z, j, np, stride);
+	}
+}
+
+bool Table::interpolate(const Patch& patch, double p, double y,
+		PropertySet& out, bool fallback) const
+{
+	double u = (std::log(p) - patch.lnp0) / patch.dlnp;
+	size_t i = std::min(static_cast<size_t>(std::max(u, 0.)),
+			patch.np - 2);
+	double t = u - i;
+
+	double y_lo = patch.y_lo(i, t);
+	double y_hi = patch.y_hi(i, t);
+	double xi = (y - y_lo) / (y_hi - y_lo);
+
+	// allow for the rounding errors at the patch boundaries
+	if (xi < -1E-9 || xi > 1. + 1E-9)
+		out_of_range();
+	xi = std::min(std::max(xi, 0.), 1.);
+
+	double s = xi * (patch.nx - 1);
+	size_t j = std::min(static_cast<size_t>(s), patch.nx - 2);
+	double tx = s - j;
+
+	if (fallback && patch.fallback[i * (patch.nx - 1) + j])
+		return false;
+
+	double wp[4], wx[4];
+	size_t stride = patch.nx + 2;
+
+	cubic_weights(t, wp);
+	cubic_weights(tx, wx);
+
+	double lnv = 0., z = 0.;
+
+	out.T = 0.;
+
+	for (int a = 0; a < 4; ++a)
+	{
+		size_t k = (i + a) * stride + j;
+		double rT = 0., rv = 0., rz = 0.;
+
+		for (int b = 0; b < 4; ++b)
+		{
+			rT += wx[b] * patch.T[k + b];
+			rv += wx[b] * patch.lnv[k + b];
+			rz += wx[b] * patch.z[k + b];
+		}
+
+		out.T += wp[a] * rT;
+		lnv += wp[a] * rv;
+		z += wp[a] * rz;
+	}
+
+	out.v = std::exp(lnv);
+
+	if (_kind == PH)
+	{
+		out.h = y;
+		out.s = z;
+	}
+	else
+	{
+		out.h = z;
+		out.s = y;
+	}
+
+	return true;
+}
+
+bool Table::interpolate_sat(double p, double y, PropertySet& out,
+		bool fallback) const
+{
+	double u = (std::log(p) - _liquid.lnp0) / _liquid.dlnp;
+	size_t i = std::min(static_cast<size_t>(std::max(u, 0.)),
+			_liquid.np - 2);
+	double t = u - i;
+
+	if (fallback && _sat_fallback[i])
+		return false;
+
+	double y_liq = _liquid.y_hi(i, t);
+	double y_vap = _vapour.y_lo(i, t);
+	double z_liq = _z_liq(i, t);
+	double z_vap = _z_vap(i, t);
+	double v_liq = std::exp(_lnv_liq(i, t));
+	double v_vap = std::exp(_lnv_vap(i, t));
+
+	out.x = (y - y_liq) / (y_vap - y_liq);
+	out.T = _T_sat(i, t);
+	out.v = v_liq + out.x * (v_vap - v_liq);
+
+	double z = z_liq + out.x * (z_vap - z_liq);
+
+	if (_kind == PH)
+	{
+		out.h = y;
+		out.s = z;
+	}
+	else
+	{
+		out.h = z;
+		out.s = y;
+	}
+
+	return true;
+}
+
+bool Table::evaluate(double p, double y, PropertySet& out,
+		bool fallback) const
+{
+	bool ok;
+	int phase = 1; // -1 - liquid, 0 - two-phase, 1 - vapour/supercritical
+
+	if (!(p >= p_min && p <= p_max))
+		out_of_range();
+
+	if (p > p_crit_lo && p < p_crit_hi)
+		ok = false;
+	else if (p <= p_crit_lo)
+	{
+		double u = (std::log(p) - _liquid.lnp0) / _liquid.dlnp;
+		size_t i = std::min(static_cast<size_t>(std::max(u, 0.)),
+				_liquid.np - 2);
+		double t = u - i;
+
+		if (y < _liquid.y_hi(i, t))
+		{
+			phase = -1;
+			ok = interpolate(_liquid, p, y, out, true);
+		}
+		else if (y > _vapour.y_lo(i, t))
+		{
+			phase = 1;
+			ok = interpolate(_vapour, p, y, out, true);
+		}
+		else
+		{
+			phase = 0;
+			ok = interpolate_sat(p, y, out, true);
+		}
+	}
+	else
+	{
+		phase = 1;
+		ok = interpolate(_super, p, y, out, true);
+	}
+
+	if (!ok)
+	{
+		if (!fallback)
+			return false;
+
+		out = exact(_kind, p, y);
+	}
+	else
+	{
+		out.p = p;
+		if (phase == 0)
+			;
+		else if (out.T <= 623.15)
+			out.x = phase < 0 || p >= p_crit_hi ? 0. : 1.;
+		else if (p > if97::pB23(out.T))
+			out.x = nan_value;
+		else
+			out.x = 1.;
+
+		out.rho = 1. / out.v;
+		out.u = out.h - p * out.v * 1000.;
+	}
+
+	out.cp = out.cv = out.w = nan_value;
+	return true;
+}
+
+/**
+ * Check whether the interpolated state @got is within @tolerance
+ * of the reference state @ref.
+ */
+static bool accurate(Table::kind_type kind, const PropertySet& got,
+		const PropertySet& ref, double tolerance)
+{
+	return within(got.T, ref.T, tolerance, 0.)
+		&& within(got.v, ref.v, tolerance, 0.)
+		&& within(z_of(kind, got), z_of(kind, ref), tolerance, 1.);
+}
+
+void Table::verify(Patch& patch)
+{
+	const size_t cells_p = patch.np - 1, cells_x = patch.nx - 1;
+	const size_t n_p = verify_steps * cells_p, n_x = verify_steps * cells_x;
+
+	// check the whole lattice, and mark the cells adjacent to every
+	// point which exceeds the tolerance (the splines are continuous
+	// across the cell edges)
+	for (size_t a = 0; a <= n_p; ++a)
+	{
+		double t = static_cast<double>(a) / verify_steps;
+		double p = std::exp(patch.lnp0 + t * patch.dlnp);
+		size_t ii = std::min(static_cast<size_t>(t), patch.np - 2);
+		double y_lo = patch.y_lo(ii, t - ii);
+		double y_hi = patch.y_hi(ii, t - ii);
+
+		if (p > p_crit_lo && p < p_crit_hi)
+			continue;
+
+		for (size_t b = 0; b <= n_x; ++b)
+		{
+			double y = y_lo + (y_hi - y_lo) * b / n_x;
+			PropertySet ref, got;
+
+			try
+			{
+				ref = exact(_kind, p, y);
+			}
+			catch (std::range_error& e)
+			{
+				continue;
+			}
+
+			interpolate(patch, p, y, got, false);
+			if (accurate(_kind, got, ref, _tolerance * verify_margin))
+				continue;
+
+			size_t i0 = a ? (a - 1) / verify_steps : 0;
+			size_t i1 = std::min(a / verify_steps, cells_p - 1);
+			size_t j0 = b ? (b - 1) / verify_steps : 0;
+			size_t j1 = std::min(b / verify_steps, cells_x - 1);
+
+			for (size_t i = i0; i <= i1; ++i)
+				for (size_t j = j0; j <= j1; ++j)
+					patch.fallback[i * cells_x + j] = true;
+		}
+	}
+
+	for (size_t k = 0; k < cells_p * cells_x; ++k)
+	{
+		if (patch.fallback[k])
+			++_fallback_cells;
+		++_cells;
+	}
+}
+
+void Table::verify_sat()
+{
+	// the interpolation error is linear in x, so it is largest
+	// at the saturation lines
+	static const double xs[] = { 0.001, 0.999 };
+
+	for (size_t i = 0; i < _liquid.np - 1; ++i)
+	{
+		for (size_t a = 0; a <= verify_steps; ++a)
+		{
+			double t = static_cast<double>(a) / verify_steps;
+			double p = std::exp(_liquid.lnp0 + (i + t) * _liquid.dlnp);
+			double y_liq = _liquid.y_hi(i, t);
+			double y_vap = _vapour.y_lo(i, t);
+
+			for (size_t k = 0; k < sizeof(xs) / sizeof(*xs); ++k)
+			{
+				double y = y_liq + xs[k] * (y_vap - y_liq);
+				PropertySet ref, got;
+
+				try
+				{
+					ref = exact(_kind, p, y);
+				}
+				catch (std::range_error& e)
+				{
+					continue;
+				}
+
+				interpolate_sat(p, y, got, false);
+				if (!accurate(_kind, got, ref,
+							_tolerance * verify_margin))
+					_sat_fallback[i] = true;
+			}
+		}
+
+		if (_sat_fallback[i])
+			++_fallback_cells;
+		++_cells;
+	}
+}
+
+struct Table::Storage
+{
+	const char* data;
+	size_t size;
+
+	// a newly built or read table
+	std::vector<double> memory;
+
+	// a mapped table
+	void* map;
+	size_t map_size;
+
+	Storage()
+		: data(0), size(0), map(0), map_size(0)
+	{
+	}
+
+	~Storage()
+	{
+#ifdef HAVE_MMAP
+		if (map)
+			munmap(map, map_size);
+#endif
+	}
+};
+
+Table::Table()
+	: _kind(PH), _tolerance(0.), _fallback_cells(0), _cells(0)
+{
+}
+
+Table::Table(kind_type kind, double tolerance)
+	: _kind(kind), _tolerance(tolerance),
+	_fallback_cells(0), _cells(0),
+	_storage(std::make_shared<Storage>())
+{
+	Storage& st = *_storage;
+
+	st.size = layout(0);
+	st.memory.assign(st.size / sizeof(double), 0.);
+	st.data = reinterpret_cast<const char*>(&st.memory[0]);
+	layout(reinterpret_cast<char*>(&st.memory[0]));
+
+	build_patch(_liquid, p_min, p_crit_lo, BOUND_T_MIN, BOUND_SAT_LIQUID);
+	build_patch(_vapour, p_min, p_crit_lo, BOUND_SAT_VAPOUR, BOUND_T_MAX);
+	build_patch(_super, p_crit_hi, p_max, BOUND_T_MIN, BOUND_T_MAX);
+
+	for (size_t i = 0; i < sub_np; ++i)
+	{
+		double p = i == 0 ? p_min : i == sub_np - 1 ? p_crit_lo
+			: std::exp(_liquid.lnp0 + i * _liquid.dlnp);
+		PropertySet liq = bound_state(BOUND_SAT_LIQUID, p);
+		PropertySet vap = bound_state(BOUND_SAT_VAPOUR, p);
+
+		_T_sat.values[i + 1] = liq.T;
+		_lnv_liq.values[i + 1] = std::log(liq.v);
+		_z_liq.values[i + 1] = z_of(_kind, liq);
+		_lnv_vap.values[i + 1] = std::log(vap.v);
+		_z_vap.values[i + 1] = z_of(_kind, vap);
+	}
+
+	extrapolate(_T_sat.values, 0, sub_np, 1);
+	extrapolate(_lnv_liq.values, 0, sub_np, 1);
+	extrapolate(_lnv_vap.values, 0, sub_np, 1);
+	extrapolate(_z_liq.values, 0, sub_np, 1);
+	extrapolate(_z_vap.values, 0, sub_np, 1);
+
+	verify(_liquid);
+	verify(_vapour);
+	verify(_super);
+	verify_sat();
+}
+
+PropertySet Table::operator()(double p, double y) const
+{
+	PropertySet ret;
+
+	evaluate(p, y, ret, true);
+	return ret;
+}
+
+H2O Table::state(double p, double y) const
+{
+	PropertySet ps = (*this)(p, y);
+
+	// x is NaN in region 3, 0 or 1 for single-phase states
+	// and anything in between in the two-phase region
+	if (ps.x != ps.x)
+		return H2O::rhoT(ps.rho, ps.T);
+	else if (ps.x > 0. && ps.x < 1.)
+		return H2O::px(p, ps.x);
+
+	// the backward equations can put a state just on the other side
+	// of the saturation line than its region (within their error),
+	// and then it can not be constructed from (p,T); let libh2o
+	// resolve it
+	if (p < 22.064 && (ps.x == 0.) == (ps.T >= if97::Tsat(p)))
+		return _kind == PH ? H2O::ph(p, y) : H2O::ps(p, y);
+
+	return H2O::pT(p, ps.T);
+}
+
+Table Table::load(const char* path)
+{
+	std::shared_ptr<Storage> st = std::make_shared<Storage>();
+	FileHeader header;
+	char* base;
+	size_t size;
+
+	int fd = open(path, O_RDONLY);
+	if (fd == -1)
+		file_error(path, std::strerror(errno));
+
+	struct stat stbuf;
+	if (fstat(fd, &stbuf) == -1)
+	{
+		int err = errno;
+		close(fd);
+		file_error(path, std::strerror(err));
+	}
+	size = stbuf.st_size;
+	if (size < file_data_offset)
+	{
+		close(fd);
+		file_error(path, "truncated table file");
+	}
+
+#ifdef HAVE_MMAP
+	st->map = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+	if (st->map == MAP_FAILED)
+	{
+		int err = errno;
+		st->map = 0;
+		close(fd);
+		file_error(path, std::strerror(err));
+	}
+	st->map_size = size;
+	base = static_cast<char*>(st->map);
+#else
+	st->memory.resize((size + sizeof(double) - 1) / sizeof(double));
+	base = reinterpret_cast<char*>(&st->memory[0]);
+	for (size_t done = 0; done < size; )
+	{
+		ssize_t ret = read(fd, base + done, size - done);
+
+		if (ret <= 0)
+		{
+			int err = ret ? errno : EIO;
+			close(fd);
+			file_error(path, std::strerror(err));
+		}
+		done += ret;
+	}
+#endif
+	close(fd);
+
+	std::memcpy(&header, base, sizeof(header));
+	if (std::memcmp(header.magic, file_magic, sizeof(header.magic)))
+		file_error(path, "not a table file");
+	if (header.version != file_version)
+		file_error(path, "unsupported table file version");
+	if (header.byte_order != file_byte_order)
+		file_error(path, "table file saved with different byte order");
+
+	Table ret;
+	FileHeader expected;
+
+	fill_header(expected);
+	if (std::memcmp(header.grid, expected.grid, sizeof(header.grid))
+			|| header.data_size != ret.layout(0))
+		file_error(path, "incompatible table layout");
+	if (size != file_data_offset + header.data_size)
+		file_error(path, "truncated table file");
+	if (header.kind != PH && header.kind != PS)
+		file_error(path, "invalid table kind");
+
+	st->data = base + file_data_offset;
+	st->size = header.data_size;
+	if (header.checksum != checksum(header, st->data, st->size))
+		file_error(path, "table file checksum mismatch");
+
+	ret._kind = static_cast<kind_type>(header.kind);
+	ret._tolerance = header.tolerance;
+	ret._fallback_cells = header.fallback_cells;
+	ret._cells = header.cells;
+	ret._storage = st;
+	// the mapping is read-only, but the table is never written to
+	ret.layout(base + file_data_offset);
+
+	return ret;
+}
+
+void Table::save(const char* path) const
+{
+	FileHeader header;
+	char padding[file_data_offset - sizeof(FileHeader)] = {};
+
+	fill_header(header);
+	header.kind = _kind;
+	header.tolerance = _tolerance;
+	header.fallback_cells = _fallback_cells;
+	header.cells = _cells;
+	header.data_size = _storage->size;
+	header.checksum = checksum(header, _storage->data, _storage->size);
+
+	std::FILE* f = std::fopen(path, "wb");
+	if (!f)
+		file_error(path, std::strerror(errno));
+
+	std::fwrite(&header, sizeof(header), 1, f);
+	std::fwrite(padding, sizeof(padding), 1, f);
+	std::fwrite(_storage->data, 1, _storage->size, f);
+
+	bool failed = std::ferror(f);
+	failed |= std::fclose(f) != 0;
+	if (failed)
+		file_error(path, "unable to write the table file");
+}
+
+Table::kind_type Table::kind() const
+{
+	return _kind;
+}
+
+bool Table::mapped() const
+{
+	return _storage->map != 0;
+}
+
+double Table::tolerance() const
+{
+	return _tolerance;
+}
+
+double Table::fallback_ratio() const
+{
+	return static_cast<double>(_fallback_cells) / _cells;
+}
+
+const Table& sbtl::ph_table()
+{
+	static const Table table(Table::PH);
+
+	return table;
+}
+
+const Table& sbtl::ps_table()
+{
+	static const Table table(Table::PS);
+
+	return table;
+}
+
+PropertySet sbtl::ph(double p, double h)
+{
+	return ph_table()(p, h);
+}
+
+PropertySet sbtl::ps(double p, double s)
+{
+	return ps_table()(p, s);
+}
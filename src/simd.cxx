@@ -0,0 +1,111 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include <atomic>
+#include <cassert>
+
+#include "simd.hxx"
+
+using namespace h2o;
+using namespace h2o::batch;
+
+static const bool not_reached = false; // for assert()
+
+static bool supported(isa_type isa)
+{
+	switch (isa)
+	{
+		case ISA_SCALAR:
+			return true;
+#ifdef H2OXX_SIMD
+		case ISA_SSE2:
+			return __builtin_cpu_supports("sse2");
+		case ISA_AVX2:
+			return __builtin_cpu_supports("avx2");
+		case ISA_AVX512:
+			return __builtin_cpu_supports("avx512f");
+#endif
+		default:
+			return false;
+	}
+}
+
+static isa_type best_isa()
+{
+#ifdef H2OXX_SIMD
+	// this can run before the libgcc constructors
+	__builtin_cpu_init();
+#endif
+
+	if (supported(ISA_AVX512))
+		return ISA_AVX512;
+	if (supported(ISA_AVX2))
+		return ISA_AVX2;
+	if (supported(ISA_SSE2))
+		return ISA_SSE2;
+	return ISA_SCALAR;
+}
+
+// selected when the library is loaded
+static std::atomic<int> current_isa(best_isa());
+
+isa_type batch::isa()
+{
+	return static_cast<isa_type>(
+			current_isa.load(std::memory_order_relaxed));
+}
+
+bool batch::set_isa(isa_type isa)
+{
+	if (!supported(isa))
+		return false;
+
+	current_isa.store(isa, std::memory_order_relaxed);
+	return true;
+}
+
+simd::kernel_func_t simd::kernel()
+{
+	switch (batch::isa())
+	{
+		case ISA_SCALAR:
+			return 0;
+#ifdef H2OXX_SIMD
+		case ISA_SSE2:
+			return evaluate_sse2;
+		case ISA_AVX2:
+			return evaluate_avx2;
+		case ISA_AVX512:
+			return evaluate_avx512;
+#endif
+		default:
+			assert(not_reached);
+			return 0;
+	}
+}
+
+simd::float_kernel_func_t simd::float_kernel()
+{
+	switch (batch::isa())
+	{
+		case ISA_SCALAR:
+			return 0;
+#ifdef H2OXX_SIMD
+		case ISA_SSE2:
+			return evaluate_sse2;
+		case ISA_AVX2:
+			return evaluate_avx2;
+		case ISA_AVX512:
+			return evaluate_avx512;
+#endif
+		default:
+			assert(not_reached);
+			return 0;
+	}
+}
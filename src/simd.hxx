@@ -0,0 +1,87 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#pragma once
+
+#ifndef _H2O_SIMD_INTERNAL_HXX
+#define _H2O_SIMD_INTERNAL_HXX 1
+
+#include <cstddef>
+
+#include "h2o_batch"
+
+namespace h2o
+{
+	namespace simd
+	{
+		/**
+		 * A block of region 1 or region 2 state points, passed
+		 * to the bulk kernels. The kernel reads @n (p,T) pairs,
+		 * and fills in the remaining columns.
+		 *
+		 * The capacity is a multiple of the widest vector, so the
+		 * kernels can pad the last vector within the block.
+		 */
+		template <class Real>
+		struct BasicBlock
+		{
+			enum
+			{
+				capacity = 64
+			};
+
+			size_t n;
+
+			alignas(64) Real p[capacity];
+			alignas(64) Real T[capacity];
+
+			alignas(64) Real rho[capacity];
+			alignas(64) Real v[capacity];
+			alignas(64) Real u[capacity];
+			alignas(64) Real h[capacity];
+			alignas(64) Real s[capacity];
+			alignas(64) Real cp[capacity];
+			alignas(64) Real cv[capacity];
+			alignas(64) Real w[capacity];
+		};
+
+		typedef BasicBlock<double> Block;
+		typedef BasicBlock<float> FloatBlock;
+
+		typedef void (*kernel_func_t)(Region region, Block& b);
+		typedef void (*float_kernel_func_t)(Region region, FloatBlock& b);
+
+		/**
+		 * Get the kernel for the instruction set selected
+		 * by batch::set_isa() (or the best one supported by the CPU).
+		 * Returns a null pointer for batch::ISA_SCALAR.
+		 *
+		 * The float kernels process twice as many state points
+		 * at a time as the double ones. They have to be called with
+		 * flush-to-zero enabled (see BasicH2O<float>).
+		 */
+		kernel_func_t kernel();
+		float_kernel_func_t float_kernel();
+
+#ifdef H2OXX_SIMD
+		/**
+		 * The kernels for the particular instruction sets. Each one
+		 * is built with the respective compiler flags, and may be
+		 * called only if the CPU supports them.
+		 */
+		void evaluate_sse2(Region region, Block& b);
+		void evaluate_avx2(Region region, Block& b);
+		void evaluate_avx512(Region region, Block& b);
+
+		void evaluate_sse2(Region region, FloatBlock& b);
+		void evaluate_avx2(Region region, FloatBlock& b);
+		void evaluate_avx512(Region region, FloatBlock& b);
+#endif
+	}
+}
+
+#endif /*_H2O_SIMD_INTERNAL_HXX*/
+
+// vim:ft=cpp
@@ -0,0 +1,23 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+// built with -mavx512f -ffp-contract=off (see Makefile.am)
+#include "simd_kernels.hxx"
+
+using namespace h2o;
+
+void simd::evaluate_avx512(Region region, Block& b)
+{
+	evaluate<8>(region, b);
+}
+
+void simd::evaluate_avx512(Region region, FloatBlock& b)
+{
+	evaluate<16>(region, b);
+}
@@ -0,0 +1,192 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#pragma once
+
+#ifndef _H2O_SIMD_KERNELS_HXX
+#define _H2O_SIMD_KERNELS_HXX 1
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#include "h2o_precision"
+#include "if97_kernels.hxx"
+#include "simd.hxx"
+
+namespace h2o
+{
+	namespace simd
+	{
+		// The code below is compiled once per instruction set, with
+		// different compiler flags. It is kept local to the translation
+		// unit, so that the linker can not pick e.g. the AVX2 copy
+		// of a template instance for the SSE2 kernel. The basic
+		// equation kernels are instantiated over Lanes, and so they
+		// are local as well.
+		namespace
+		{
+			// GCC vector types of @N values of @Real
+			template <class Real, size_t N>
+			struct Vector
+			{
+				typedef Real type
+					__attribute__((vector_size(N * sizeof(Real))));
+			};
+
+			/**
+			 * @N values of @Real, processed together in a vector
+			 * register (using the GCC vector extensions).
+			 */
+			template <class Real, size_t N>
+			class Lanes
+			{
+				typedef typename Vector<Real, N>::type vector_type;
+
+				vector_type _v;
+
+				Lanes(vector_type v)
+					: _v(v)
+				{
+				}
+
+			public:
+				Lanes()
+				{
+				}
+
+				Lanes(Real x)
+				{
+					vector_type zero = {};
+
+					_v = zero + x;
+				}
+
+				static Lanes load(const Real* src)
+				{
+					Lanes ret;
+
+					std::memcpy(&ret._v, src, sizeof(ret._v));
+					return ret;
+				}
+
+				void store(Real* dst) const
+				{
+					std::memcpy(dst, &_v, sizeof(_v));
+				}
+
+				Lanes& operator+=(const Lanes& b)
+				{
+					_v += b._v;
+					return *this;
+				}
+
+				Lanes& operator-=(const Lanes& b)
+				{
+					_v -= b._v;
+					return *this;
+				}
+
+				Lanes& operator*=(const Lanes& b)
+				{
+					_v *= b._v;
+					return *this;
+				}
+
+				friend Lanes operator-(const Lanes& a)
+				{
+					return Lanes(-a._v);
+				}
+
+				friend Lanes operator+(const Lanes& a, const Lanes& b)
+				{
+					return Lanes(a._v + b._v);
+				}
+
+				friend Lanes operator-(const Lanes& a, const Lanes& b)
+				{
+					return Lanes(a._v - b._v);
+				}
+
+				friend Lanes operator*(const Lanes& a, const Lanes& b)
+				{
+					return Lanes(a._v * b._v);
+				}
+
+				friend Lanes operator/(const Lanes& a, const Lanes& b)
+				{
+					return Lanes(a._v / b._v);
+				}
+
+				// these are needed once per state point, so they are
+				// simply evaluated lane by lane
+				friend Lanes log(const Lanes& a)
+				{
+					Lanes ret;
+
+					for (size_t i = 0; i < N; ++i)
+						ret._v[i] = std::log(a._v[i]);
+					return ret;
+				}
+
+				friend Lanes sqrt(const Lanes& a)
+				{
+					Lanes ret;
+
+					for (size_t i = 0; i < N; ++i)
+						ret._v[i] = std::sqrt(a._v[i]);
+					return ret;
+				}
+			};
+
+			/**
+			 * Evaluate a block of region 1 or 2 state points, @N points
+			 * at a time.
+			 */
+			template <size_t N, class Real>
+			inline void evaluate(Region region, BasicBlock<Real>& b)
+			{
+				typedef Lanes<Real, N> lanes_type;
+
+				static_assert(BasicBlock<Real>::capacity % N == 0,
+						"The block capacity must be a multiple of the width");
+				assert(b.n > 0 && b.n <= BasicBlock<Real>::capacity);
+				assert(region == Region::R1 || region == Region::R2);
+
+				// pad the last vector with a valid state point
+				for (size_t i = b.n; i % N; ++i)
+				{
+					b.p[i] = b.p[b.n - 1];
+					b.T[i] = b.T[b.n - 1];
+				}
+
+				for (size_t i = 0; i < b.n; i += N)
+				{
+					lanes_type p = lanes_type::load(&b.p[i]);
+					lanes_type T = lanes_type::load(&b.T[i]);
+					BasicPropertySet<lanes_type> ps;
+
+					if (region == Region::R1)
+						if97::kernels::region1(p, T, ps);
+					else
+						if97::kernels::region2(p, T, ps);
+
+					ps.rho.store(&b.rho[i]);
+					ps.v.store(&b.v[i]);
+					ps.u.store(&b.u[i]);
+					ps.h.store(&b.h[i]);
+					ps.s.store(&b.s[i]);
+					ps.cp.store(&b.cp[i]);
+					ps.cv.store(&b.cv[i]);
+					ps.w.store(&b.w[i]);
+				}
+			}
+		}
+	}
+}
+
+#endif /*_H2O_SIMD_KERNELS_HXX*/
+
+// vim:ft=cpp
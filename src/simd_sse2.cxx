@@ -0,0 +1,23 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+// built with -msse2 -ffp-contract=off (see Makefile.am)
+#include "simd_kernels.hxx"
+
+using namespace h2o;
+
+void simd::evaluate_sse2(Region region, Block& b)
+{
+	evaluate<2>(region, b);
+}
+
+void simd::evaluate_sse2(Region region, FloatBlock& b)
+{
+	evaluate<4>(region, b);
+}
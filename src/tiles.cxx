@@ -0,0 +1,443 @@
+/* libh2o -- steam & water properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "h2o_saturation"
+#include "h2o_tiles"
+#include "if97.hxx"
+
+using namespace h2o;
+
+static const bool not_reached = false; // for assert()
+static const double nan_value = std::numeric_limits<double>::quiet_NaN();
+
+// the tile grid range
+static const double p_min = 0.001;
+static const double p_max = 100.;
+static const double h_min = 0.;
+static const double h_max = 4200.;
+
+static const double p_crit = 22.064;
+
+// the finest subdivision of a tile, in cells per axis
+static const size_t max_cells = 8;
+
+// the fraction of the tolerance the check points have to be within,
+// as a margin for the error between them
+static const double check_margin = 0.75;
+
+// the interpolated fields: T, ln v, s and x (in region 4 only)
+enum
+{
+	FIELD_T,
+	FIELD_LNV,
+	FIELD_S,
+	FIELD_X,
+	FIELDS
+};
+
+// the magnitude below which the tolerance is absolute
+static const double field_floors[FIELDS] = { 0., 0., 1., 1. };
+
+struct TileCache::Tile
+{
+	// Region::OOR for the tiles evaluated directly
+	Region region;
+	size_t cells;
+	// (3 cells + 1)^2 nodes, with h varying fastest, and all the fields
+	std::vector<double> nodes;
+};
+
+namespace
+{
+	/**
+	 * The nodes of a tile split into @cells cells per axis,
+	 * as obtained while building the tile.
+	 */
+	struct Grid
+	{
+		size_t cells;
+		Region region;
+		if97::backward_type equation;
+		std::vector<double> values;
+
+		size_t stride() const
+		{
+			return 3 * cells + 1;
+		}
+	};
+}
+
+static inline bool within(double value, double expected, double tolerance,
+		double floor)
+{
+	return std::fabs(value - expected)
+		<= tolerance * std::max(std::fabs(expected), floor);
+}
+
+/**
+ * Get the weights of the four-point Lagrange polynomial through
+ * the nodes 0, 1, 2, 3 at @t.
+ */
+static inline void lagrange_weights(double t, double* w)
+{
+	double t0 = t, t1 = t - 1., t2 = t - 2., t3 = t - 3.;
+
+	w[0] = -t1 * t2 * t3 / 6.;
+	w[1] = t0 * t2 * t3 / 2.;
+	w[2] = -t0 * t1 * t3 / 2.;
+	w[3] = t0 * t1 * t2 / 6.;
+}
+
+/**
+ * Interpolate the fields at (@a, @b), in the units of the node spacing,
+ * from the @cells x @cells cells in @nodes.
+ */
+static void interpolate(const double* nodes, size_t cells, double a,
+		double b, double* out)
+{
+	size_t stride = 3 * cells + 1;
+	size_t ca = std::min(static_cast<size_t>(std::max(a, 0.) / 3.),
+			cells - 1);
+	size_t cb = std::min(static_cast<size_t>(std::max(b, 0.) / 3.),
+			cells - 1);
+	double wa[4], wb[4];
+
+	lagrange_weights(a - 3. * ca, wa);
+	lagrange_weights(b - 3. * cb, wb);
+
+	for (int f = 0; f < FIELDS; ++f)
+		out[f] = 0.;
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		const double* row = nodes
+			+ ((3 * ca + i) * stride + 3 * cb) * FIELDS;
+
+		for (size_t j = 0; j < 4; ++j)
+		{
+			double w = wa[i] * wb[j];
+
+			for (int f = 0; f < FIELDS; ++f)
+				out[f] += w * row[j * FIELDS + f];
+		}
+	}
+}
+
+/**
+ * Evaluate the nodes of @grid, split into @cells cells per axis.
+ * The nodes shared with @coarse (with half the cells) are copied
+ * from it.
+ *
+ * Returns false if any of the nodes is out of range, or evaluated using
+ * another equation than the others (in another region, or backward
+ * equation subregion). The interpolation can not follow the jumps
+ * between them.
+ */
+static bool fill_grid(Grid& grid, size_t cells, double lnp0, double dlnp,
+		double h0, double dh, const Grid* coarse)
+{
+	grid.cells = cells;
+	grid.region = coarse ? coarse->region : Region(Region::OOR);
+	grid.equation = coarse ? coarse->equation : if97::BACKWARD_1;
+	grid.values.resize(grid.stride() * grid.stride() * FIELDS);
+
+	size_t n = grid.stride() - 1;
+
+	for (size_t i = 0; i <= n; ++i)
+	{
+		double p = std::exp(lnp0 + dlnp * i / n);
+
+		for (size_t j = 0; j <= n; ++j)
+		{
+			double* out = &grid.values[(i * (n + 1) + j) * FIELDS];
+
+			if (coarse && i % 2 == 0 && j % 2 == 0)
+			{
+				const double* in = &coarse->values[
+					((i / 2) * coarse->stride() + j / 2) * FIELDS];
+
+				std::copy(in, in + FIELDS, out);
+				continue;
+			}
+
+			double h = h0 + dh * j / n;
+			H2O st = H2O::try_ph(p, h);
+
+			if (!st.initialized())
+				return false;
+
+			if97::backward_type equation
+				= if97::backward_ph(st.region(), p, h);
+
+			if (grid.region == Region::OOR)
+			{
+				grid.region = st.region();
+				grid.equation = equation;
+			}
+			else if (st.region() != grid.region
+					|| equation != grid.equation)
+				return false;
+
+			PropertySet ps = st.properties();
+
+			out[FIELD_T] = ps.T;
+			out[FIELD_LNV] = std::log(ps.v);
+			out[FIELD_S] = ps.s;
+			out[FIELD_X] = grid.region == Region::R4 ? ps.x : 0.;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Check whether the interpolation from @coarse is within @tolerance
+ * at the remaining nodes of @fine (the midpoints between the nodes
+ * of @coarse).
+ *
+ * The caller passes a fraction of the tolerance (check_margin),
+ * so that the error stays within it between the check points
+ * as well.
+ */
+static bool check_grid(const Grid& coarse, const Grid& fine,
+		double tolerance)
+{
+	size_t stride = fine.stride();
+
+	for (size_t i = 0; i < stride; ++i)
+	{
+		for (size_t j = i % 2 ? 0 : 1; j < stride; j += i % 2 ? 1 : 2)
+		{
+			const double* expected = &fine.values[(i * stride + j) * FIELDS];
+			double value[FIELDS];
+
+			interpolate(&coarse.values[0], coarse.cells, i / 2., j / 2.,
+					value);
+
+			if (!within(value[FIELD_T], expected[FIELD_T], tolerance, 0.)
+					|| !within(std::exp(value[FIELD_LNV]),
+						std::exp(expected[FIELD_LNV]), tolerance, 0.))
+				return false;
+
+			for (int f = FIELD_S; f < FIELDS; ++f)
+			{
+				if (!within(value[f], expected[f], tolerance,
+							field_floors[f]))
+					return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Check whether the saturation line crosses the tile, at the pressures
+ * of the finest grid. This catches the tiles where the two-phase
+ * region only cuts a corner between the nodes.
+ */
+static bool crosses_saturation(double lnp0, double dlnp, double h0,
+		double dh)
+{
+	size_t n = 3 * max_cells;
+
+	for (size_t i = 0; i <= n; ++i)
+	{
+		double p = std::exp(lnp0 + dlnp * i / n);
+
+		if (p > p_crit)
+			break;
+
+		saturation::State sat = saturation::p(p);
+
+		if ((sat.liquid.h > h0 && sat.liquid.h < h0 + dh)
+				|| (sat.vapour.h > h0 && sat.vapour.h < h0 + dh))
+			return true;
+	}
+
+	return false;
+}
+
+TileCache::TileCache(double tolerance, size_t p_tiles, size_t h_tiles)
+	: _tiles(new std::atomic<Tile*>[p_tiles * h_tiles]),
+	_p_tiles(p_tiles), _h_tiles(h_tiles),
+	_dlnp(std::log(p_max / p_min) / p_tiles),
+	_dh((h_max - h_min) / h_tiles),
+	_tolerance(tolerance), _built(0), _exact(0), _memory(0)
+{
+	assert(p_tiles > 0);
+	assert(h_tiles > 0);
+
+	for (size_t i = 0; i < tiles(); ++i)
+		_tiles[i].store(0, std::memory_order_relaxed);
+}
+
+TileCache::~TileCache()
+{
+	for (size_t i = 0; i < tiles(); ++i)
+		delete _tiles[i].load(std::memory_order_relaxed);
+}
+
+TileCache::Tile* TileCache::build(size_t ip, size_t ih) const
+{
+	double lnp0 = std::log(p_min) + ip * _dlnp;
+	double h0 = h_min + ih * _dh;
+	Tile* ret = new Tile;
+
+	ret->cells = 0;
+	if (crosses_saturation(lnp0, _dlnp, h0, _dh))
+		return ret;
+
+	Grid coarse, fine;
+
+	if (!fill_grid(coarse, 1, lnp0, _dlnp, h0, _dh, 0))
+		return ret;
+
+	for (size_t cells = 1; cells <= max_cells; cells *= 2)
+	{
+		if (!fill_grid(fine, cells * 2, lnp0, _dlnp, h0, _dh, &coarse))
+			break;
+
+		if (check_grid(coarse, fine, _tolerance * check_margin))
+		{
+			ret->region = coarse.region;
+			ret->cells = cells;
+			ret->nodes.swap(coarse.values);
+			break;
+		}
+
+		std::swap(coarse, fine);
+	}
+
+	return ret;
+}
+
+const TileCache::Tile& TileCache::tile(size_t ip, size_t ih)
+{
+	std::atomic<Tile*>& slot = _tiles[ip * _h_tiles + ih];
+	Tile* ret = slot.load(std::memory_order_acquire);
+
+	if (!ret)
+	{
+		Tile* fresh = build(ip, ih);
+
+		// publish the tile, unless another thread was faster
+		if (slot.compare_exchange_strong(ret, fresh,
+					std::memory_order_acq_rel, std::memory_order_acquire))
+		{
+			ret = fresh;
+			_built.fetch_add(1, std::memory_order_relaxed);
+			if (!fresh->cells)
+				_exact.fetch_add(1, std::memory_order_relaxed);
+			_memory.fetch_add(sizeof(Tile)
+					+ fresh->nodes.capacity() * sizeof(double),
+					std::memory_order_relaxed);
+		}
+		else
+			delete fresh;
+	}
+
+	return *ret;
+}
+
+/**
+ * Evaluate the state point directly, returning the same properties
+ * as the interpolation.
+ */
+static PropertySet evaluate(double p, double h)
+{
+	PropertySet ret = H2O::ph(p, h).properties();
+
+	ret.cp = ret.cv = ret.w = nan_value;
+	return ret;
+}
+
+PropertySet TileCache::operator()(double p, double h)
+{
+	double a = std::log(p / p_min) / _dlnp;
+	double b = (h - h_min) / _dh;
+
+	if (!(a >= 0. && a <= _p_tiles && b >= 0. && b <= _h_tiles))
+		return evaluate(p, h);
+
+	size_t ip = std::min(static_cast<size_t>(a), _p_tiles - 1);
+	size_t ih = std::min(static_cast<size_t>(b), _h_tiles - 1);
+	const Tile& t = tile(ip, ih);
+
+	if (!t.cells)
+		return evaluate(p, h);
+
+	double n = 3. * t.cells;
+	double f[FIELDS];
+	PropertySet ret;
+
+	interpolate(&t.nodes[0], t.cells, (a - ip) * n, (b - ih) * n, f);
+
+	ret.p = p;
+	ret.T = f[FIELD_T];
+	ret.v = std::exp(f[FIELD_LNV]);
+	ret.rho = 1. / ret.v;
+	ret.h = h;
+	ret.u = h - 1000. * p * ret.v;
+	ret.s = f[FIELD_S];
+	ret.cp = ret.cv = ret.w = nan_value;
+
+	switch (t.region)
+	{
+		case Region::R1:
+			ret.x = 0.;
+			break;
+		case Region::R2:
+		case Region::R5:
+			ret.x = 1.;
+			break;
+		case Region::R3:
+			ret.x = nan_value;
+			break;
+		case Region::R4:
+			ret.x = f[FIELD_X];
+			break;
+		default:
+			assert(not_reached);
+	}
+
+	return ret;
+}
+
+size_t TileCache::tiles() const
+{
+	return _p_tiles * _h_tiles;
+}
+
+size_t TileCache::built() const
+{
+	return _built.load(std::memory_order_relaxed);
+}
+
+size_t TileCache::exact() const
+{
+	return _exact.load(std::memory_order_relaxed);
+}
+
+size_t TileCache::memory() const
+{
+	return _memory.load(std::memory_order_relaxed);
+}
+
+double TileCache::tolerance() const
+{
+	return _tolerance;
+}
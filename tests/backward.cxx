@@ -0,0 +1,359 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o_backward"
+#include "tests.hxx"
+
+#include <cmath>
+#include <stdexcept>
+
+static bool close(double a, double b, double tolerance)
+{
+	return std::fabs(a - b) <= tolerance * std::fabs(b);
+}
+
+// the verification values from the IAPWS releases on the backward
+// equations; T in K (9 significant digits), p in MPa
+static const struct
+{
+	double a, b, expected;
+} T_ph_values[] =
+{
+	{ 3., 500., 0.391798509E3 },
+	{ 80., 500., 0.378108626E3 },
+	{ 80., 1500., 0.611041229E3 },
+	{ 0.001, 3000., 0.534433241E3 },
+	{ 3., 3000., 0.575373370E3 },
+	{ 3., 4000., 0.101077577E4 },
+	{ 5., 3500., 0.801299102E3 },
+	{ 5., 4000., 0.101531583E4 },
+	{ 25., 3500., 0.875279054E3 },
+	{ 40., 2700., 0.743056411E3 },
+	{ 60., 2700., 0.791137067E3 },
+	{ 60., 3200., 0.882756860E3 },
+	{ 50., 2000., 0.6905718338E3 },
+	{ 100., 2100., 0.7336163014E3 },
+	{ 50., 2400., 0.7351848618E3 },
+	{ 100., 2700., 0.8420460876E3 }
+}, T_ps_values[] =
+{
+	{ 3., 0.5, 0.307842258E3 },
+	{ 80., 0.5, 0.309979785E3 },
+	{ 80., 3., 0.565899909E3 },
+	{ 0.1, 7.5, 0.399517097E3 },
+	{ 0.1, 8., 0.514127081E3 },
+	{ 2.5, 8., 0.103984917E4 },
+	{ 8., 6., 0.600484040E3 },
+	{ 8., 7.5, 0.106495556E4 },
+	{ 90., 6., 0.103801126E4 },
+	{ 20., 5.75, 0.697992849E3 },
+	{ 80., 5.25, 0.854011484E3 },
+	{ 80., 5.75, 0.949017998E3 },
+	{ 50., 3.6, 0.6297158726E3 },
+	{ 100., 4., 0.7056880237E3 },
+	{ 50., 4.5, 0.7163687517E3 },
+	{ 100., 5., 0.8474332825E3 }
+}, p_hs_values[] =
+{
+	{ 90., 0., 0.9192954727E2 },
+	{ 1500., 3.4, 0.5868294423E2 },
+	{ 2800., 6.5, 0.1371012767E1 },
+	{ 2800., 9.5, 0.1879743844E-2 },
+	{ 4100., 9.5, 0.1024788997 },
+	{ 2800., 6., 0.4793911442E1 },
+	{ 3600., 6., 0.8395519209E2 },
+	{ 3600., 7., 0.7527161441E1 },
+	{ 2800., 5.1, 0.9439202060E2 },
+	{ 2800., 5.8, 0.8414574124E1 },
+	{ 3400., 5.8, 0.8376903879E2 }
+}, T_hs_values[] =
+{
+	{ 1800., 5.3, 0.3468475498E3 },
+	{ 2400., 6., 0.4251373305E3 },
+	{ 2500., 5.5, 0.5225579013E3 }
+}, v_pT_values[] =
+{
+	{ 50., 630., 0.1470853100E-2 },
+	{ 80., 670., 0.1503831359E-2 },
+	{ 50., 710., 0.2204728587E-2 },
+	{ 80., 750., 0.1973692940E-2 },
+	{ 20., 630., 0.1761696406E-2 },
+	{ 30., 650., 0.1819560617E-2 },
+	{ 26., 656., 0.2245587720E-2 },
+	{ 30., 670., 0.2506897702E-2 },
+	{ 26., 661., 0.2970225962E-2 },
+	{ 30., 675., 0.3004627086E-2 },
+	{ 26., 671., 0.5019029401E-2 },
+	{ 30., 690., 0.4656470142E-2 },
+	{ 23.6, 649., 0.2163198378E-2 },
+	{ 24., 650., 0.2166044161E-2 },
+	{ 23.6, 652., 0.2651081407E-2 },
+	{ 24., 654., 0.2967802335E-2 },
+	{ 23.6, 653., 0.3273916816E-2 },
+	{ 24., 655., 0.3550329864E-2 },
+	{ 23.5, 655., 0.4545001142E-2 },
+	{ 24., 660., 0.5100267704E-2 },
+	{ 23., 660., 0.6109525997E-2 },
+	{ 24., 670., 0.6427325645E-2 },
+	{ 22.6, 646., 0.2117860851E-2 },
+	{ 23., 646., 0.2062374674E-2 },
+	{ 22.6, 648.6, 0.2533063780E-2 },
+	{ 22.8, 649.3, 0.2572971781E-2 },
+	{ 22.6, 649., 0.2923432711E-2 },
+	{ 22.8, 649.7, 0.2913311494E-2 },
+	{ 22.6, 649.1, 0.3131208996E-2 },
+	{ 22.8, 649.9, 0.3221160278E-2 },
+	{ 22.6, 649.4, 0.3715596186E-2 },
+	{ 22.8, 650.2, 0.3664754790E-2 },
+	{ 21.1, 640., 0.1970999272E-2 },
+	{ 21.8, 643., 0.2043919161E-2 },
+	{ 21.1, 644., 0.5251009921E-2 },
+	{ 21.8, 648., 0.5256844741E-2 },
+	{ 19.1, 635., 0.1932829079E-2 },
+	{ 20., 638., 0.1985387227E-2 },
+	{ 17., 626., 0.8483262001E-2 },
+	{ 20., 640., 0.6227528101E-2 },
+	{ 21.5, 644.6, 0.2268366647E-2 },
+	{ 22., 646.1, 0.2296350553E-2 },
+	{ 22.5, 648.6, 0.2832373260E-2 },
+	{ 22.3, 647.9, 0.2811424405E-2 },
+	{ 22.15, 647.5, 0.3694032281E-2 },
+	{ 22.3, 648.1, 0.3622226305E-2 },
+	{ 22.11, 648., 0.4528072649E-2 },
+	{ 22.3, 649., 0.4556905799E-2 },
+	{ 22., 646.84, 0.2698354719E-2 },
+	{ 22.064, 647.05, 0.2717655648E-2 },
+	{ 22., 646.89, 0.3798732962E-2 },
+	{ 22.064, 647.15, 0.3701940010E-2 }
+};
+
+#define COUNT(a) (sizeof(a) / sizeof(*(a)))
+
+typedef h2o::H2O (*backward_func_t)(double, double,
+		h2o::backward::mode_type);
+typedef h2o::backward::Deviation (*check_func_t)(double, double,
+		h2o::backward::mode_type);
+
+// check the consistency of the backward equations with the basic
+// equations, at a state point obtained from (p,T)
+static void check_state(const char* what, const h2o::H2O& st,
+		backward_func_t f, check_func_t cf, double a, double b,
+		double tolerance)
+{
+	h2o::H2O fast, polished, exact;
+
+	try
+	{
+		fast = f(a, b, h2o::backward::FAST);
+		polished = f(a, b, h2o::backward::POLISH);
+		exact = f(a, b, h2o::backward::EXACT);
+	}
+	catch (std::range_error& e)
+	{
+		check(false, what, a, b);
+		return;
+	}
+
+	double fast_error = std::fabs(fast.T() - st.T());
+	double polished_error = std::fabs(polished.T() - st.T());
+
+	check(fast.region() == st.region(), what, a, b);
+	check(fast_error <= tolerance, what, a, b);
+	check(polished_error <= std::max(fast_error, 1E-9), what, a, b);
+	check(close(exact.T(), st.T(), 1E-9), what, a, b);
+	check(close(exact.p(), st.p(), 1E-8), what, a, b);
+
+	h2o::backward::Deviation d = cf(a, b, h2o::backward::FAST);
+	check(d.dT == fast.T() - exact.T(), what, a, b);
+}
+
+int main(void)
+{
+	for (size_t i = 0; i < COUNT(T_ph_values); ++i)
+	{
+		double p = T_ph_values[i].a, h = T_ph_values[i].b;
+
+		check(close(h2o::backward::ph(p, h).T(),
+					T_ph_values[i].expected, 5E-9),
+				"T(p,h)", p, h);
+	}
+
+	for (size_t i = 0; i < COUNT(T_ps_values); ++i)
+	{
+		double p = T_ps_values[i].a, s = T_ps_values[i].b;
+
+		check(close(h2o::backward::ps(p, s).T(),
+					T_ps_values[i].expected, 5E-9),
+				"T(p,s)", p, s);
+	}
+
+	for (size_t i = 0; i < COUNT(p_hs_values); ++i)
+	{
+		double h = p_hs_values[i].a, s = p_hs_values[i].b;
+
+		check(close(h2o::backward::hs(h, s).p(),
+					p_hs_values[i].expected, 5E-9),
+				"p(h,s)", h, s);
+	}
+
+	for (size_t i = 0; i < COUNT(T_hs_values); ++i)
+	{
+		double h = T_hs_values[i].a, s = T_hs_values[i].b;
+		h2o::H2O st = h2o::backward::hs(h, s);
+
+		check(st.region() == h2o::Region::R4, "Tsat(h,s) region", h, s);
+		check(close(st.T(), T_hs_values[i].expected, 5E-9),
+				"Tsat(h,s)", h, s);
+	}
+
+	// v(p,T) in region 3, along with the number of Newton steps needed
+	// to reproduce p with the basic equation
+	for (size_t i = 0; i < COUNT(v_pT_values); ++i)
+	{
+		double p = v_pT_values[i].a, T = v_pT_values[i].b;
+		h2o::backward::Deviation d = h2o::backward::check_pT(p, T);
+
+		// libh2o may consider the (rho,T) states close to the saturation
+		// line two-phase; these fall back to H2O::pT()
+		double fallback_v = h2o::H2O::pT(p, T).v();
+
+		check(d.iterations <= 8, "v(p,T) iterations", p, T);
+		check(d.state.region() == h2o::Region::R3
+				&& d.exact.region() == h2o::Region::R3,
+				"v(p,T) region", p, T);
+		check(close(d.state.v(), v_pT_values[i].expected, 1E-9)
+				|| d.state.v() == fallback_v, "v(p,T)", p, T);
+		check(close(d.exact.p(), p, 1E-12) || d.exact.v() == fallback_v,
+				"v(p,T) exact p", p, T);
+		check(d.state.T() == T && d.exact.T() == T, "v(p,T) T", p, T);
+	}
+
+	// a state next to the saturation line, which libh2o would
+	// reclassify as two-phase from (rho,T)
+	h2o::backward::Deviation sat = h2o::backward::check_pT(17., 626.);
+	check(sat.exact.region() == h2o::Region::R3
+			&& close(sat.exact.p(), 17., 1E-5)
+			&& close(sat.exact.T(), 626., 1E-12), "pT near saturation",
+			17., 626.);
+
+	// a (p,T) grid over regions 1, 2, 3 and 5, away from
+	// the boundaries
+	for (double p = 0.01; p < 100.; p *= 1.7)
+	{
+		for (double T = 280.; T < 2000.; T += 47.)
+		{
+			h2o::H2O st;
+
+			try
+			{
+				st = h2o::H2O::pT(p, T);
+			}
+			catch (std::range_error& e)
+			{
+				continue;
+			}
+
+			h2o::H2O pT = h2o::backward::pT(p, T);
+			check(pT.region() == st.region(), "pT region", p, T);
+			check(close(pT.rho(), st.rho(), 1E-12), "pT rho", p, T);
+
+			// keep clear of the saturation line, and the IF97
+			// inconsistencies at the boundaries of region 3
+			if (st.region() == h2o::Region::R3 && p < 22.064)
+				continue;
+			if (std::fabs(T - 623.15) < 5. || std::fabs(T - 1073.15) < 5.)
+				continue;
+			if (p < 22.064 && std::fabs(h2o::H2O::px(p, 0.).T() - T) < 5.)
+				continue;
+
+			// in region 3, p is recomputed from (rho,T)
+			double h = st.h(), s = st.s();
+
+			check_state("ph", st, h2o::backward::ph,
+					h2o::backward::check_ph, st.p(), h, 0.03);
+			check_state("ps", st, h2o::backward::ps,
+					h2o::backward::check_ps, st.p(), s, 0.03);
+			if (st.region() != h2o::Region::R5)
+				check_state("hs", st, h2o::backward::hs,
+						h2o::backward::check_hs, h, s, 0.5);
+		}
+	}
+
+	// two-phase states
+	for (double T = 300.; T < 620.; T += 20.)
+	{
+		for (double x = 0.1; x < 1.; x += 0.2)
+		{
+			h2o::H2O st = h2o::H2O::Tx(T, x);
+			h2o::H2O ph = h2o::backward::ph(st.p(), st.h());
+
+			check(ph.region() == h2o::Region::R4, "ph two-phase", T, x);
+			check(close(ph.x(), x, 1E-9), "ph two-phase x", T, x);
+
+			// Tsat(h,s) covers only s >= s''(623.15 K)
+			if (st.s() < 5.3)
+				continue;
+
+			h2o::H2O hs = h2o::backward::hs(st.h(), st.s(),
+					h2o::backward::EXACT);
+
+			check(hs.region() == h2o::Region::R4, "hs two-phase", T, x);
+			check(close(hs.T(), T, 1E-9), "hs two-phase T", T, x);
+		}
+	}
+
+	// warm-started iteration, within the region of the hint
+	// and across the saturation line
+	{
+		h2o::H2O hint = h2o::H2O::pT(3., 600.);
+		double p[] = { 3.1, 0.5, 3., 3. };
+		double h[] = { 3050., 3000., 3100., 2000. };
+
+		for (int i = 0; i < 4; ++i)
+		{
+			h2o::H2O warm = h2o::backward::ph(p[i], h[i], hint);
+			h2o::H2O exact = h2o::backward::ph(p[i], h[i],
+					h2o::backward::EXACT);
+
+			check(warm.region() == exact.region(), "warm ph region",
+					p[i], h[i]);
+			check(close(warm.T(), exact.T(), 1E-12), "warm ph T",
+					p[i], h[i]);
+		}
+
+		h2o::H2O warm = h2o::backward::ps(2.9, hint.s(), hint);
+		check(close(warm.T(), h2o::backward::ps(2.9, hint.s(),
+						h2o::backward::EXACT).T(), 1E-12),
+				"warm ps T", 2.9, hint.s());
+		warm = h2o::backward::hs(hint.h() + 10., hint.s(), hint);
+		check(close(warm.p(), h2o::backward::hs(hint.h() + 10., hint.s(),
+						h2o::backward::EXACT).p(), 1E-12),
+				"warm hs p", hint.h() + 10., hint.s());
+	}
+
+	// expansion
+	h2o::H2O in = h2o::H2O::pT(10., 800.);
+	h2o::H2O out = h2o::backward::expand(in, 0.1, 0.85,
+			h2o::backward::EXACT);
+	h2o::H2O ref = in.expand(0.1, 0.85);
+	check(close(out.h(), ref.h(), 1E-5), "expand", 0.1, 0.85);
+
+	bool thrown = false;
+	try
+	{
+		h2o::backward::ph(1000., 500.);
+	}
+	catch (std::range_error& e)
+	{
+		thrown = true;
+	}
+	check(thrown, "out of range", 1000., 500.);
+
+	return finish();
+}
@@ -0,0 +1,128 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o_batch"
+#include "tests.hxx"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+static bool same(double a, double b)
+{
+	if (std::isnan(a) || std::isnan(b))
+		return std::isnan(a) && std::isnan(b);
+	return std::fabs(a - b) <= 1E-9 * std::fabs(b);
+}
+
+// compare every column against the scalar API
+static void check_against_scalar(const h2o::H2OArray& arr,
+		h2o::H2O (*constr)(double, double),
+		const std::vector<double>& a, const std::vector<double>& b)
+{
+	for (size_t i = 0; i < arr.size(); ++i)
+	{
+		h2o::H2O st;
+
+		try
+		{
+			st = constr(a[i], b[i]);
+		}
+		catch (std::range_error& e)
+		{
+		}
+
+		check(arr.region[i] == st.region(), "region", i);
+		if (!st.initialized())
+		{
+			check(std::isnan(arr.h[i]), "oor h", i);
+			continue;
+		}
+
+		check(same(arr.p[i], st.p()), "p", i);
+		check(same(arr.T[i], st.T()), "T", i);
+		if (st.region() != h2o::Region::R3)
+			check(same(arr.x[i], st.x()), "x", i);
+		check(same(arr.rho[i], st.rho()), "rho", i);
+		check(same(arr.v[i], st.v()), "v", i);
+		check(same(arr.u[i], st.u()), "u", i);
+		check(same(arr.h[i], st.h()), "h", i);
+		check(same(arr.s[i], st.s()), "s", i);
+		check(same(arr.cp[i], st.cp()), "cp", i);
+		check(same(arr.cv[i], st.cv()), "cv", i);
+		check(same(arr.w[i], st.w()), "w", i);
+	}
+}
+
+int main(void)
+{
+	h2o::H2OArray arr;
+
+	// pT, including one out-of-range point
+	double pT_p[] = { 3., 80., 0.0035, 30., 25., 0.5, 1000. };
+	double pT_T[] = { 300., 500., 700., 700., 650., 1500., 300. };
+	std::vector<double> p(pT_p, pT_p + 7), T(pT_T, pT_T + 7);
+
+	check(h2o::batch::pT(p, T, arr) == 1, "pT oor count", 0);
+	check(arr.size() == 7, "pT size", 0);
+	check_against_scalar(arr, h2o::H2O::pT, p, T);
+
+	// state points back from the columns
+	check(arr.at(0).h() == h2o::H2O::pT(3., 300.).h(), "at", 0);
+
+	bool thrown = false;
+	try
+	{
+		arr.at(6);
+	}
+	catch (std::range_error& e)
+	{
+		thrown = true;
+	}
+	check(thrown, "oor at", 6);
+
+	// ph & ps & hs, with a repeated scalar argument
+	std::vector<double> h(4), s(4);
+	h[0] = 500.; h[1] = 1500.; h[2] = 2800.; h[3] = 3500.;
+	s[0] = 1.5; s[1] = 3.5; s[2] = 6.; s[3] = 7.;
+
+	double p10 = 10.;
+	check(h2o::batch::ph(h2o::batch::View(p10, 4), h, arr) == 0,
+			"ph oor count", 0);
+	check_against_scalar(arr, h2o::H2O::ph, std::vector<double>(4, p10), h);
+
+	check(h2o::batch::ps(h2o::batch::View(p10, 4), s, arr) == 0,
+			"ps oor count", 0);
+	check_against_scalar(arr, h2o::H2O::ps, std::vector<double>(4, p10), s);
+
+	check(h2o::batch::hs(h, s, arr) == 0, "hs oor count", 0);
+	check_against_scalar(arr, h2o::H2O::hs, h, s);
+
+	// strided view over an array of (T, x) pairs
+	double Tx[] = { 300., 0., 400., 0.5, 500., 1. };
+	std::vector<double> Tx_T(3), Tx_x(3);
+	for (int i = 0; i < 3; ++i)
+	{
+		Tx_T[i] = Tx[2*i];
+		Tx_x[i] = Tx[2*i + 1];
+	}
+
+	check(h2o::batch::Tx(h2o::batch::View(Tx, 3, 2),
+				h2o::batch::View(Tx + 1, 3, 2), arr) == 0,
+			"Tx oor count", 0);
+	check_against_scalar(arr, h2o::H2O::Tx, Tx_T, Tx_x);
+
+	// column selection
+	h2o::batch::pT(p, T, arr, h2o::H2OArray::COL_H);
+	check(arr.h[0] == h2o::H2O(3., 300.).h(), "selected h", 0);
+	check(std::isnan(arr.v[0]), "unselected v", 0);
+	check(arr.region[0] == h2o::Region::R1, "region", 0);
+
+	return finish();
+}
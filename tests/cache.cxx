@@ -0,0 +1,88 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o_cache"
+#include "tests.hxx"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+int main(void)
+{
+	h2o::StateCache cache(64, 4);
+
+	check(cache.capacity() == 64, "capacity");
+	check(h2o::StateCache(10, 16).capacity() == 10, "odd capacity");
+	check(h2o::StateCache(3, 16).capacity() == 3, "small capacity");
+
+	// a miss, then a hit with identical results
+	h2o::H2O a = cache.pT(3., 300.);
+	h2o::H2O b = cache.pT(3., 300.);
+	check(cache.misses() == 1 && cache.hits() == 1, "hit after miss");
+	check(a.h() == b.h() && a.h() == h2o::H2O::pT(3., 300.).h(),
+			"cached state");
+
+	h2o::StateCache::Entry e = cache.get(h2o::StateCache::PH, 3., 500.);
+	check(e.properties.T == h2o::H2O::ph(3., 500.).T(),
+			"cached properties");
+
+	// constructors are part of the key
+	cache.ph(3., 300.);
+	check(cache.misses() == 3, "constructor in key");
+
+	// out-of-range inputs throw and are not cached
+	try
+	{
+		cache.pT(1000., 300.);
+		check(false, "range_error");
+	}
+	catch (std::range_error& e)
+	{
+		check(cache.size() == 3, "range_error not cached");
+	}
+
+	// bounded size
+	for (int i = 0; i < 1000; ++i)
+		cache.pT(1. + i * 0.01, 400.);
+	check(cache.size() <= cache.capacity(), "bounded size");
+
+	cache.clear();
+	check(cache.size() == 0 && cache.hits() == 0 && cache.misses() == 0,
+			"clear");
+
+	// concurrent look-ups of a shared working set
+	h2o::StateCache shared(256, 8);
+	std::atomic<int> mismatches(0);
+	std::vector<std::thread> threads;
+	const int nthreads = 4, lookups = 2000;
+
+	for (int t = 0; t < nthreads; ++t)
+		threads.push_back(std::thread([&shared, &mismatches, t]()
+		{
+			for (int i = 0; i < lookups; ++i)
+			{
+				double p = 0.1 + (i * 7 + t) % 100 * 0.1;
+				double h = 200. + (i * 13) % 50 * 50.;
+
+				if (shared.ph(p, h).T() != h2o::H2O::ph(p, h).T())
+					++mismatches;
+			}
+		}));
+	for (size_t t = 0; t < threads.size(); ++t)
+		threads[t].join();
+
+	check(mismatches == 0, "concurrent results");
+	check(shared.hits() + shared.misses() == nthreads * lookups,
+			"concurrent statistics");
+	check(shared.size() <= shared.capacity(), "concurrent bounded size");
+
+	return finish();
+}
@@ -0,0 +1,122 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o"
+#include "h2o_classifier"
+#include "tests.hxx"
+
+#include <iostream>
+
+#include <cmath>
+
+typedef h2o::Region (*classifier_func_t)(double, double);
+
+static void check_region(const char* what, classifier_func_t func,
+		double a, double b, h2o::Region expected)
+{
+	h2o::Region got = func(a, b);
+
+	check(got == expected, what, a, b, expected, got);
+}
+
+// the grid must agree with the exact classification everywhere
+static void check_grid(const char* what, classifier_func_t fast,
+		classifier_func_t exact, double y_min, double y_max)
+{
+	for (double lnp = std::log(0.0005); lnp <= std::log(110.);
+			lnp += 0.0137)
+	{
+		double p = std::exp(lnp);
+
+		for (double y = y_min; y <= y_max; y += (y_max - y_min) / 613.)
+			check_region(what, fast, p, y, exact(p, y));
+	}
+}
+
+int main(void)
+{
+	using h2o::H2O;
+	using h2o::Region;
+	namespace cl = h2o::classifier;
+
+	// sample state points, compared with libh2o
+	static const double pTs[][2] =
+	{
+		{ 3., 300. },
+		{ 80., 500. },
+		{ 0.0035, 300. },
+		{ 0.0035, 700. },
+		{ 30., 700. },
+		{ 25., 650. },
+		{ 100., 750. },
+		{ 0.5, 1500. },
+		{ 30., 2000. }
+	};
+
+	for (size_t i = 0; i < sizeof(pTs) / sizeof(*pTs); ++i)
+	{
+		double p = pTs[i][0], T = pTs[i][1];
+		H2O st = H2O::pT(p, T);
+
+		check_region("pT", cl::pT, p, T, st.region());
+		check_region("exact_pT", cl::exact_pT, p, T, st.region());
+		check_region("ph", cl::ph, p, st.h(), st.region());
+		check_region("exact_ph", cl::exact_ph, p, st.h(), st.region());
+		check_region("ps", cl::ps, p, st.s(), st.region());
+		check_region("exact_ps", cl::exact_ps, p, st.s(), st.region());
+	}
+
+	// two-phase, including region 3 pressures
+	static const double pxs[][2] =
+	{
+		{ 0.1, 0.5 },
+		{ 10., 0.1 },
+		{ 20., 0.5 },
+		{ 21.5, 0.9 }
+	};
+
+	for (size_t i = 0; i < sizeof(pxs) / sizeof(*pxs); ++i)
+	{
+		H2O st = H2O::px(pxs[i][0], pxs[i][1]);
+
+		check_region("ph", cl::ph, st.p(), st.h(), Region::R4);
+		check_region("ps", cl::ps, st.p(), st.s(), Region::R4);
+	}
+
+	// subcritical region 3, outside the saturation dome
+	H2O liq3 = H2O::pT(20., 630.);
+	check_region("ph", cl::ph, 20., liq3.h(), Region::R3);
+	check_region("ps", cl::ps, 20., liq3.s(), Region::R3);
+
+	// out-of-range
+	check_region("pT", cl::pT, 60., 1500., Region::OOR);
+	check_region("pT", cl::pT, 10., 2500., Region::OOR);
+	check_region("pT", cl::pT, 110., 500., Region::OOR);
+	check_region("ph", cl::ph, 1., -100., Region::OOR);
+	check_region("ph", cl::ph, 60., 6000., Region::OOR);
+	check_region("ps", cl::ps, 1., 20., Region::OOR);
+	check_region("ps", cl::ps, -1., 5., Region::OOR);
+
+	check_grid("pT grid", cl::pT, cl::exact_pT, 270., 2300.);
+	check_grid("ph grid", cl::ph, cl::exact_ph, -50., 7500.);
+	check_grid("ps grid", cl::ps, cl::exact_ps, -0.5, 14.);
+
+	// the lookup should resolve most of the state points
+	check(cl::fallback_ratio_pT() < 0.1, "fallback ratio pT", 0., 0.,
+			0, 0);
+	check(cl::fallback_ratio_ph() < 0.15, "fallback ratio ph", 0., 0.,
+			0, 0);
+	check(cl::fallback_ratio_ps() < 0.15, "fallback ratio ps", 0., 0.,
+			0, 0);
+	std::cerr << "fallback ratios: pT " << cl::fallback_ratio_pT()
+		<< ", ph " << cl::fallback_ratio_ph()
+		<< ", ps " << cl::fallback_ratio_ps() << std::endl;
+
+	return finish();
+}
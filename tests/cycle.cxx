@@ -0,0 +1,241 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o_backward"
+#include "h2o_cycle"
+#include "tests.hxx"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using h2o::H2O;
+using h2o::cycle::Cycle;
+
+static bool close(double a, double b, double tolerance)
+{
+	return std::fabs(a - b) <= tolerance * std::fabs(b);
+}
+
+// solve @c, expecting it to fail with the runtime_error @message
+static bool fails_with(Cycle& c, const char* message,
+		int max_iterations = 200)
+{
+	try
+	{
+		c.solve(1E-10, max_iterations);
+	}
+	catch (std::runtime_error& e)
+	{
+		return e.what() == std::string(message);
+	}
+
+	return false;
+}
+
+static void check_balance(const Cycle& c, const char* name)
+{
+	check(close(c.heat_input() - c.heat_rejected(), c.net_work(), 1E-8),
+			"energy balance", name);
+	check(close(c.efficiency(), c.net_work() / c.heat_input(), 1E-15),
+			"efficiency", name);
+}
+
+// a simple cycle: boiler, turbine, condenser and pump
+static void test_simple(double eta_t, double eta_p)
+{
+	const char* name = eta_t == 1. ? "ideal cycle" : "simple cycle";
+	Cycle c(4);
+
+	c.heater(3, 0, 10., 773.15);
+	c.turbine(0, 1, 0.01, eta_t);
+	c.condenser(1, 2);
+	c.pump(2, 3, 10., eta_p);
+	c.solve();
+
+	// by hand
+	H2O st0 = H2O::pT(10., 773.15);
+	H2O st1 = h2o::backward::expand(st0, 0.01, eta_t, h2o::backward::EXACT);
+	H2O st2 = H2O::px(0.01, 0.);
+	H2O st3s = h2o::backward::ps(10., st2.s(), h2o::backward::EXACT);
+	double h3 = st2.h() + (st3s.h() - st2.h()) / eta_p;
+
+	double wt = st0.h() - st1.h();
+	double wp = h3 - st2.h();
+	double q = st0.h() - h3;
+
+	check(close(c.state(1).h(), st1.h(), 1E-9), "turbine outlet", name);
+	check(close(c.state(3).h(), h3, 1E-9), "pump outlet", name);
+	check(close(c.turbine_work(), wt, 1E-9), "turbine work", name);
+	check(close(c.pump_work(), wp, 1E-8), "pump work", name);
+	check(close(c.efficiency(), (wt - wp) / q, 1E-9), "efficiency", name);
+	for (size_t i = 0; i < c.nodes(); ++i)
+		check(c.flow(i) == 1., "flow", name);
+	check_balance(c, name);
+
+	// no changes, so it should converge immediately
+	check(c.solve() == 1, "re-solve", name);
+}
+
+// a reheat cycle with an open feedwater heater
+static Cycle reheat_cycle(double T)
+{
+	Cycle c(11);
+
+	c.heater(10, 0, 16., T);
+	c.turbine(0, 1, 4., 0.88);
+	c.heater(1, 2, 4., T);
+	c.turbine(2, 3, 0.5, 0.88);
+	c.splitter(3, 4, 5);
+	c.turbine(4, 6, 0.01, 0.88);
+	c.condenser(6, 7);
+	c.pump(7, 8, 0.5, 0.8);
+	c.open_heater(8, 5, 9);
+	c.pump(9, 10, 16., 0.8);
+
+	return c;
+}
+
+static void test_reheat()
+{
+	const char* name = "reheat cycle";
+	Cycle c = reheat_cycle(823.15);
+
+	c.solve();
+
+	double h[11];
+	for (size_t i = 0; i < 11; ++i)
+		h[i] = c.state(i).h();
+
+	double y = (h[9] - h[8]) / (h[5] - h[8]);
+	double w = (h[0] - h[1]) + (h[2] - h[3]) + (1. - y) * (h[3] - h[6])
+		- (1. - y) * (h[8] - h[7]) - (h[10] - h[9]);
+	double q = (h[0] - h[10]) + (h[2] - h[1]);
+
+	check(close(c.flow(5), y, 1E-9), "bleed flow", name);
+	check(close(c.flow(7), 1. - y, 1E-9), "condensate flow", name);
+	check(close(c.flow(10), 1., 1E-9), "feedwater flow", name);
+	check(close(c.state(9).p(), 0.5, 1E-12) && c.state(9).x() == 0.,
+			"deaerator outlet", name);
+	check(close(c.net_work(), w, 1E-8), "net work", name);
+	check(close(c.heat_input(), q, 1E-9), "heat input", name);
+	check_balance(c, name);
+
+	// the warm-started solution of a changed design has to match
+	// a solution from scratch
+	Cycle fresh = reheat_cycle(843.15);
+	fresh.solve();
+
+	double eta = c.efficiency();
+
+	c.component(0).T = c.component(2).T = 843.15;
+	c.solve();
+	check(c.iterations() <= fresh.iterations(), "warm iterations", name);
+	check(close(c.efficiency(), fresh.efficiency(), 1E-9),
+			"warm solution", name);
+	check(c.efficiency() > eta, "higher temperature", name);
+}
+
+// a regenerative cycle with two closed feedwater heaters, cascading
+// the drains back to the condenser
+static void build_regenerative(Cycle& c, double lp_dT)
+{
+	c.heater(13, 0, 16., 823.15);
+	c.turbine(0, 1, 2., 0.9);
+	c.splitter(1, 2, 3);
+	c.turbine(2, 4, 0.3, 0.9);
+	c.splitter(4, 5, 6);
+	c.turbine(5, 7, 0.01, 0.9);
+	c.mixer(7, 16, 8);
+	c.condenser(8, 9);
+	c.pump(9, 10, 16., 0.8);
+	c.closed_heater(10, 11, 6, 12, lp_dT, 15);
+	c.closed_heater(11, 13, 3, 14, 3.);
+	c.valve(14, 15, 0.3);
+	c.valve(12, 16, 0.01);
+}
+
+static void test_regenerative()
+{
+	const char* name = "regenerative cycle";
+	Cycle c(17);
+
+	build_regenerative(c, 3.);
+	c.solve();
+
+	check(close(c.flow(13), 1., 1E-9), "boiler flow", name);
+	check(close(c.flow(9), 1., 1E-9), "condensate flow", name);
+	check(close(c.flow(14), c.flow(3), 1E-9), "HP drain flow", name);
+	check(close(c.flow(12), c.flow(3) + c.flow(6), 1E-9),
+			"LP drain flow", name);
+	check(close(c.flow(7) + c.flow(16), 1., 1E-9), "condenser flow", name);
+	check(close(c.state(13).T(), c.state(14).T() - 3., 1E-12),
+			"terminal temperature difference", name);
+	check(close(c.state(13).p(), 16., 1E-12), "feedwater pressure", name);
+
+	// the heat balance of the HP heater
+	double feed = c.flow(11) * (c.state(13).h() - c.state(11).h());
+	double steam = c.flow(3) * (c.state(3).h() - c.state(14).h());
+	check(close(feed, steam, 1E-9), "heater balance", name);
+	check_balance(c, name);
+
+	// regeneration improves the efficiency over the simple cycle
+	Cycle simple(4);
+	simple.heater(3, 0, 16., 823.15);
+	simple.turbine(0, 1, 0.01, 0.9);
+	simple.condenser(1, 2);
+	simple.pump(2, 3, 16., 0.8);
+	simple.solve();
+	check(c.efficiency() > simple.efficiency(), "regeneration", name);
+
+	// scaling the flow
+	double w = c.net_work();
+
+	c.set_flow(0, 150.);
+	c.solve();
+	check(close(c.flow(9), 150., 1E-9), "scaled flow", name);
+	check(close(c.net_work(), 150. * w, 1E-9), "scaled work", name);
+	check_balance(c, name);
+
+	// the LP heater can not heat the feedwater above the steam
+	// saturation temperature
+	Cycle bad(17);
+
+	build_regenerative(bad, 100.);
+	check(fails_with(bad, "Infeasible cycle: negative mass flow"),
+			"negative flow", name);
+}
+
+static void test_errors()
+{
+	const char* name = "incomplete cycle";
+
+	Cycle c(4);
+	c.heater(3, 0, 10., 773.15);
+	c.turbine(0, 1, 0.01);
+	c.condenser(1, 2);
+	check(fails_with(c, "Cycle node without a source"),
+			"node without source", name);
+
+	c.pump(2, 3, 10.);
+	check(fails_with(c, "Cycle did not converge", 1),
+			"iteration limit", name);
+	check(c.solve() > 0, "convergence after limit", name);
+}
+
+int main(void)
+{
+	test_simple(1., 1.);
+	test_simple(0.85, 0.75);
+	test_reheat();
+	test_regenerative();
+	test_errors();
+
+	return finish();
+}
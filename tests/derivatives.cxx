@@ -0,0 +1,164 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o"
+#include "h2o_backward"
+#include "tests.hxx"
+
+#include <cmath>
+
+typedef h2o::H2O (*constructor_func_t)(double, double);
+typedef double (h2o::H2O::*getter_func_t)() const;
+
+// the constructors which are exact with respect to the basic equations
+static h2o::H2O ph(double p, double h)
+{
+	return h2o::backward::ph(p, h, h2o::backward::EXACT);
+}
+
+static h2o::H2O ps(double p, double s)
+{
+	return h2o::backward::ps(p, s, h2o::backward::EXACT);
+}
+
+static h2o::H2O pT(double p, double T)
+{
+	return h2o::backward::pT(p, T, h2o::backward::EXACT);
+}
+
+static h2o::H2O hs(double h, double s)
+{
+	return h2o::backward::hs(h, s, h2o::backward::EXACT);
+}
+
+// compare the analytic derivative (dx/dy)_z at constr(a, b) with
+// a central difference; y is a if @first is true, b otherwise
+static void check_derivative(const char* what, constructor_func_t constr,
+		double a, double b, bool first, getter_func_t getter,
+		h2o::property::type x, h2o::property::type y,
+		h2o::property::type z, double tolerance = 1E-6)
+{
+	h2o::H2O st = constr(a, b);
+	double expected;
+
+	if (first)
+	{
+		double d = std::fabs(a) * 1E-5;
+
+		expected = ((constr(a + d, b).*getter)()
+				- (constr(a - d, b).*getter)()) / (2. * d);
+	}
+	else
+	{
+		double d = std::fabs(b) * 1E-5;
+
+		expected = ((constr(a, b + d).*getter)()
+				- (constr(a, b - d).*getter)()) / (2. * d);
+	}
+
+	double got = st.derivative(x, y, z);
+
+	check(std::fabs(got - expected) <= tolerance * std::fabs(expected),
+			what, a, b, expected, got);
+}
+
+int main(void)
+{
+	using h2o::H2O;
+	namespace property = h2o::property;
+
+	// region 1
+	check_derivative("R1 (dh/dp)_T", pT, 3., 300., true, &H2O::h,
+			property::h, property::p, property::T);
+	check_derivative("R1 (du/dT)_p", pT, 3., 300., false, &H2O::u,
+			property::u, property::T, property::p);
+	check_derivative("R1 (drho/dh)_p", ph, 3., 500., false, &H2O::rho,
+			property::rho, property::h, property::p);
+	check_derivative("R1 (dT/ds)_p", ps, 80., 3., false, &H2O::T,
+			property::T, property::s, property::p);
+	check_derivative("R1 (ds/dp)_h", ph, 80., 500., true, &H2O::s,
+			property::s, property::p, property::h);
+	check_derivative("R1 (dp/dh)_s", hs, 1500., 3.4, true, &H2O::p,
+			property::p, property::h, property::s);
+
+	// region 2
+	check_derivative("R2 (dv/dp)_T", pT, 0.1, 500., true, &H2O::v,
+			property::v, property::p, property::T);
+	check_derivative("R2 (dh/dT)_p", pT, 0.1, 500., false, &H2O::h,
+			property::h, property::T, property::p);
+	check_derivative("R2 (dT/dp)_h", ph, 5., 3500., true, &H2O::T,
+			property::T, property::p, property::h);
+	check_derivative("R2 (drho/ds)_p", ps, 8., 7.5, false, &H2O::rho,
+			property::rho, property::s, property::p);
+	check_derivative("R2 (du/dp)_s", ps, 8., 7.5, true, &H2O::u,
+			property::u, property::p, property::s);
+	check_derivative("R2 (dT/ds)_h", hs, 2800., 6.5, false, &H2O::T,
+			property::T, property::s, property::h);
+
+	// region 3
+	check_derivative("R3 (dp/dT)_rho", H2O::rhoT, 500., 650., false,
+			&H2O::p, property::p, property::T, property::rho);
+	check_derivative("R3 (dh/drho)_T", H2O::rhoT, 500., 650., true,
+			&H2O::h, property::h, property::rho, property::T);
+	check_derivative("R3 (dv/dp)_T", pT, 30., 700., true, &H2O::v,
+			property::v, property::p, property::T);
+	check_derivative("R3 (dT/dh)_p", ph, 25., 1800., false, &H2O::T,
+			property::T, property::h, property::p);
+
+	// region 4
+	double p400 = H2O::Tx(400., 0.5).p();
+	double h400 = H2O::Tx(400., 0.5).h();
+	double s400 = H2O::Tx(400., 0.5).s();
+
+	check_derivative("R4 (dT/dp)_h", ph, p400, h400, true, &H2O::T,
+			property::T, property::p, property::h);
+	check_derivative("R4 (drho/dh)_p", ph, p400, h400, false, &H2O::rho,
+			property::rho, property::h, property::p);
+	check_derivative("R4 (dh/dp)_s", ps, p400, s400, true, &H2O::h,
+			property::h, property::p, property::s);
+	check_derivative("R4 (dv/ds)_p", ps, p400, s400, false, &H2O::v,
+			property::v, property::s, property::p);
+	check_derivative("R4 (dT/ds)_h", hs, 2400., 6., false, &H2O::T,
+			property::T, property::s, property::h);
+
+	// saturated states in region 3
+	double p630 = H2O::Tx(630., 0.3).p();
+	double h630 = H2O::Tx(630., 0.3).h();
+
+	check_derivative("R4 (dT/dp)_h, 630 K", ph, p630, h630, true, &H2O::T,
+			property::T, property::p, property::h);
+	check_derivative("R4 (drho/dh)_p, 630 K", ph, p630, h630, false,
+			&H2O::rho, property::rho, property::h, property::p);
+
+	// the isobars are isotherms in region 4
+	double dTdh = H2O::Tx(400., 0.5).derivative(property::T,
+			property::h, property::p);
+	check(std::fabs(dTdh) < 1E-12, "R4 (dT/dh)_p", 400., 0.5, 0., dTdh);
+
+	// ...so the derivatives at constant p or T along p or T are undefined
+	double dhdp = H2O::Tx(400., 0.5).derivative(property::h,
+			property::p, property::T);
+	check(std::isnan(dhdp), "R4 (dh/dp)_T", 400., 0.5, 0., dhdp);
+
+	// region 5
+	check_derivative("R5 (dh/dp)_T", pT, 10., 1500., true, &H2O::h,
+			property::h, property::p, property::T);
+	check_derivative("R5 (drho/dT)_p", pT, 10., 1500., false, &H2O::rho,
+			property::rho, property::T, property::p);
+	check_derivative("R5 (dT/dh)_p", ph, 10., 5000., false, &H2O::T,
+			property::T, property::h, property::p);
+
+	// reciprocity: (dx/dy)_z (dy/dx)_z = 1
+	H2O st = H2O::pT(5., 600.);
+	double r = st.derivative(property::s, property::v, property::h)
+		* st.derivative(property::v, property::s, property::h);
+	check(std::fabs(r - 1.) < 1E-12, "reciprocity", 5., 600., 1., r);
+
+	return finish();
+}
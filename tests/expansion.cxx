@@ -0,0 +1,117 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o_backward"
+#include "h2o_expansion"
+#include "tests.hxx"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+static bool close(double a, double b, double tolerance)
+{
+	return std::fabs(a - b) <= tolerance * std::fabs(b);
+}
+
+int main(void)
+{
+	// a 20-stage turbine, ending with wet steam
+	h2o::H2O in = h2o::H2O::pT(16., 810.);
+	std::vector<double> pout;
+
+	for (int i = 1; i <= 20; ++i)
+		pout.push_back(16. * std::pow(0.005 / 16., i / 20.));
+
+	h2o::ExpansionLine line;
+
+	// isentropic
+	line.expand(in, pout);
+	check(line.size() == pout.size() + 1, "size", 0);
+	check(line.data() == &line.inlet(), "data", 0);
+	check(&line[pout.size()] == &line.outlet(), "outlet", 0);
+	check(line.outlet().region() == h2o::Region::R4, "wet outlet", 20);
+	for (size_t i = 1; i < line.size(); ++i)
+	{
+		check(close(line[i].p(), pout[i - 1], 1E-12), "isentropic p", i);
+		check(close(line[i].s(), in.s(), 1E-9), "isentropic s", i);
+	}
+
+	// stage by stage, the results have to match cold-started
+	// expansions
+	line.expand(in, pout, 0.85);
+	for (size_t i = 1; i < line.size(); ++i)
+	{
+		h2o::H2O ref = h2o::backward::expand(line[i - 1], pout[i - 1],
+				0.85, h2o::backward::EXACT);
+
+		check(line[i].region() == ref.region(), "region", i);
+		check(close(line[i].h(), ref.h(), 1E-9), "h", i);
+		check(close(line[i].T(), ref.T(), 1E-9), "T", i);
+	}
+
+	// and with H2O::expand(), within the backward equation tolerance
+	{
+		h2o::H2O st = in;
+
+		for (size_t i = 0; i < pout.size(); ++i)
+			st = st.expand(pout[i], 0.85);
+		check(close(line.outlet().h(), st.h(), 1E-3), "H2O::expand()", 20);
+	}
+
+	// per-stage efficiencies
+	{
+		std::vector<double> eta(pout.size(), 0.85);
+		h2o::ExpansionLine line2;
+
+		eta[0] = 0.75;
+		line2.expand(in, pout, eta);
+		check(line2.outlet().h() > line.outlet().h(), "per-stage eta", 20);
+
+		eta[0] = 0.85;
+		line2.expand(in, pout, eta);
+		for (size_t i = 1; i < line.size(); ++i)
+			check(line2[i].h() == line[i].h(), "per-stage eta", i);
+	}
+
+	// polytropic expansion: isentropic with eta = 1, and the limit
+	// of many small stages otherwise; note that in region 4, dh = v dp
+	// holds only as far as the IF97 saturation pressure equation
+	// agrees with the Clausius-Clapeyron equation
+	{
+		line.expand_polytropic(in, pout, 1.);
+		for (size_t i = 1; i < line.size(); ++i)
+			check(close(line[i].s(), in.s(), 1E-6), "polytropic s", i);
+
+		std::vector<double> fine;
+		for (int i = 1; i <= 2000; ++i)
+			fine.push_back(16. * std::pow(0.005 / 16., i / 2000.));
+
+		h2o::ExpansionLine small;
+		small.expand(in, fine, 0.85);
+		line.expand_polytropic(in, pout, 0.85);
+
+		double dh = in.h() - line.outlet().h();
+		double dh_small = in.h() - small.outlet().h();
+		check(close(dh, dh_small, 1E-4), "polytropic", 20);
+	}
+
+	bool thrown = false;
+	try
+	{
+		line.expand(h2o::H2O::pT(10., 1500.), pout);
+	}
+	catch (std::range_error& e)
+	{
+		thrown = true;
+	}
+	check(thrown, "region 5", 0);
+
+	return finish();
+}
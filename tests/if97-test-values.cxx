@@ -100,7 +100,7 @@ public:
 	int finish()
 	{
 		if (failed == 0)
-			std::cerr << done << " tests done. All tests suceeded."
+			std::cerr << done << " tests done. All tests succeeded."
 				<< std::endl;
 		else
 			std::cerr << failed << " of " << done
@@ -197,6 +197,42 @@ public:
 		check_any(constr, arg1, arg2, &h2o::H2O::v, v_expected, v_precision);
 	}
 
+	void check_properties(obj_constr constr, double arg1, double arg2)
+	{
+		h2o::H2O st = constr(arg1, arg2);
+		h2o::PropertySet ps = st.properties();
+		const char* name1 = name1_by_constr(constr);
+		const char* name2 = name2_by_constr(constr);
+
+		// fused evaluation must agree with the getters
+		check(ps.p, st.p(), 1E-9 * st.p(), "properties.p",
+				name1, arg1, name2, arg2);
+		check(ps.T, st.T(), 1E-9 * st.T(), "properties.T",
+				name1, arg1, name2, arg2);
+		if (st.region() != h2o::Region::R3)
+			check(ps.x, st.x(), 1E-9, "properties.x",
+					name1, arg1, name2, arg2);
+		check(ps.rho, st.rho(), 1E-9 * st.rho(), "properties.rho",
+				name1, arg1, name2, arg2);
+		check(ps.v, st.v(), 1E-9 * st.v(), "properties.v",
+				name1, arg1, name2, arg2);
+		check(ps.u, st.u(), 1E-9 * std::fabs(st.u()), "properties.u",
+				name1, arg1, name2, arg2);
+		check(ps.h, st.h(), 1E-9 * std::fabs(st.h()), "properties.h",
+				name1, arg1, name2, arg2);
+		check(ps.s, st.s(), 1E-9 * std::fabs(st.s()), "properties.s",
+				name1, arg1, name2, arg2);
+		if (st.region() != h2o::Region::R4)
+		{
+			check(ps.cp, st.cp(), 1E-9 * st.cp(), "properties.cp",
+					name1, arg1, name2, arg2);
+			check(ps.cv, st.cv(), 1E-9 * st.cv(), "properties.cv",
+					name1, arg1, name2, arg2);
+			check(ps.w, st.w(), 1E-9 * st.w(), "properties.w",
+					name1, arg1, name2, arg2);
+		}
+	}
+
 	void check_expand(double pin, double pout,
 			double s, double s_precision,
 			double T_expected, double T_precision)
@@ -558,6 +594,15 @@ int main(void)
 	t.check_any(h2o::H2O::pT, 22.064, 647.15, &h2o::H2O::v,
 			0.3701940010E-2, 1E-12);
 
+	// test .properties()
+	t.check_properties(h2o::H2O::pT, 3., 300.);
+	t.check_properties(h2o::H2O::pT, 0.0035, 700.);
+	t.check_properties(h2o::H2O::pT, 30., 700.);
+	t.check_properties(h2o::H2O::rhoT, 500., 650.);
+	t.check_properties(h2o::H2O::Tx, 400., 0.5);
+	t.check_properties(h2o::H2O::Tx, 630., 0.3);
+	t.check_properties(h2o::H2O::pT, 0.5, 1500.);
+
 	// test .expand()
 	t.check_expand(2.5, 0.1, 8.00, 1E-5, 0.514127081E3, 1E-2);
 	t.check_expand(8.0, 0.1, 7.50, 1E-4, 0.399517097E3, 1E-3);
@@ -0,0 +1,89 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+// built with -DH2OXX_INLINE
+#include "h2o"
+#include "tests.hxx"
+
+#include <stdexcept>
+
+#include <cmath>
+
+static bool close(double a, double b)
+{
+	return std::fabs(a - b) <= 1E-9 * std::fabs(b);
+}
+
+// compare the inlined getters with the (out-of-line) properties()
+static void check_state(const char* what, const h2o::H2O& st)
+{
+	h2o::PropertySet ps = st.properties();
+
+	check(st.initialized(), what, ps.p, ps.T);
+	check(close(st.p(), ps.p) && close(st.T(), ps.T), what, ps.p, ps.T);
+	check(close(st.v(), ps.v) && close(st.rho(), ps.rho), what, ps.p, ps.T);
+	check(close(st.u(), ps.u) && close(st.h(), ps.h)
+			&& close(st.s(), ps.s), what, ps.p, ps.T);
+	if (st.region() != h2o::Region::R3)
+		check(st.x() == ps.x, what, ps.p, ps.T);
+}
+
+int main(void)
+{
+	using h2o::H2O;
+	using h2o::Region;
+
+	H2O r1 = H2O::pT(3., 300.);
+	H2O r2(0.1, 500.);
+	H2O r3 = H2O::rhoT(500., 650.);
+	H2O r4 = H2O::Tx(400., 0.5);
+	H2O r5 = H2O::pT(10., 1500.);
+
+	check(r1.region() == Region::R1, "R1 region", 3., 300.);
+	check(r2.region() == Region::R2, "R2 region", 0.1, 500.);
+	check(r3.region() == Region::R3, "R3 region", 500., 650.);
+	check(r4.region() == Region::R4, "R4 region", 400., 0.5);
+	check(r5.region() == Region::R5, "R5 region", 10., 1500.);
+
+	check_state("R1", r1);
+	check_state("R2", r2);
+	check_state("R3", r3);
+	check_state("R4", r4);
+	check_state("R5", r5);
+
+	check_state("R1 (ph)", H2O::ph(3., r1.h()));
+	check_state("R2 (ps)", H2O::ps(0.1, r2.s()));
+	check_state("R2 (hs)", H2O::hs(r2.h(), r2.s()));
+	check_state("R4 (px)", H2O::px(r4.p(), 0.3));
+
+	// the libh2o region enumeration
+	check(Region(h2o::internals::H2O_REGION3) == Region::R3,
+			"h2o_region conversion");
+	check(Region() == Region::OOR, "default region");
+
+	// out-of-range
+	bool thrown = false;
+	try
+	{
+		H2O::pT(200., 300.);
+	}
+	catch (std::range_error& e)
+	{
+		thrown = true;
+	}
+	check(thrown, "pT() out-of-range", 200., 300.);
+
+	H2O oor = H2O::try_ph(200., 3000.);
+	check(!oor.initialized() && oor.region() == Region::OOR,
+			"try_ph() out-of-range", 200., 3000.);
+	check(H2O::try_pT(3., 300.).initialized(), "try_pT()", 3., 300.);
+	check(!H2O().initialized(), "H2O()");
+
+	return finish();
+}
@@ -0,0 +1,133 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o"
+#include "h2o_backward"
+#include "h2o_instrumentation"
+#include "tests.hxx"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+static void check_count(const char* what, uint64_t expected,
+		uint64_t got)
+{
+	check(got == expected, what, expected, got);
+}
+
+static void workload()
+{
+	using h2o::H2O;
+
+	H2O st = H2O::pT(3., 300.);
+	H2O::pT(0.0035, 700.);
+	H2O::pT(30., 1500.);
+	H2O::try_pT(-1., 300.);
+
+	try
+	{
+		H2O::ph(-1., 100.);
+	}
+	catch (std::range_error& e)
+	{
+	}
+
+	st.h();
+	st.h();
+	st.properties();
+	H2O::Tx(400., 0.5).x();
+	st.expand(1., 0.8);
+}
+
+int main(void)
+{
+	using h2o::Region;
+	namespace inst = h2o::instrumentation;
+
+	inst::reset();
+	workload();
+
+	inst::Snapshot s = inst::snapshot();
+
+	if (!inst::enabled())
+	{
+		// the hooks are compiled out, and the counters are zero
+		for (size_t i = 0; i < inst::OPERATION_MAX; ++i)
+			check_count(inst::name(static_cast<inst::operation_type>(i)),
+					0, s.operations[i].total());
+		check_count("solves", 0, s.solves);
+	}
+	else
+	{
+		const inst::Counters& pT = s.operations[inst::CONSTRUCT_PT];
+
+		check_count("pT total", 4, pT.total());
+		check_count("pT R1", 1, pT.calls[Region::R1]);
+		check_count("pT R2", 1, pT.calls[Region::R2]);
+		check_count("pT R5", 1, pT.calls[Region::R5]);
+		check_count("pT OOR", 1, pT.calls[Region::OOR]);
+		check(pT.out_of_range_rate() == 0.25, "pT OOR rate", 0.25,
+				pT.out_of_range_rate());
+
+		uint64_t histogram = 0;
+		for (size_t i = 0; i < inst::latency_buckets; ++i)
+			histogram += pT.latency[i];
+		check_count("pT latency histogram", 4, histogram);
+
+		// the exception is recorded as out-of-range
+		const inst::Counters& ph = s.operations[inst::CONSTRUCT_PH];
+		check_count("ph OOR", 1, ph.calls[Region::OOR]);
+
+		// getters are counted in the region of the state point
+		// (two calls above, and two inside expand())
+		check_count("h R1", 4, s.operations[inst::GET_H].calls[Region::R1]);
+		check_count("properties R1", 1,
+				s.operations[inst::GET_PROPERTIES].calls[Region::R1]);
+		check_count("x R4", 1, s.operations[inst::GET_X].calls[Region::R4]);
+		check_count("Tx R4", 1,
+				s.operations[inst::CONSTRUCT_TX].calls[Region::R4]);
+
+		// expand() is counted once, and the nested calls separately
+		check_count("expand", 1, s.operations[inst::EXPAND].total());
+		check_count("expand ps", 1, s.operations[inst::CONSTRUCT_PS].total());
+		check_count("expand ph", 2, ph.total());
+
+		// backward equations
+		h2o::backward::ph(3., 115., h2o::backward::EXACT);
+		h2o::backward::ph(3., 115., h2o::backward::FAST);
+		s = inst::snapshot();
+		check_count("solves", 2, s.solves);
+		check_count("zero iterations", 1, s.iteration_histogram[0]);
+		check(s.iterations > 0
+				&& s.iteration_histogram[s.iterations] == 1,
+				"iterations", 1, s.iteration_histogram[s.iterations]);
+
+		// counters of exited threads are kept
+		inst::reset();
+		std::thread t1(workload), t2(workload);
+		t1.join();
+		t2.join();
+		workload();
+		s = inst::snapshot();
+		check_count("threads pT", 12,
+				s.operations[inst::CONSTRUCT_PT].total());
+		check_count("threads h", 12, s.operations[inst::GET_H].total());
+
+		inst::reset();
+		s = inst::snapshot();
+		check_count("reset", 0, s.operations[inst::CONSTRUCT_PT].total());
+		check_count("reset solves", 0, s.solves);
+	}
+
+	check(std::string(inst::name(inst::CONSTRUCT_PH)) == "H2O::ph",
+			"name", 0, 0);
+
+	return finish();
+}
@@ -0,0 +1,156 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o_parallel"
+#include "tests.hxx"
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// bitwise comparison, NaN included
+static bool identical(const std::vector<double>& a,
+		const std::vector<double>& b)
+{
+	return a.size() == b.size()
+		&& (a.empty() || std::memcmp(&a[0], &b[0],
+					a.size() * sizeof(double)) == 0);
+}
+
+static void check_identical(const h2o::H2OArray& a,
+		const h2o::H2OArray& b, size_t threads)
+{
+	check(a.region == b.region, "region", threads);
+	check(identical(a.p, b.p), "p", threads);
+	check(identical(a.T, b.T), "T", threads);
+	check(identical(a.x, b.x), "x", threads);
+	check(identical(a.rho, b.rho), "rho", threads);
+	check(identical(a.v, b.v), "v", threads);
+	check(identical(a.u, b.u), "u", threads);
+	check(identical(a.h, b.h), "h", threads);
+	check(identical(a.s, b.s), "s", threads);
+	check(identical(a.cp, b.cp), "cp", threads);
+	check(identical(a.cv, b.cv), "cv", threads);
+	check(identical(a.w, b.w), "w", threads);
+}
+
+int main(void)
+{
+	// a (h, s) grid covering all the regions, with a number
+	// of out-of-range points
+	std::vector<double> h, s;
+	for (int i = 0; i < 20; ++i)
+	{
+		for (int j = 0; j < 20; ++j)
+		{
+			h.push_back(100. + 200. * i);
+			s.push_back(0.2 + 0.45 * j);
+		}
+	}
+
+	h2o::H2OArray ref;
+	size_t ref_oor = h2o::batch::hs(h, s, ref);
+	check(ref_oor > 0 && ref_oor < h.size(), "grid oor count", 0);
+
+	// the results must not depend on the number of threads
+	size_t threads[] = { 1, 2, 3, 8 };
+	for (int i = 0; i < 4; ++i)
+	{
+		h2o::parallel::ThreadPool pool(threads[i]);
+		h2o::H2OArray arr;
+
+		check(pool.size() == threads[i], "pool size", threads[i]);
+		check(h2o::parallel::hs(h, s, arr, h2o::H2OArray::COL_ALL, pool)
+				== ref_oor, "hs oor count", threads[i]);
+		check_identical(arr, ref, threads[i]);
+	}
+
+	// the default pool, and a subset of columns
+	{
+		h2o::H2OArray arr;
+		unsigned columns = h2o::H2OArray::COL_T | h2o::H2OArray::COL_RHO;
+
+		h2o::batch::hs(h, s, ref, columns);
+		check(h2o::parallel::hs(h, s, arr, columns) == ref_oor,
+				"default pool oor count", 0);
+		check_identical(arr, ref, 0);
+	}
+
+	// other constructors, with a repeated scalar argument
+	{
+		h2o::parallel::ThreadPool pool(4);
+		h2o::H2OArray arr;
+		double p10 = 10.;
+		h2o::batch::View p(p10, h.size());
+
+		h2o::batch::ph(p, h, ref);
+		h2o::parallel::ph(p, h, arr, h2o::H2OArray::COL_ALL, pool);
+		check_identical(arr, ref, 4);
+
+		h2o::batch::ps(p, s, ref);
+		h2o::parallel::ps(p, s, arr, h2o::H2OArray::COL_ALL, pool);
+		check_identical(arr, ref, 4);
+
+		// properties of the resulting states
+		std::vector<h2o::H2O> states;
+		std::vector<h2o::PropertySet> props;
+		for (size_t i = 0; i < ref.size(); ++i)
+		{
+			if (ref.region[i] != h2o::Region::OOR)
+				states.push_back(ref.at(i));
+		}
+
+		h2o::parallel::properties(states, props, pool);
+		check(props.size() == states.size(), "properties size", 0);
+		for (size_t i = 0; i < states.size(); ++i)
+			check(props[i].h == states[i].properties().h,
+					"properties h", i);
+	}
+
+	// every index is visited exactly once, and exceptions are passed
+	// to the caller
+	{
+		h2o::parallel::ThreadPool pool(4);
+		std::vector<std::atomic<int> > visits(10007);
+
+		for (size_t i = 0; i < visits.size(); ++i)
+			visits[i] = 0;
+
+		pool.for_each(visits.size(), 13,
+			[&visits](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+					++visits[i];
+			});
+
+		bool once = true;
+		for (size_t i = 0; i < visits.size(); ++i)
+			once = once && visits[i] == 1;
+		check(once, "visited once", 0);
+
+		bool thrown = false;
+		try
+		{
+			pool.for_each(100, 1, [](size_t begin, size_t)
+				{
+					if (begin == 42)
+						throw std::range_error("test");
+				});
+		}
+		catch (std::range_error& e)
+		{
+			thrown = true;
+		}
+		check(thrown, "exception rethrown", 0);
+	}
+
+	return finish();
+}
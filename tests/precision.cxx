@@ -0,0 +1,222 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o"
+#include "h2o_batch"
+#include "h2o_precision"
+#include "tests.hxx"
+
+#include <stdexcept>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// relative error, absolute below 1 for u, h and s
+static double error(double got, double expected, bool energy)
+{
+	double scale = std::fabs(expected);
+
+	if (energy)
+		scale = std::max(scale, 1.);
+	return std::fabs(got - expected) / scale;
+}
+
+// compare @st in precision @Real against the double evaluation,
+// using the published accuracy
+template <class Real>
+static void check_accuracy(const char* what, const h2o::H2O& st)
+{
+	typedef typename h2o::BasicH2O<Real>::Accuracy Accuracy;
+
+	h2o::BasicPropertySet<double> ref
+		= h2o::BasicH2O<double>(st).properties();
+	h2o::BasicPropertySet<Real> got = h2o::BasicH2O<Real>(st).properties();
+	Accuracy acc = h2o::BasicH2O<Real>::accuracy(st.region());
+
+	double p = ref.p, T = ref.T;
+
+	check(error(got.rho, ref.rho, false) <= acc.rho, what, p, T);
+	check(error(got.v, ref.v, false) <= acc.v, what, p, T);
+	check(error(got.u, ref.u, true) <= acc.u, what, p, T);
+	check(error(got.h, ref.h, true) <= acc.h, what, p, T);
+	check(error(got.s, ref.s, true) <= acc.s, what, p, T);
+	if (st.region() != h2o::Region::R4)
+	{
+		check(error(got.cp, ref.cp, false) <= acc.cp, what, p, T);
+		check(error(got.cv, ref.cv, false) <= acc.cv, what, p, T);
+		check(error(got.w, ref.w, false) <= acc.w, what, p, T);
+	}
+}
+
+static bool close(double a, double b)
+{
+	return std::fabs(a - b) <= 1E-9 * std::fabs(b);
+}
+
+// BasicH2O<double> has to agree with H2O
+static void check_double(const char* what, const h2o::H2O& st)
+{
+	h2o::PropertySet ref = st.properties();
+	h2o::BasicH2O<double> dst(st);
+
+	check(dst.region() == st.region(), what, ref.p, ref.T);
+	check(close(dst.p(), ref.p) && close(dst.T(), ref.T), what,
+			ref.p, ref.T);
+	check(close(dst.rho(), ref.rho) && close(dst.v(), ref.v), what,
+			ref.p, ref.T);
+	check(close(dst.u(), ref.u) && close(dst.h(), ref.h)
+			&& close(dst.s(), ref.s), what, ref.p, ref.T);
+	if (st.region() != h2o::Region::R4)
+		check(close(dst.cp(), ref.cp) && close(dst.cv(), ref.cv)
+				&& close(dst.w(), ref.w), what, ref.p, ref.T);
+}
+
+static void check_state(const char* what, const h2o::H2O& st)
+{
+	check_double(what, st);
+	check_accuracy<float>(what, st);
+	check_accuracy<long double>(what, st);
+}
+
+template <class Real>
+static bool same(Real a, Real b)
+{
+	return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+template <class Real>
+static bool same(const h2o::BasicPropertySet<Real>& a,
+		const h2o::BasicPropertySet<Real>& b)
+{
+	return same(a.p, b.p) && same(a.T, b.T) && same(a.x, b.x)
+		&& same(a.rho, b.rho) && same(a.v, b.v) && same(a.u, b.u)
+		&& same(a.h, b.h) && same(a.s, b.s) && same(a.cp, b.cp)
+		&& same(a.cv, b.cv) && same(a.w, b.w);
+}
+
+// the bulk evaluation has to give the same results as properties(),
+// with every instruction set
+template <class Real>
+static void check_bulk(const char* what)
+{
+	using h2o::batch::isa_type;
+
+	std::vector<Real> p, T;
+
+	// R1, R2, R3, R5, and one state point out-of-range
+	for (int i = 0; i < 150; ++i)
+	{
+		p.push_back(static_cast<Real>(0.01 + i * 0.33));
+		T.push_back(static_cast<Real>(i % 3 ? 300. + i * 4. : 1100.));
+	}
+	p.push_back(60);
+	T.push_back(680);
+	p.push_back(200);
+	T.push_back(300);
+
+	isa_type prev = h2o::batch::isa();
+	const isa_type isas[] = { h2o::batch::ISA_SCALAR,
+		h2o::batch::ISA_SSE2, h2o::batch::ISA_AVX2,
+		h2o::batch::ISA_AVX512 };
+
+	for (size_t k = 0; k < sizeof(isas) / sizeof(isas[0]); ++k)
+	{
+		if (!h2o::batch::set_isa(isas[k]))
+			continue;
+
+		std::vector<h2o::BasicPropertySet<Real> > out(p.size());
+		size_t oor = h2o::BasicH2O<Real>::pT(&p[0], &T[0], p.size(),
+				&out[0]);
+
+		check(oor == 1 && std::isnan(out.back().rho), what,
+				p.back(), T.back());
+
+		for (size_t i = 0; i + 1 < p.size(); ++i)
+		{
+			h2o::BasicPropertySet<Real> ref
+				= h2o::BasicH2O<Real>::pT(p[i], T[i]).properties();
+
+			check(same(out[i], ref), what, p[i], T[i]);
+		}
+	}
+
+	h2o::batch::set_isa(prev);
+}
+
+int main(void)
+{
+	using h2o::H2O;
+	using h2o::Region;
+
+	// a coarse grid over every region
+	for (double T = 280.; T <= 620.; T += 20.)
+		for (double p = 10.; p <= 100.; p += 10.)
+			if (H2O::pT(p, T).region() == Region::R1)
+				check_state("R1", H2O::pT(p, T));
+
+	for (double T = 300.; T <= 1070.; T += 50.)
+		for (double p = 0.001; p <= 100.; p *= 3.)
+		{
+			H2O st = H2O::try_pT(p, T);
+
+			if (st.initialized() && st.region() == Region::R2)
+				check_state("R2", st);
+		}
+
+	for (double T = 630.; T <= 860.; T += 10.)
+		for (double p = 20.; p <= 100.; p += 5.)
+		{
+			H2O st = H2O::pT(p, T);
+
+			if (st.region() == Region::R3)
+				check_state("R3", st);
+		}
+
+	for (double T = 280.; T <= 645.; T += 15.)
+		for (double x = 0.; x <= 1.; x += 0.25)
+			check_state("R4", H2O::Tx(T, x));
+
+	for (double T = 1100.; T <= 2270.; T += 100.)
+		for (double p = 0.01; p <= 50.; p *= 2.)
+			check_state("R5", H2O::pT(p, T));
+
+	// the named constructors
+	h2o::H2Of f = h2o::H2Of::pT(3.f, 300.f);
+	check(f.region() == Region::R1 && std::fabs(f.h() - H2O::pT(3., 300.).h())
+			< 0.01, "H2Of::pT()", 3., 300.);
+	check(h2o::H2Of::Tx(400.f, 0.5f).region() == Region::R4,
+			"H2Of::Tx()", 400., 0.5);
+	check(h2o::H2Ol::px(1.L, 0.5L).x() == 0.5L, "H2Ol::px()", 1., 0.5);
+	check(h2o::H2Of::rhoT(500.f, 650.f).region() == Region::R3,
+			"H2Of::rhoT()", 500., 650.);
+	check(!h2o::H2Of().initialized(), "H2Of()");
+
+	bool thrown = false;
+	try
+	{
+		h2o::H2Of::pT(200.f, 300.f);
+	}
+	catch (std::range_error& e)
+	{
+		thrown = true;
+	}
+	check(thrown, "H2Of::pT() out-of-range", 200., 300.);
+
+	// cp, cv and w are not available in region 4
+	check(std::isnan(h2o::H2Of::accuracy(Region::R4).cp)
+			&& std::isnan(h2o::H2Of::Tx(400.f, 0.5f).cp()),
+			"R4 cp", 400., 0.5);
+
+	check_bulk<float>("H2Of::pT() bulk");
+	check_bulk<double>("BasicH2O<double>::pT() bulk");
+	check_bulk<long double>("H2Ol::pT() bulk");
+
+	return finish();
+}
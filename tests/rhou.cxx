@@ -0,0 +1,127 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o"
+#include "h2o_backward"
+#include "tests.hxx"
+
+#include <stdexcept>
+
+#include <cmath>
+
+using h2o::H2O;
+using h2o::Region;
+
+static bool close(double a, double b, double tolerance)
+{
+	return std::fabs(a - b) <= tolerance * std::fabs(b);
+}
+
+// obtain the state point back from its (rho,u)
+static void check_roundtrip(const H2O& ref, const char* what)
+{
+	double rho = ref.rho(), u = ref.u();
+	H2O st = H2O::rhou(rho, u);
+
+	check(st.region() == ref.region(), what, rho, u);
+	check(close(st.rho(), rho, 1E-10) && close(st.u(), u, 1E-10)
+			&& close(st.T(), ref.T(), 1E-9), what, rho, u);
+	if (ref.region() == Region::R4)
+		check(close(st.x(), ref.x(), 1E-8), what, rho, u);
+}
+
+int main(void)
+{
+	static const double pTs[][2] =
+	{
+		{ 3., 300. },
+		{ 80., 300. },
+		{ 50., 600. },
+		{ 0.001, 300. },
+		{ 1., 500. },
+		{ 20., 700. },
+		{ 80., 1000. },
+		{ 25., 650. },
+		{ 40., 750. },
+		{ 0.5, 1500. },
+		{ 30., 2000. }
+	};
+
+	for (size_t i = 0; i < sizeof(pTs) / sizeof(*pTs); ++i)
+		check_roundtrip(H2O::pT(pTs[i][0], pTs[i][1]), "single-phase");
+
+	static const double Txs[][2] =
+	{
+		{ 280., 0.5 },
+		{ 373.15, 0.01 },
+		{ 500., 0.99 },
+		{ 630., 0.3 },
+		{ 645., 0.7 }
+	};
+
+	for (size_t i = 0; i < sizeof(Txs) / sizeof(*Txs); ++i)
+		check_roundtrip(H2O::Tx(Txs[i][0], Txs[i][1]), "two-phase");
+
+	// (v,u)
+	H2O ref = H2O::pT(1., 500.);
+	H2O st = H2O::vu(ref.v(), ref.u());
+	check(close(st.v(), ref.v(), 1E-10) && close(st.T(), 500., 1E-9),
+			"vu", ref.v(), ref.u());
+
+	// out-of-range
+	check(!H2O::try_rhou(-1., 1000.).initialized(), "negative density",
+			-1., 1000.);
+	check(!H2O::try_rhou(1000., 10000.).initialized(), "internal energy",
+			1000., 10000.);
+	check(!H2O::try_vu(0., 1000.).initialized(), "zero volume",
+			0., 1000.);
+
+	bool thrown = false;
+	try
+	{
+		H2O::rhou(1000., 10000.);
+	}
+	catch (std::range_error& e)
+	{
+		thrown = true;
+	}
+	check(thrown, "range_error", 1000., 10000.);
+
+	// a node of a transient simulation, heated at constant volume
+	// until the wet steam dries out
+	h2o::backward::WarmStart node(H2O::Tx(400., 0.9));
+	double rho = node.state().rho(), u = node.state().u();
+
+	for (int i = 0; i < 40; ++i)
+	{
+		const H2O& sti = node.rhou(rho, u + i * 20.);
+
+		check(close(sti.rho(), rho, 1E-10) && close(sti.u(), u + i * 20.,
+					1E-10), "trajectory", rho, u + i * 20.);
+	}
+	check(node.state().region() == Region::R2, "drying", rho, u);
+
+	H2O hint = H2O::pT(10., 600.);
+	st = H2O::warm_rhou(hint.rho() * 1.001, hint.u() + 1., hint);
+	check(close(st.rho(), hint.rho() * 1.001, 1E-10)
+			&& close(st.u(), hint.u() + 1., 1E-10), "H2O::warm_rhou",
+			hint.rho() * 1.001, hint.u() + 1.);
+
+	// a region 3 hint is used as well
+	h2o::backward::WarmStart cell(H2O::pT(30., 700.));
+	rho = cell.state().rho() * 1.001;
+	u = cell.state().u() + 1.;
+	st = cell.rhou(rho, u);
+	check(close(st.rho(), rho, 1E-10) && close(st.u(), u, 1E-10),
+			"region 3 warm_rhou", rho, u);
+	check(cell.warm() && cell.iterations() <= 3, "region 3 iterations",
+			rho, u);
+
+	return finish();
+}
@@ -0,0 +1,172 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o"
+#include "h2o_saturation"
+#include "tests.hxx"
+
+#include <stdexcept>
+
+#include <cmath>
+
+static bool within(double value, double expected, double tolerance,
+		double floor)
+{
+	return std::fabs(value - expected)
+		<= tolerance * std::max(std::fabs(expected), floor);
+}
+
+// compare the phase properties, cp, cv & w only if @full
+static void check_phase(const char* what, double a,
+		const h2o::PropertySet& expected, const h2o::PropertySet& got,
+		double tolerance, bool full)
+{
+	check(within(got.p, expected.p, tolerance, 0.), what, a,
+			expected.p, got.p);
+	check(within(got.T, expected.T, tolerance, 0.), what, a,
+			expected.T, got.T);
+	check(within(got.rho, expected.rho, tolerance, 0.), what, a,
+			expected.rho, got.rho);
+	check(within(got.v, expected.v, tolerance, 0.), what, a,
+			expected.v, got.v);
+	check(within(got.u, expected.u, tolerance, 1.), what, a,
+			expected.u, got.u);
+	check(within(got.h, expected.h, tolerance, 1.), what, a,
+			expected.h, got.h);
+	check(within(got.s, expected.s, tolerance, 1.), what, a,
+			expected.s, got.s);
+
+	if (full)
+	{
+		check(within(got.cp, expected.cp, tolerance, 0.), what, a,
+				expected.cp, got.cp);
+		check(within(got.cv, expected.cv, tolerance, 0.), what, a,
+				expected.cv, got.cv);
+		check(within(got.w, expected.w, tolerance, 0.), what, a,
+				expected.w, got.w);
+	}
+}
+
+static void check_state(const char* what, double a,
+		const h2o::saturation::State& expected,
+		const h2o::saturation::State& got, double tolerance)
+{
+	check(within(got.p, expected.p, tolerance, 0.), what, a,
+			expected.p, got.p);
+	check(within(got.T, expected.T, tolerance, 0.), what, a,
+			expected.T, got.T);
+	check_phase(what, a, expected.liquid, got.liquid, tolerance, true);
+	check_phase(what, a, expected.vapour, got.vapour, tolerance, true);
+}
+
+template <class F>
+static void check_throws(const char* what, double a, F func)
+{
+	bool thrown = false;
+
+	try
+	{
+		func(a);
+	}
+	catch (std::range_error& e)
+	{
+		thrown = true;
+	}
+
+	check(thrown, what, a, 1., thrown);
+}
+
+static h2o::saturation::State table_T(double T)
+{
+	return h2o::saturation::table().T(T);
+}
+
+static h2o::saturation::State table_p(double p)
+{
+	return h2o::saturation::table().p(p);
+}
+
+int main(void)
+{
+	using h2o::H2O;
+	using namespace h2o::saturation;
+
+	// IAPWS-IF97 verification values (region 4)
+	check(within(T(300.).p, 0.353658941E-2, 1E-8, 0.), "psat", 300.,
+			0.353658941E-2, T(300.).p);
+	check(within(T(500.).p, 0.263889776E1, 1E-8, 0.), "psat", 500.,
+			0.263889776E1, T(500.).p);
+	check(within(T(600.).p, 0.123443146E2, 1E-8, 0.), "psat", 600.,
+			0.123443146E2, T(600.).p);
+	check(within(p(0.1).T, 0.372755919E3, 1E-8, 0.), "Tsat", 0.1,
+			0.372755919E3, p(0.1).T);
+	check(within(p(1.).T, 0.453035632E3, 1E-8, 0.), "Tsat", 1.,
+			0.453035632E3, p(1.).T);
+	check(within(p(10.).T, 0.584149488E3, 1E-8, 0.), "Tsat", 10.,
+			0.584149488E3, p(10.).T);
+
+	// the saturated phases, compared to the libh2o state points
+	static const double Ts[] = { 273.15, 300., 400., 500., 623.15,
+		630., 640., 645. };
+	for (int i = 0; i < 8; ++i)
+	{
+		State st = T(Ts[i]);
+
+		check_phase("liquid", Ts[i], H2O::Tx(Ts[i], 0.).properties(),
+				st.liquid, 1E-9, false);
+		check_phase("vapour", Ts[i], H2O::Tx(Ts[i], 1.).properties(),
+				st.vapour, 1E-9, false);
+		check_phase("mixture", Ts[i], H2O::Tx(Ts[i], 0.3).properties(),
+				st.mixture(0.3), 1E-9, false);
+		check(st.liquid.x == 0. && st.vapour.x == 1., "x", Ts[i],
+				0., st.liquid.x);
+
+		// the same point by pressure
+		State sp = p(st.p);
+		check_state("by p", Ts[i], st, sp, 1E-9);
+	}
+
+	// cp, cv & w of the liquid, compared to the single-phase state
+	State st = T(400.);
+	check_phase("liquid (pT)", 400., H2O::pT(st.p, 400.).properties(),
+			st.liquid, 1E-12, true);
+
+	// the table, compared to the direct evaluation
+	const Table& table = h2o::saturation::table();
+	double tolerance = table.tolerance();
+	check(table.fallback_ratio() < 0.05, "fallback ratio", 0.,
+			0.05, table.fallback_ratio());
+	for (double T = 273.15; T <= 647.096; T += 0.0731)
+		check_state("table T", T, h2o::saturation::T(T),
+				table.T(T), tolerance);
+	for (double lnp = std::log(0.000612); lnp < std::log(22.064);
+			lnp += 0.0173)
+	{
+		double p = std::exp(lnp);
+
+		check_state("table p", p, h2o::saturation::p(p),
+				table.p(p), tolerance);
+	}
+	check_state("table T", 647.096, h2o::saturation::T(647.096),
+			table.T(647.096), tolerance);
+	check_state("table p", 22.06, h2o::saturation::p(22.06),
+			table.p(22.06), tolerance);
+
+	// out-of-range
+	check_throws("T < Tt", 273., h2o::saturation::T);
+	check_throws("T > Tc", 647.1, h2o::saturation::T);
+	check_throws("p < pt", 0.0006, h2o::saturation::p);
+	check_throws("p > pc", 22.1, h2o::saturation::p);
+	check_throws("table T < Tt", 273., table_T);
+	check_throws("table T > Tc", 647.1, table_T);
+	check_throws("table p < pt", 0.0006, table_p);
+	check_throws("table p > pc", 22.1, table_p);
+
+	return finish();
+}
@@ -0,0 +1,183 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o_sbtl"
+#include "tests.hxx"
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+static bool close(double value, double expected, double tolerance,
+		double floor)
+{
+	return std::fabs(value - expected)
+		<= tolerance * std::max(std::fabs(expected), floor);
+}
+
+// compare the tables against H2O::ph() & H2O::ps() at a given state
+static void check_state(const h2o::H2O& st)
+{
+	const double tol = h2o::sbtl::ph_table().tolerance();
+	double p = st.p(), T = st.T();
+	h2o::H2O ref_ph, ref_ps;
+
+	try
+	{
+		ref_ph = h2o::H2O::ph(p, st.h());
+		ref_ps = h2o::H2O::ps(p, st.s());
+	}
+	catch (std::range_error& e)
+	{
+		return;
+	}
+
+	h2o::PropertySet ph = h2o::sbtl::ph(p, st.h());
+	h2o::PropertySet ps = h2o::sbtl::ps(p, st.s());
+
+	check(close(ph.T, ref_ph.T(), tol, 0.), "ph: T", p, T);
+	check(close(ph.v, ref_ph.v(), tol, 0.), "ph: v", p, T);
+	check(close(ph.s, ref_ph.s(), tol, 1.), "ph: s", p, T);
+	check(close(ps.T, ref_ps.T(), tol, 0.), "ps: T", p, T);
+	check(close(ps.v, ref_ps.v(), tol, 0.), "ps: v", p, T);
+	check(close(ps.h, ref_ps.h(), tol, 1.), "ps: h", p, T);
+
+	check(h2o::sbtl::ph_table().state(p, st.h()).region()
+			== ref_ph.region(), "ph: region", p, T);
+}
+
+static bool same(double a, double b)
+{
+	if (std::isnan(a) || std::isnan(b))
+		return std::isnan(a) && std::isnan(b);
+	return a == b;
+}
+
+static bool load_fails(const char* path)
+{
+	try
+	{
+		h2o::sbtl::Table::load(path);
+	}
+	catch (std::runtime_error& e)
+	{
+		return true;
+	}
+
+	return false;
+}
+
+// save the default table, and check the loaded copy
+static void check_file()
+{
+	static const char path[] = "sbtl.tmp";
+	const h2o::sbtl::Table& table = h2o::sbtl::ph_table();
+
+	table.save(path);
+
+	h2o::sbtl::Table loaded = h2o::sbtl::Table::load(path);
+	h2o::sbtl::Table copy = loaded;
+
+	check(!table.mapped(), "built table mapped");
+#ifdef HAVE_MMAP
+	check(loaded.mapped() && copy.mapped(), "loaded table mapped");
+#endif
+	check(loaded.kind() == h2o::sbtl::Table::PH
+			&& loaded.tolerance() == table.tolerance()
+			&& loaded.fallback_ratio() == table.fallback_ratio(),
+			"loaded table parameters");
+
+	// the loaded table must give exactly the same results
+	for (double lnp = std::log(0.001); lnp < std::log(100.); lnp += 0.29)
+	{
+		double p = std::exp(lnp);
+
+		for (double h = 50.; h < 4000.; h += 73.)
+		{
+			h2o::PropertySet ref, got;
+
+			try
+			{
+				ref = table(p, h);
+			}
+			catch (std::range_error& e)
+			{
+				continue;
+			}
+
+			got = copy(p, h);
+			check(same(got.T, ref.T) && same(got.v, ref.v)
+					&& same(got.s, ref.s) && same(got.x, ref.x),
+					"loaded table", p, h);
+		}
+	}
+
+	// corrupt a single byte of the data
+	std::FILE* f = std::fopen(path, "r+b");
+	std::fseek(f, 4096, SEEK_SET);
+	int c = std::fgetc(f);
+	std::fseek(f, 4096, SEEK_SET);
+	std::fputc(c ^ 1, f);
+	std::fclose(f);
+
+	check(load_fails(path), "corrupted table loaded");
+	check(load_fails("nonexistent.tmp"), "nonexistent table loaded");
+
+	std::remove(path);
+}
+
+int main(void)
+{
+	// single-phase states
+	for (double lnp = std::log(0.002); lnp < std::log(100.); lnp += 0.37)
+	{
+		double p = std::exp(lnp);
+
+		for (double T = 280.35; T < 1073.15; T += 12.)
+			check_state(h2o::H2O::pT(p, T));
+	}
+
+	// single-phase states within 1 K of the saturation line
+	for (double lnp = std::log(0.002); lnp < std::log(21.); lnp += 0.19)
+	{
+		double p = std::exp(lnp);
+		double T_sat = h2o::H2O::px(p, 0.).T();
+
+		for (double dT = 0.01; dT < 1.; dT *= 2.)
+		{
+			check_state(h2o::H2O::pT(p, T_sat - dT));
+			check_state(h2o::H2O::pT(p, T_sat + dT));
+		}
+	}
+
+	// two-phase states
+	for (double T = 285.; T < 630.; T += 17.)
+	{
+		for (double x = 0.05; x < 1.; x += 0.3)
+			check_state(h2o::H2O::Tx(T, x));
+	}
+
+	// out-of-range
+	try
+	{
+		h2o::sbtl::ph(200., 1000.);
+		check(false, "range_error", 200., 1000.);
+	}
+	catch (std::range_error& e)
+	{
+		check(true, "range_error", 200., 1000.);
+	}
+
+	check(h2o::sbtl::ph_table().fallback_ratio() < 0.1,
+			"fallback ratio");
+
+	check_file();
+
+	return finish();
+}
@@ -0,0 +1,128 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o_batch"
+#include "tests.hxx"
+
+#include <iostream>
+
+#include <cmath>
+#include <vector>
+
+static bool same(double a, double b)
+{
+	if (std::isnan(a) || std::isnan(b))
+		return std::isnan(a) && std::isnan(b);
+	return a == b;
+}
+
+static const char* isa_names[] = { "scalar", "sse2", "avx2", "avx512" };
+
+// the kernels have to give exactly the scalar results
+static void compare(const h2o::H2OArray& arr, const h2o::H2OArray& ref,
+		const char* what)
+{
+	check(arr.size() == ref.size(), what, 0);
+
+	for (size_t i = 0; i < arr.size() && i < ref.size(); ++i)
+	{
+		check(arr.region[i] == ref.region[i], what, i);
+		check(same(arr.p[i], ref.p[i]) && same(arr.T[i], ref.T[i])
+				&& same(arr.x[i], ref.x[i])
+				&& same(arr.rho[i], ref.rho[i]), what, i);
+		check(same(arr.v[i], ref.v[i]) && same(arr.u[i], ref.u[i])
+				&& same(arr.h[i], ref.h[i])
+				&& same(arr.s[i], ref.s[i]), what, i);
+		check(same(arr.cp[i], ref.cp[i]) && same(arr.cv[i], ref.cv[i])
+				&& same(arr.w[i], ref.w[i]), what, i);
+	}
+}
+
+int main()
+{
+	const h2o::batch::isa_type isa0 = h2o::batch::isa();
+
+	check(h2o::batch::set_isa(isa0), "default isa supported", 0);
+	check(h2o::batch::set_isa(h2o::batch::ISA_SCALAR)
+			&& h2o::batch::isa() == h2o::batch::ISA_SCALAR,
+			"scalar isa", 0);
+
+	// a (p,T) grid over all the regions, with some out-of-range points
+	std::vector<double> p, T;
+
+	for (int i = 0; i < 40; ++i)
+		for (int j = 0; j < 25; ++j)
+		{
+			p.push_back(0.0005 * std::pow(10., i * 5.6 / 39.));
+			T.push_back(270. + j * 2050. / 24.);
+		}
+
+	h2o::H2OArray ref, ref_h, ref_ph;
+	unsigned h_only = h2o::H2OArray::COL_H | h2o::H2OArray::COL_T;
+
+	size_t oor = h2o::batch::pT(p, T, ref);
+	h2o::batch::pT(p, T, ref_h, h_only);
+
+	// (p,h) of the valid points, for the backward path
+	std::vector<double> ph_p, ph_h;
+	for (size_t i = 0; i < ref.size(); ++i)
+		if (ref.region[i] != h2o::Region::OOR)
+		{
+			ph_p.push_back(ref.p[i]);
+			ph_h.push_back(ref.h[i]);
+		}
+	h2o::batch::ph(ph_p, ph_h, ref_ph);
+
+	check(oor > 0 && oor < p.size(), "grid covers out-of-range", 0);
+
+	for (int k = h2o::batch::ISA_SSE2; k <= h2o::batch::ISA_AVX512; ++k)
+	{
+		h2o::batch::isa_type isa = static_cast<h2o::batch::isa_type>(k);
+
+		if (!h2o::batch::set_isa(isa))
+		{
+			std::cerr << "[SKIP] " << isa_names[k] << " not supported"
+				<< std::endl;
+			continue;
+		}
+
+		check(h2o::batch::isa() == isa, isa_names[k], 0);
+
+		h2o::H2OArray arr;
+
+		check(h2o::batch::pT(p, T, arr) == oor, isa_names[k], 0);
+		compare(arr, ref, isa_names[k]);
+
+		// column selection
+		h2o::batch::pT(p, T, arr, h_only);
+		compare(arr, ref_h, isa_names[k]);
+
+		h2o::batch::ph(ph_p, ph_h, arr);
+		compare(arr, ref_ph, isa_names[k]);
+
+		// partial vectors and blocks
+		static const size_t sizes[] = { 1, 3, 7, 9, 63, 65, 129, 200 };
+
+		for (size_t n = 0; n < sizeof(sizes) / sizeof(*sizes); ++n)
+		{
+			h2o::H2OArray part, part_ref;
+			h2o::batch::View pv(&p[300], sizes[n]), Tv(&T[300], sizes[n]);
+
+			h2o::batch::set_isa(h2o::batch::ISA_SCALAR);
+			h2o::batch::pT(pv, Tv, part_ref);
+			h2o::batch::set_isa(isa);
+			h2o::batch::pT(pv, Tv, part);
+			compare(part, part_ref, isa_names[k]);
+		}
+	}
+
+	h2o::batch::set_isa(isa0);
+
+	return finish();
+}
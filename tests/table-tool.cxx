@@ -0,0 +1,182 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o"
+#include "tests.hxx"
+
+#include <string>
+#include <vector>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static bool same(double a, double b)
+{
+	if (std::isnan(a) || std::isnan(b))
+		return std::isnan(a) && std::isnan(b);
+	return std::fabs(a - b) <= 1E-12 * std::fabs(b);
+}
+
+static const char* tool = "./tools/h2o-table";
+static const char* binary_file = "table-tool.tmp";
+
+// the test grid: 20 x 30 cells, p logarithmic, with out-of-range cells
+static const char* grid = "pT 0.001:120:20:log 280:2400:30";
+static const size_t na = 20, nb = 30;
+
+// the grid arguments of a cell
+static void arguments(size_t i, double& p, double& T)
+{
+	p = 0.001 * std::pow(120. / 0.001, (i / nb) / (na - 1.));
+	T = 280. + (2400. - 280.) * (i % nb) / (nb - 1.);
+
+	if (i / nb == na - 1)
+		p = 120.;
+	if (i % nb == nb - 1)
+		T = 2400.;
+}
+
+static void check_cell(size_t i, int region, double h, double cp)
+{
+	double p, T;
+
+	arguments(i, p, T);
+	h2o::H2O st = h2o::H2O::try_pT(p, T);
+
+	check(region == st.region(), "region", i);
+	if (st.initialized())
+		check(same(h, st.h()) && same(cp, st.cp()), "properties", i);
+	else
+		check(std::isnan(h) && std::isnan(cp), "out-of-range NaN", i);
+}
+
+static void test_csv()
+{
+	std::string cmd = std::string(tool) + " -j 3 -c 77 -p h,cp " + grid;
+	std::FILE* f = popen(cmd.c_str(), "r");
+	char line[512];
+	size_t i = 0, oor = 0;
+
+	check(f != 0, "popen", 0);
+	if (!f)
+		return;
+
+	check(std::fgets(line, sizeof(line), f)
+			&& !std::strcmp(line, "p,T,region,h,cp\n"), "csv header", 0);
+
+	while (std::fgets(line, sizeof(line), f))
+	{
+		double p, T, h, cp, p0, T0;
+		int region;
+		char* s = line;
+
+		p = std::strtod(s, &s);
+		T = std::strtod(s + 1, &s);
+		region = std::strtol(s + 1, &s, 10);
+		h = std::strtod(s + 1, &s);
+		cp = std::strtod(s + 1, &s);
+
+		check(*s == '\n', "csv line", i);
+		arguments(i, p0, T0);
+		check(same(p, p0) && same(T, T0), "csv arguments", i);
+		check_cell(i, region, h, cp);
+		if (!region)
+			++oor;
+		++i;
+	}
+
+	check(pclose(f) == 0, "exit status", 0);
+	check(i == na * nb, "csv cell count", i);
+	check(oor > 0 && oor < i, "csv out-of-range cells", oor);
+}
+
+template <class T>
+static T read_value(std::FILE* f)
+{
+	T val = T();
+
+	if (std::fread(&val, sizeof(val), 1, f) != 1)
+		++failed;
+	return val;
+}
+
+static void test_binary()
+{
+	std::string cmd = std::string(tool) + " -f binary -c 128 -p cp,h -o "
+		+ binary_file + " " + grid;
+
+	check(std::system(cmd.c_str()) == 0, "exit status", 0);
+
+	std::FILE* f = std::fopen(binary_file, "rb");
+	check(f != 0, "binary output", 0);
+	if (!f)
+		return;
+
+	char magic[8], name[8];
+
+	check(std::fread(magic, 1, 8, f) == 8
+			&& !std::memcmp(magic, "H2OTABLE", 8), "magic", 0);
+	check(read_value<std::uint32_t>(f) == 1, "version", 0);
+	check(read_value<std::uint32_t>(f) == 0x01020304, "byte order", 0);
+	check(std::fread(name, 1, 8, f) == 8 && !std::strcmp(name, "pT"),
+			"constructor", 0);
+	check(read_value<std::uint64_t>(f) == na, "na", 0);
+	check(read_value<std::uint64_t>(f) == nb, "nb", 0);
+
+	size_t chunk = read_value<std::uint64_t>(f);
+	check(chunk == 128, "chunk", 0);
+	check(read_value<std::uint32_t>(f) == 2, "ncols", 0);
+	read_value<std::uint32_t>(f);
+	check(std::fread(name, 1, 8, f) == 8 && !std::strcmp(name, "cp"),
+			"column name", 0);
+	check(std::fread(name, 1, 8, f) == 8 && !std::strcmp(name, "h"),
+			"column name", 1);
+
+	std::vector<double> a(na), b(nb);
+	check(std::fread(&a[0], sizeof(double), na, f) == na
+			&& std::fread(&b[0], sizeof(double), nb, f) == nb, "axes", 0);
+	check(a[0] == 0.001 && a[na - 1] == 120. && b[nb - 1] == 2400.,
+			"axis values", 0);
+
+	for (size_t begin = 0; begin < na * nb; begin += chunk)
+	{
+		size_t n = std::min(chunk, na * nb - begin);
+		std::vector<std::uint8_t> region(n);
+		std::vector<double> cp(n), h(n);
+
+		check(std::fread(&region[0], 1, n, f) == n
+				&& std::fread(&cp[0], sizeof(double), n, f) == n
+				&& std::fread(&h[0], sizeof(double), n, f) == n,
+				"chunk", begin);
+
+		for (size_t i = 0; i < n; ++i)
+			check_cell(begin + i, region[i], h[i], cp[i]);
+	}
+
+	check(std::fgetc(f) == EOF, "end of file", 0);
+	std::fclose(f);
+	std::remove(binary_file);
+}
+
+int main(void)
+{
+	test_csv();
+	test_binary();
+
+	// invalid arguments
+	std::string cmd = std::string(tool) + " pT 1:2:0 300:400:2 2>/dev/null";
+	check(std::system(cmd.c_str()) != 0, "invalid axis", 0);
+	cmd = std::string(tool) + " -p h,foo " + grid + " 2>/dev/null";
+	check(std::system(cmd.c_str()) != 0, "invalid property", 0);
+
+	return finish();
+}
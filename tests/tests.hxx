@@ -0,0 +1,69 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#pragma once
+
+#ifndef _H2O_TESTS_HXX
+#define _H2O_TESTS_HXX 1
+
+#include <iostream>
+
+/**
+ * The common test harness. Every test program counts its checks,
+ * reports the failed ones along with their context (the state point,
+ * the index of the point...) and ends with finish().
+ */
+
+static int done = 0, failed = 0;
+
+static inline void print_context(const char*)
+{
+}
+
+template <class T, class... Rest>
+static void print_context(const char* separator, const T& first,
+		const Rest&... rest)
+{
+	std::cerr << separator << first;
+	print_context(", ", rest...);
+}
+
+/**
+ * Record the result of a check. If it failed, print @what followed
+ * by the @context values.
+ */
+template <class... Context>
+static void check(bool result, const char* what, const Context&... context)
+{
+	++done;
+	if (!result)
+	{
+		std::cerr << "[FAIL] " << what;
+		if (sizeof...(context))
+		{
+			print_context(" (", context...);
+			std::cerr << ")";
+		}
+		std::cerr << std::endl;
+		++failed;
+	}
+}
+
+/**
+ * Print the summary. Returns the exit status for main().
+ */
+static int finish()
+{
+	if (failed == 0)
+		std::cerr << done << " tests done. All tests succeeded."
+			<< std::endl;
+	else
+		std::cerr << failed << " of " << done
+			<< " tests failed." << std::endl;
+
+	return failed ? 1 : 0;
+}
+
+#endif /*_H2O_TESTS_HXX*/
@@ -0,0 +1,117 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o_tiles"
+#include "tests.hxx"
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+static bool close(double a, double b, double tolerance)
+{
+	return std::fabs(a - b) <= tolerance * std::max(std::fabs(b), 1.);
+}
+
+// a small working set in the given (p,h) rectangle
+static bool check_area(h2o::TileCache& cache, double p0, double p1,
+		double h0, double h1)
+{
+	bool ret = true;
+
+	for (int i = 0; i < 20; ++i)
+	{
+		double p = p0 * std::pow(p1 / p0, (i + 0.37) / 20.);
+
+		for (int j = 0; j < 20; ++j)
+		{
+			double h = h0 + (h1 - h0) * (j + 0.61) / 20.;
+			h2o::PropertySet ps = cache(p, h);
+			h2o::PropertySet ref = h2o::H2O::ph(p, h).properties();
+			double tolerance = cache.tolerance();
+
+			if (!close(ps.T, ref.T, tolerance)
+					|| !close(ps.v, ref.v, tolerance)
+					|| !close(ps.s, ref.s, tolerance)
+					|| !close(ps.p, p, 1E-12) || !std::isnan(ps.cp))
+				ret = false;
+			if (ref.x == 0. || ref.x == 1. ? ps.x != ref.x
+					: !close(ps.x, ref.x, tolerance))
+				ret = false;
+		}
+	}
+
+	return ret;
+}
+
+int main(void)
+{
+	h2o::TileCache cache;
+
+	check(cache.built() == 0 && cache.memory() == 0, "empty cache");
+
+	check(check_area(cache, 1., 5., 100., 400.), "compressed liquid");
+	check(cache.built() > 0 && cache.exact() == 0, "liquid tiles");
+
+	size_t built = cache.built();
+	check(check_area(cache, 1., 5., 100., 400.), "liquid repeated");
+	check(cache.built() == built, "tiles reused");
+
+	check(check_area(cache, 0.1, 1., 2900., 3200.), "superheated steam");
+	// across the 2a-2b backward equation boundary at 4 MPa
+	check(check_area(cache, 3., 5., 2900., 3300.), "2a-2b boundary");
+	check(check_area(cache, 0.1, 1., 1000., 2000.), "wet steam");
+	// the tiles around the saturation line are evaluated directly
+	check(check_area(cache, 0.01, 0.02, 2550., 2650.), "saturated vapour");
+	check(cache.exact() > 0, "saturation line tiles");
+
+	check(cache.built() < cache.tiles() / 4, "working set");
+	check(cache.memory() > 0, "memory");
+
+	// out-of-range
+	try
+	{
+		cache(200., 3000.);
+		check(false, "range_error");
+	}
+	catch (std::range_error& e)
+	{
+		check(true, "range_error");
+	}
+
+	// concurrent look-ups, building the same tiles
+	h2o::TileCache shared;
+	std::atomic<int> mismatches(0);
+	std::vector<std::thread> threads;
+	const int nthreads = 4, lookups = 2000;
+
+	for (int t = 0; t < nthreads; ++t)
+		threads.push_back(std::thread([&shared, &cache, &mismatches]()
+		{
+			for (int i = 0; i < lookups; ++i)
+			{
+				double p = 1. + (i * 7) % 100 * 0.04;
+				double h = 100. + (i * 13) % 50 * 6.;
+
+				// the tiles are deterministic, so the results have
+				// to be identical to the ones built above
+				if (shared(p, h).T != cache(p, h).T)
+					++mismatches;
+			}
+		}));
+	for (size_t t = 0; t < threads.size(); ++t)
+		threads[t].join();
+
+	check(mismatches == 0, "concurrent results");
+	check(shared.built() <= built, "concurrent tiles");
+
+	return finish();
+}
@@ -0,0 +1,76 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o"
+#include "tests.hxx"
+
+#include <stdexcept>
+
+typedef h2o::H2O (*constructor_func_t)(double, double);
+
+// the non-throwing constructor has to return the same state
+// as the throwing one, or an uninitialized object where it throws
+static void check_constructor(const char* what, constructor_func_t constr,
+		constructor_func_t try_constr, double a, double b)
+{
+	h2o::H2O ref;
+	bool thrown = false;
+
+	try
+	{
+		ref = constr(a, b);
+	}
+	catch (std::range_error& e)
+	{
+		thrown = true;
+	}
+
+	h2o::H2O st = try_constr(a, b);
+
+	check(st.initialized() == !thrown, what, a, b);
+	check(st.region() == ref.region(), what, a, b);
+	if (!thrown)
+	{
+		check(st.p() == ref.p(), what, a, b);
+		check(st.T() == ref.T(), what, a, b);
+		check(st.h() == ref.h(), what, a, b);
+	}
+}
+
+static_assert(noexcept(h2o::H2O::try_pT(0., 0.)),
+		"try_pT() must not throw");
+static_assert(noexcept(h2o::H2O::try_hs(0., 0.)),
+		"try_hs() must not throw");
+
+int main(void)
+{
+	// in range
+	check_constructor("pT", h2o::H2O::pT, h2o::H2O::try_pT, 3., 300.);
+	check_constructor("pT", h2o::H2O::pT, h2o::H2O::try_pT, 25., 650.);
+	check_constructor("Tx", h2o::H2O::Tx, h2o::H2O::try_Tx, 400., 0.5);
+	check_constructor("px", h2o::H2O::px, h2o::H2O::try_px, 1., 0.2);
+	check_constructor("ph", h2o::H2O::ph, h2o::H2O::try_ph, 10., 2800.);
+	check_constructor("ps", h2o::H2O::ps, h2o::H2O::try_ps, 10., 6.);
+	check_constructor("hs", h2o::H2O::hs, h2o::H2O::try_hs, 2800., 6.);
+	check_constructor("rhoT", h2o::H2O::rhoT, h2o::H2O::try_rhoT,
+			500., 650.);
+
+	// out of range
+	check_constructor("pT", h2o::H2O::pT, h2o::H2O::try_pT, 1000., 300.);
+	check_constructor("pT", h2o::H2O::pT, h2o::H2O::try_pT, 1., 5000.);
+	check_constructor("Tx", h2o::H2O::Tx, h2o::H2O::try_Tx, 1000., 0.5);
+	check_constructor("px", h2o::H2O::px, h2o::H2O::try_px, 50., 0.5);
+	check_constructor("ph", h2o::H2O::ph, h2o::H2O::try_ph, 10., -500.);
+	check_constructor("ps", h2o::H2O::ps, h2o::H2O::try_ps, 10., 50.);
+	check_constructor("hs", h2o::H2O::hs, h2o::H2O::try_hs, 10000., 6.);
+	check_constructor("rhoT", h2o::H2O::rhoT, h2o::H2O::try_rhoT,
+			500., 5000.);
+
+	return finish();
+}
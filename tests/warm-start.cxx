@@ -0,0 +1,148 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o"
+#include "h2o_backward"
+#include "tests.hxx"
+
+#include <stdexcept>
+
+#include <cmath>
+
+static bool close(double a, double b, double tolerance)
+{
+	return std::fabs(a - b) <= tolerance * std::fabs(b);
+}
+
+static bool same_state(const h2o::H2O& a, const h2o::H2O& b,
+		double tolerance)
+{
+	return a.region() == b.region() && close(a.T(), b.T(), tolerance)
+		&& close(a.p(), b.p(), tolerance)
+		&& close(a.v(), b.v(), tolerance);
+}
+
+int main(void)
+{
+	using h2o::H2O;
+	using h2o::Region;
+	using h2o::backward::WarmStart;
+	using h2o::backward::EXACT;
+
+	// a superheated steam node, heated in small steps
+	WarmStart node;
+	for (int i = 0; i < 50; ++i)
+	{
+		double p = 10. - i * 0.001, h = 3000. + i * 0.5;
+		const H2O& st = node.ph(p, h);
+
+		check(same_state(st, h2o::backward::ph(p, h, EXACT), 1E-12),
+				"ph trajectory", p, h);
+		// the first state point has no hint
+		check(i == 0 ? !node.warm() : node.warm() && node.iterations() <= 2,
+				"ph iterations", p, h);
+	}
+
+	// compressed liquid, by (p,s)
+	WarmStart liquid(H2O::pT(5., 350.));
+	for (int i = 0; i < 20; ++i)
+	{
+		double p = 5. + i * 0.01, s = liquid.state().s() + 1E-4;
+		const H2O& st = liquid.ps(p, s);
+
+		check(same_state(st, h2o::backward::ps(p, s, EXACT), 1E-12),
+				"ps trajectory", p, s);
+		check(liquid.warm() && liquid.iterations() <= 2,
+				"ps iterations", p, s);
+	}
+
+	// (h,s) and (rho,T)
+	WarmStart steam(H2O::pT(1., 500.));
+	double h = steam.state().h(), s = steam.state().s();
+	for (int i = 0; i < 20; ++i)
+	{
+		const H2O& st = steam.hs(h + i * 0.5, s + i * 1E-4);
+
+		check(same_state(st, h2o::backward::hs(h + i * 0.5, s + i * 1E-4,
+					EXACT), 1E-12), "hs trajectory", h + i * 0.5,
+				s + i * 1E-4);
+		check(steam.warm() && steam.iterations() <= 3, "hs iterations",
+				h + i * 0.5, s + i * 1E-4);
+	}
+
+	static const double pTs[][2] =
+	{
+		{ 10., 350. },
+		{ 1., 500. },
+		{ 30., 700. },
+		{ 30., 1500. }
+	};
+
+	for (size_t j = 0; j < sizeof(pTs) / sizeof(*pTs); ++j)
+	{
+		WarmStart cell(H2O::pT(pTs[j][0], pTs[j][1]));
+		double rho = cell.state().rho(), T = cell.state().T();
+
+		for (int i = 0; i < 10; ++i)
+		{
+			double rhoi = rho * (1. + i * 1E-6), Ti = T + i * 0.01;
+			const H2O& st = cell.rhoT(rhoi, Ti);
+
+			check(close(st.rho(), rhoi, 1E-12) && close(st.T(), Ti, 1E-12),
+					"rhoT trajectory", rhoi, Ti);
+			check(cell.warm() && cell.iterations() <= 3,
+					"rhoT iterations", rhoi, Ti);
+		}
+	}
+
+	// crossing into the two-phase region falls back to the cold path
+	WarmStart boiling(H2O::pT(1., 400.));
+	H2O liq = H2O::px(1., 0.);
+	const H2O& wet = boiling.ph(1., liq.h() + 100.);
+	check(wet.region() == Region::R4 && !boiling.warm(), "R1 -> R4",
+			1., liq.h() + 100.);
+	check(same_state(wet, h2o::backward::ph(1., liq.h() + 100., EXACT),
+				1E-12), "R1 -> R4 state", 1., liq.h() + 100.);
+
+	// ...and back, from a two-phase hint
+	const H2O& dry = boiling.ph(1., 3000.);
+	check(dry.region() == Region::R2 && !boiling.warm(), "R4 -> R2",
+			1., 3000.);
+
+	// out-of-range keeps the previous state
+	bool thrown = false;
+	try
+	{
+		boiling.ph(200., 3000.);
+	}
+	catch (std::range_error& e)
+	{
+		thrown = true;
+	}
+	check(thrown && boiling.state().h() == dry.h(), "out-of-range",
+			200., 3000.);
+
+	// the H2O counterparts
+	H2O hint = H2O::pT(3., 600.);
+	check(same_state(H2O::warm_ph(3.01, hint.h() + 1., hint),
+				h2o::backward::ph(3.01, hint.h() + 1., EXACT), 1E-12),
+			"H2O::warm_ph", 3.01, hint.h() + 1.);
+	check(same_state(H2O::warm_ps(3.01, hint.s(), hint),
+				h2o::backward::ps(3.01, hint.s(), EXACT), 1E-12),
+			"H2O::warm_ps", 3.01, hint.s());
+	check(same_state(H2O::warm_hs(hint.h() + 1., hint.s(), hint),
+				h2o::backward::hs(hint.h() + 1., hint.s(), EXACT), 1E-12),
+			"H2O::warm_hs", hint.h() + 1., hint.s());
+	H2O cold = H2O::warm_rhoT(hint.rho() * 1.001, 601., H2O());
+	check(close(cold.rho(), hint.rho() * 1.001, 1E-12)
+			&& close(cold.T(), 601., 1E-12), "H2O::warm_rhoT (no hint)",
+			hint.rho() * 1.001, 601.);
+
+	return finish();
+}
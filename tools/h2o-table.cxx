@@ -0,0 +1,437 @@
+/* libh2o -- water & steam properties
+ * (c) 2012 Michał Górny
+ * Released under the terms of the 2-clause BSD license
+ */
+
+/**
+ * h2o-table -- evaluate a property grid and write it out.
+ *
+ * The grid is the cartesian product of two axes (the first one being
+ * the outer one), and is evaluated in chunks of a fixed number
+ * of cells using the parallel batch constructors. While a chunk is being
+ * evaluated, the previous one is written out by another thread, so
+ * the memory use does not depend on the grid size. Out-of-range cells
+ * are written with region 0 and NaN properties.
+ *
+ * The binary format (all the values in the native byte order):
+ *
+ *   char[8]    magic: "H2OTABLE"
+ *   uint32     version: 1
+ *   uint32     byte order mark: 0x01020304
+ *   char[8]    constructor, NUL-padded (e.g. "pT")
+ *   uint64     na, nb: the axis sizes
+ *   uint64     chunk: the number of cells per chunk
+ *   uint32     ncols: the number of property columns
+ *   uint32     reserved: 0
+ *   char[8]    the names of the property columns, NUL-padded [ncols]
+ *   float64    the first axis values [na]
+ *   float64    the second axis values [nb]
+ *
+ * followed by ceil(na * nb / chunk) chunks. Every chunk has n = chunk
+ * cells (less in the last one), in the row-major order. It consists
+ * of the region column (uint8[n], 0 for out-of-range and 1 to 5 for
+ * the regions), followed by the property columns (float64[n] each).
+ */
+
+#ifdef HAVE_CONFIG_H
+#	include "config.h"
+#endif
+
+#include "h2o_parallel"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using h2o::H2OArray;
+
+typedef size_t (*constructor_func_t)(h2o::batch::View, h2o::batch::View,
+		H2OArray&, unsigned, h2o::parallel::ThreadPool&);
+
+struct Constructor
+{
+	const char* name;
+	constructor_func_t func;
+	const char* a;
+	const char* b;
+};
+
+static const Constructor constructors[] =
+{
+	{ "pT", h2o::parallel::pT, "p", "T" },
+	{ "Tx", h2o::parallel::Tx, "T", "x" },
+	{ "px", h2o::parallel::px, "p", "x" },
+	{ "ph", h2o::parallel::ph, "p", "h" },
+	{ "ps", h2o::parallel::ps, "p", "s" },
+	{ "hs", h2o::parallel::hs, "h", "s" },
+	{ "rhoT", h2o::parallel::rhoT, "rho", "T" }
+};
+
+struct Property
+{
+	const char* name;
+	H2OArray::column_type column;
+	std::vector<double> H2OArray::*data;
+};
+
+static const Property properties[] =
+{
+	{ "p", H2OArray::COL_P, &H2OArray::p },
+	{ "T", H2OArray::COL_T, &H2OArray::T },
+	{ "x", H2OArray::COL_X, &H2OArray::x },
+	{ "rho", H2OArray::COL_RHO, &H2OArray::rho },
+	{ "v", H2OArray::COL_V, &H2OArray::v },
+	{ "u", H2OArray::COL_U, &H2OArray::u },
+	{ "h", H2OArray::COL_H, &H2OArray::h },
+	{ "s", H2OArray::COL_S, &H2OArray::s },
+	{ "cp", H2OArray::COL_CP, &H2OArray::cp },
+	{ "cv", H2OArray::COL_CV, &H2OArray::cv },
+	{ "w", H2OArray::COL_W, &H2OArray::w }
+};
+
+#define COUNT(a) (sizeof(a) / sizeof(*(a)))
+
+/**
+ * An evenly spaced (linearly or logarithmically) grid axis.
+ */
+struct Axis
+{
+	double min, max;
+	size_t n;
+	bool log;
+
+	double operator[](size_t i) const
+	{
+		double f = n > 1 ? static_cast<double>(i) / (n - 1) : 0.;
+
+		// hit the end point exactly
+		if (n > 1 && i == n - 1)
+			return max;
+		if (log)
+			return min * std::pow(max / min, f);
+		return min + (max - min) * f;
+	}
+};
+
+struct Options
+{
+	const Constructor* constr;
+	Axis a, b;
+	std::vector<const Property*> props;
+	bool binary;
+	const char* output;
+	size_t threads;
+	size_t chunk;
+	bool verbose;
+};
+
+/**
+ * Parse an axis specification: min:max:n[:log].
+ */
+static bool parse_axis(const char* spec, Axis& out)
+{
+	char* end;
+
+	out.min = std::strtod(spec, &end);
+	if (*end != ':')
+		return false;
+	out.max = std::strtod(end + 1, &end);
+	if (*end != ':')
+		return false;
+	out.n = std::strtoul(end + 1, &end, 10);
+	out.log = false;
+	if (!std::strcmp(end, ":log"))
+		out.log = true;
+	else if (*end)
+		return false;
+
+	return out.n > 0 && (!out.log || (out.min > 0. && out.max > 0.));
+}
+
+static bool parse_properties(const char* list,
+		std::vector<const Property*>& out)
+{
+	std::string s(list);
+	size_t pos = 0;
+
+	out.clear();
+	while (pos <= s.size())
+	{
+		size_t comma = s.find(',', pos);
+		std::string name = s.substr(pos, comma - pos);
+		size_t i;
+
+		for (i = 0; i < COUNT(properties); ++i)
+			if (name == properties[i].name)
+				break;
+		if (i == COUNT(properties))
+			return false;
+
+		out.push_back(&properties[i]);
+		if (comma == std::string::npos)
+			break;
+		pos = comma + 1;
+	}
+
+	return !out.empty();
+}
+
+/**
+ * A chunk of the grid: the arguments and the results.
+ */
+struct Chunk
+{
+	std::vector<double> a, b;
+	H2OArray out;
+};
+
+static void write_csv(std::FILE* f, const Options& opts, const Chunk& c)
+{
+	for (size_t i = 0; i < c.out.size(); ++i)
+	{
+		std::fprintf(f, "%.17g,%.17g,%d", c.a[i], c.b[i],
+				static_cast<int>(c.out.region[i]));
+
+		for (size_t j = 0; j < opts.props.size(); ++j)
+		{
+			double val = (c.out.*opts.props[j]->data)[i];
+
+			if (std::isnan(val))
+				std::fputs(",nan", f);
+			else
+				std::fprintf(f, ",%.17g", val);
+		}
+		std::fputc('\n', f);
+	}
+}
+
+static void write_binary(std::FILE* f, const Options& opts,
+		const Chunk& c)
+{
+	std::vector<std::uint8_t> region(c.out.size());
+
+	for (size_t i = 0; i < region.size(); ++i)
+		region[i] = static_cast<std::uint8_t>(c.out.region[i]);
+	std::fwrite(&region[0], 1, region.size(), f);
+
+	for (size_t j = 0; j < opts.props.size(); ++j)
+		std::fwrite(&(c.out.*opts.props[j]->data)[0], sizeof(double),
+				c.out.size(), f);
+}
+
+static void write_name(std::FILE* f, const char* name)
+{
+	char buf[8] = {};
+
+	// NUL-padded, with no terminator when the name fills the field
+	std::memcpy(buf, name, std::min(std::strlen(name), sizeof(buf)));
+	std::fwrite(buf, 1, sizeof(buf), f);
+}
+
+template <class T>
+static void write_value(std::FILE* f, T val)
+{
+	std::fwrite(&val, sizeof(val), 1, f);
+}
+
+static void write_header(std::FILE* f, const Options& opts)
+{
+	if (!opts.binary)
+	{
+		std::fprintf(f, "%s,%s,region", opts.constr->a, opts.constr->b);
+		for (size_t j = 0; j < opts.props.size(); ++j)
+			std::fprintf(f, ",%s", opts.props[j]->name);
+		std::fputc('\n', f);
+		return;
+	}
+
+	std::fwrite("H2OTABLE", 1, 8, f);
+	write_value<std::uint32_t>(f, 1);
+	write_value<std::uint32_t>(f, 0x01020304);
+	write_name(f, opts.constr->name);
+	write_value<std::uint64_t>(f, opts.a.n);
+	write_value<std::uint64_t>(f, opts.b.n);
+	write_value<std::uint64_t>(f, opts.chunk);
+	write_value<std::uint32_t>(f, opts.props.size());
+	write_value<std::uint32_t>(f, 0);
+	for (size_t j = 0; j < opts.props.size(); ++j)
+		write_name(f, opts.props[j]->name);
+	for (size_t i = 0; i < opts.a.n; ++i)
+		write_value<double>(f, opts.a[i]);
+	for (size_t i = 0; i < opts.b.n; ++i)
+		write_value<double>(f, opts.b[i]);
+}
+
+static size_t evaluate(const Options& opts, Chunk& c, size_t begin,
+		size_t end, h2o::parallel::ThreadPool& pool)
+{
+	unsigned columns = 0;
+
+	for (size_t j = 0; j < opts.props.size(); ++j)
+		columns |= opts.props[j]->column;
+
+	c.a.resize(end - begin);
+	c.b.resize(end - begin);
+	for (size_t i = begin; i < end; ++i)
+	{
+		c.a[i - begin] = opts.a[i / opts.b.n];
+		c.b[i - begin] = opts.b[i % opts.b.n];
+	}
+
+	return opts.constr->func(c.a, c.b, c.out, columns, pool);
+}
+
+static void usage(const char* argv0)
+{
+	std::cerr << "Usage: " << argv0
+		<< " [options] <constructor> <a> <b>\n"
+		<< "\n"
+		<< "  constructor  pT, Tx, px, ph, ps, hs or rhoT\n"
+		<< "  a, b         the axes of the grid, as min:max:n or min:max:n:log\n"
+		<< "               (the first one being the outer one)\n"
+		<< "\n"
+		<< "  -p  comma-separated properties to output (default: all;\n"
+		<< "      p, T, x, rho, v, u, h, s, cp, cv, w)\n"
+		<< "  -f  output format: csv or binary (default: csv)\n"
+		<< "  -o  output file (default: standard output)\n"
+		<< "  -j  number of threads (default: the number of CPUs)\n"
+		<< "  -c  number of cells per chunk (default: 65536)\n"
+		<< "  -v  report the progress on standard error\n";
+}
+
+int main(int argc, char* argv[])
+{
+	Options opts = { 0, {}, {}, {}, false, 0, 0, 65536, false };
+	std::vector<const char*> args;
+
+	parse_properties("p,T,x,rho,v,u,h,s,cp,cv,w", opts.props);
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* arg = argv[i];
+
+		if (!std::strcmp(arg, "-v"))
+			opts.verbose = true;
+		else if (arg[0] == '-' && arg[1] && i + 1 < argc)
+		{
+			const char* val = argv[++i];
+			bool ok = true;
+
+			if (!std::strcmp(arg, "-p"))
+				ok = parse_properties(val, opts.props);
+			else if (!std::strcmp(arg, "-f") && !std::strcmp(val, "csv"))
+				opts.binary = false;
+			else if (!std::strcmp(arg, "-f")
+					&& !std::strcmp(val, "binary"))
+				opts.binary = true;
+			else if (!std::strcmp(arg, "-o"))
+				opts.output = val;
+			else if (!std::strcmp(arg, "-j"))
+				ok = (opts.threads = std::strtoul(val, 0, 10)) > 0;
+			else if (!std::strcmp(arg, "-c"))
+				ok = (opts.chunk = std::strtoul(val, 0, 10)) > 0;
+			else
+				ok = false;
+
+			if (!ok)
+			{
+				usage(argv[0]);
+				return 1;
+			}
+		}
+		else
+			args.push_back(arg);
+	}
+
+	if (args.size() == 3)
+		for (size_t i = 0; i < COUNT(constructors); ++i)
+			if (!std::strcmp(args[0], constructors[i].name))
+				opts.constr = &constructors[i];
+
+	if (!opts.constr || !parse_axis(args[1], opts.a)
+			|| !parse_axis(args[2], opts.b))
+	{
+		usage(argv[0]);
+		return 1;
+	}
+
+	std::FILE* f = stdout;
+	if (opts.output)
+	{
+		f = std::fopen(opts.output, opts.binary ? "wb" : "w");
+		if (!f)
+		{
+			std::perror(opts.output);
+			return 1;
+		}
+	}
+
+	typedef std::chrono::steady_clock clock;
+	clock::time_point start = clock::now();
+
+	h2o::parallel::ThreadPool pool(opts.threads);
+	const size_t cells = opts.a.n * opts.b.n;
+	size_t oor = 0;
+	Chunk chunks[2];
+	std::thread writer;
+
+	write_header(f, opts);
+
+	// evaluate a chunk while the previous one is being written
+	for (size_t begin = 0, k = 0; begin < cells; begin += opts.chunk, ++k)
+	{
+		Chunk& c = chunks[k % 2];
+		size_t end = std::min(begin + opts.chunk, cells);
+
+		oor += evaluate(opts, c, begin, end, pool);
+
+		if (writer.joinable())
+			writer.join();
+		writer = std::thread([&opts, &c, f]()
+				{
+					if (opts.binary)
+						write_binary(f, opts, c);
+					else
+						write_csv(f, opts, c);
+				});
+
+		if (opts.verbose)
+			std::cerr << end << " / " << cells << " cells\r" << std::flush;
+	}
+
+	if (writer.joinable())
+		writer.join();
+
+	bool failed = std::ferror(f);
+	if (f != stdout)
+		failed |= std::fclose(f) != 0;
+	else
+		failed |= std::fflush(f) != 0;
+
+	if (failed)
+	{
+		std::perror(opts.output ? opts.output : "stdout");
+		return 1;
+	}
+
+	if (opts.verbose)
+	{
+		double elapsed = std::chrono::duration<double>(
+				clock::now() - start).count();
+
+		std::cerr << cells << " cells (" << oor << " out of range) in "
+			<< elapsed << " s, " << pool.size() << " threads"
+			<< std::endl;
+	}
+
+	return 0;
+}